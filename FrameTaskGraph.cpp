@@ -0,0 +1,416 @@
+#include "FrameTaskGraph.h"
+
+#include <stdio.h>
+#include <string.h>     // for strcmp
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.  There are no tasks, and 
+    until Init(...), everything runs on the main thread.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+FrameTaskGraph::FrameTaskGraph() :
+    _pScheduler(0),
+    _spawnedTaskRunner([this](unsigned int begin, unsigned int end, unsigned int workerIndex)
+    {
+        for (unsigned int taskIndex = begin; taskIndex < end; taskIndex++)
+        {
+            RunTask(taskIndex, workerIndex);
+        }
+    }),
+    _spawnedTasks(_spawnedTaskRunner, 1),
+    _numTasksLeft(0),
+    _lastFrameSec(0.0)
+{
+    _frameTimer.Init();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets the scheduler whose worker threads run the "any thread" tasks.  The tasks are kept.  
+    Must not be called during Run().
+Parameters:
+    pScheduler  Must outlive the graph's use of it (shut it down after the last Run()).  0 runs 
+                every task on the main thread.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FrameTaskGraph::Init(ParticleTaskScheduler *pScheduler)
+{
+    _pScheduler = pScheduler;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Adds a task to the end of the graph and works out what it depends on from what it reads and
+    writes (see the class description).  Must not be called during Run().
+Parameters:
+    name        For DumpLastFrame().
+    thread      FRAME_TASK_MAIN_THREAD if it makes OpenGL calls (or anything else that must
+                stay on the main thread), otherwise FRAME_TASK_ANY_THREAD.
+    inputs      The names of what it reads.
+    outputs     The names of what it writes.  Something that is read and written goes in both.
+    function    The task itself.  Called once per Run().
+Returns:
+    The task's index.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int FrameTaskGraph::AddTask(const char *name, const FrameTaskThread thread,
+    std::initializer_list<const char *> inputs, std::initializer_list<const char *> outputs,
+    const FrameTaskFunction &function)
+{
+    unsigned int taskIndex = _tasks.size();
+    Task task;
+    task._name = name;
+    task._thread = thread;
+    task._function = function;
+    task._numDependenciesLeft = 0;
+    task._startSec = 0.0;
+    task._endSec = 0.0;
+    task._threadIndex = 0;
+    _tasks.push_back(task);
+
+    // read after write
+    for (const char *input : inputs)
+    {
+        Resource &resource = FindResource(input);
+        if (resource._lastWriter >= 0)
+        {
+            AddDependency(taskIndex, resource._lastWriter);
+        }
+    }
+
+    // write after write and write after read
+    for (const char *output : outputs)
+    {
+        Resource &resource = FindResource(output);
+        if (resource._lastWriter >= 0)
+        {
+            AddDependency(taskIndex, resource._lastWriter);
+        }
+        for (size_t readerIndex = 0; readerIndex < resource._readersSinceWrite.size();
+            readerIndex++)
+        {
+            AddDependency(taskIndex, resource._readersSinceWrite[readerIndex]);
+        }
+    }
+
+    // only now, so that a task that reads and writes something doesn't depend on itself
+    for (const char *input : inputs)
+    {
+        FindResource(input)._readersSinceWrite.push_back(taskIndex);
+    }
+    for (const char *output : outputs)
+    {
+        Resource &resource = FindResource(output);
+        resource._lastWriter = taskIndex;
+        resource._readersSinceWrite.clear();
+    }
+
+    return taskIndex;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs every task once, each after the ones that it depends on, and returns when all of them
+    are done.  Must be called on the main thread.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FrameTaskGraph::Run()
+{
+    if (_tasks.empty())
+    {
+        return;
+    }
+
+    _frameTimer.Start();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _readyTasks.clear();
+        _numTasksLeft = _tasks.size();
+        for (unsigned int taskIndex = 0; taskIndex < _tasks.size(); taskIndex++)
+        {
+            Task &task = _tasks[taskIndex];
+            task._numDependenciesLeft = task._dependencies.size();
+            if (task._numDependenciesLeft == 0)
+            {
+                MakeReady(taskIndex);
+            }
+        }
+    }
+
+    while (true)
+    {
+        unsigned int taskIndex = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _mainCondition.wait(lock, [this, &taskIndex]()
+            {
+                return _numTasksLeft == 0 || TakeReadyTask(&taskIndex);
+            });
+            if (_numTasksLeft == 0)
+            {
+                break;
+            }
+        }
+        RunTask(taskIndex, 0);
+    }
+
+    // every task is done, but a worker may still be on its way out of the last one, and the 
+    // graph mustn't change (or go away) under it
+    if (UsesWorkers())
+    {
+        _pScheduler->Wait(_spawnedTasks);
+    }
+    _lastFrameSec = _frameTimer.TotalTime();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Prints every task's thread, start and stop times, and dependencies from the last Run(),
+    then the critical path.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FrameTaskGraph::DumpLastFrame() const
+{
+    if (_tasks.empty())
+    {
+        return;
+    }
+
+    // the longest chain ending in each task, by how long the tasks actually took; the
+    // dependencies are always earlier in the list, so one pass in order does it
+    std::vector<double> chainSec(_tasks.size(), 0.0);
+    std::vector<int> chainPrevious(_tasks.size(), -1);
+    double totalWorkSec = 0.0;
+    unsigned int criticalEnd = 0;
+    for (unsigned int taskIndex = 0; taskIndex < _tasks.size(); taskIndex++)
+    {
+        const Task &task = _tasks[taskIndex];
+        double longestBeforeSec = 0.0;
+        for (size_t dependencyIndex = 0; dependencyIndex < task._dependencies.size();
+            dependencyIndex++)
+        {
+            unsigned int before = task._dependencies[dependencyIndex];
+            if (chainPrevious[taskIndex] < 0 || chainSec[before] > longestBeforeSec)
+            {
+                longestBeforeSec = chainSec[before];
+                chainPrevious[taskIndex] = before;
+            }
+        }
+
+        double durationSec = task._endSec - task._startSec;
+        chainSec[taskIndex] = longestBeforeSec + durationSec;
+        totalWorkSec += durationSec;
+        criticalEnd = (chainSec[taskIndex] > chainSec[criticalEnd]) ? taskIndex : criticalEnd;
+    }
+
+    printf("frame task graph: %u tasks, %u threads, %.3lf ms frame, %.3lf ms of work, "
+        "%.3lf ms critical path\n", (unsigned int)_tasks.size(),
+        UsesWorkers() ? _pScheduler->NumWorkers() : 1, _lastFrameSec * 1000.0, totalWorkSec * 1000.0,
+        chainSec[criticalEnd] * 1000.0);
+    printf("    %-3s %-28s %-6s %9s %9s  %s\n", "#", "task", "thread", "start ms", "end ms",
+        "depends on");
+    for (unsigned int taskIndex = 0; taskIndex < _tasks.size(); taskIndex++)
+    {
+        const Task &task = _tasks[taskIndex];
+        std::string dependencies;
+        for (size_t dependencyIndex = 0; dependencyIndex < task._dependencies.size();
+            dependencyIndex++)
+        {
+            char number[16];
+            sprintf(number, "%s%u", (dependencyIndex == 0) ? "" : ", ",
+                task._dependencies[dependencyIndex]);
+            dependencies += number;
+        }
+
+        char thread[16];
+        if (task._threadIndex == 0)
+        {
+            sprintf(thread, "main");
+        }
+        else
+        {
+            sprintf(thread, "%u", task._threadIndex);
+        }
+        printf("    %-3u %-28s %-6s %9.3lf %9.3lf  %s\n", taskIndex, task._name.c_str(), thread,
+            task._startSec * 1000.0, task._endSec * 1000.0, dependencies.c_str());
+    }
+
+    // walk the critical path back from its end, then print it from the start
+    std::vector<unsigned int> criticalPath;
+    for (int taskIndex = criticalEnd; taskIndex >= 0; taskIndex = chainPrevious[taskIndex])
+    {
+        criticalPath.push_back(taskIndex);
+    }
+    printf("    critical path:");
+    for (size_t pathIndex = criticalPath.size(); pathIndex > 0; pathIndex--)
+    {
+        const Task &task = _tasks[criticalPath[pathIndex - 1]];
+        printf("%s %s (%.3lf ms)", (pathIndex == criticalPath.size()) ? "" : " ->",
+            task._name.c_str(), (task._endSec - task._startSec) * 1000.0);
+    }
+    printf("\n");
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Finds the bookkeeping for a named input or output, and makes it if this is the first time
+    that the name came up.
+Parameters:
+    name    Self-explanatory.
+Returns:
+    A reference to it.  Only good until the next new name.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+FrameTaskGraph::Resource &FrameTaskGraph::FindResource(const char *name)
+{
+    for (size_t resourceIndex = 0; resourceIndex < _resources.size(); resourceIndex++)
+    {
+        if (strcmp(_resources[resourceIndex]._name.c_str(), name) == 0)
+        {
+            return _resources[resourceIndex];
+        }
+    }
+
+    Resource resource;
+    resource._name = name;
+    resource._lastWriter = -1;
+    _resources.push_back(resource);
+    return _resources.back();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes one task wait for another, unless it already does.
+Parameters:
+    taskIndex           The one that waits.
+    dependencyIndex     The one that it waits for.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FrameTaskGraph::AddDependency(const unsigned int taskIndex,
+    const unsigned int dependencyIndex)
+{
+    std::vector<unsigned int> &dependencies = _tasks[taskIndex]._dependencies;
+    for (size_t index = 0; index < dependencies.size(); index++)
+    {
+        if (dependencies[index] == dependencyIndex)
+        {
+            return;
+        }
+    }
+    dependencies.push_back(dependencyIndex);
+    _tasks[dependencyIndex]._dependents.push_back(taskIndex);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple check for whether there are worker threads to run the "any thread" tasks on.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool FrameTaskGraph::UsesWorkers() const
+{
+    return _pScheduler != 0 && _pScheduler->NumWorkers() > 1;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sends a task whose dependencies are all done to where it will run: the main thread's 
+    "ready" list, or a worker.  The mutex must be locked.
+Parameters:
+    taskIndex   Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FrameTaskGraph::MakeReady(const unsigned int taskIndex)
+{
+    if (_tasks[taskIndex]._thread == FRAME_TASK_MAIN_THREAD || !UsesWorkers())
+    {
+        _readyTasks.push_back(taskIndex);
+    }
+    else
+    {
+        // Note: Safe with the mutex locked because the scheduler never calls back into the 
+        // graph while it holds its own locks.
+        _pScheduler->Spawn(_spawnedTasks, taskIndex, taskIndex + 1);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the oldest task off of the main thread's "ready" list.  The mutex must be locked.
+Parameters:
+    pTaskIndex  Gets the task, if there is one.
+Returns:
+    True if there was a task, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool FrameTaskGraph::TakeReadyTask(unsigned int *pTaskIndex)
+{
+    if (_readyTasks.empty())
+    {
+        return false;
+    }
+    *pTaskIndex = _readyTasks.front();
+    _readyTasks.erase(_readyTasks.begin());
+    return true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs a task, records when and where, and makes its dependents ready if this was the last
+    thing that they were waiting for.
+Parameters:
+    taskIndex       Self-explanatory.
+    threadIndex     0 for the main thread, otherwise the scheduler's worker index.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FrameTaskGraph::RunTask(const unsigned int taskIndex, const unsigned int threadIndex)
+{
+    Task &task = _tasks[taskIndex];
+    task._threadIndex = threadIndex;
+    task._startSec = _frameTimer.TotalTime();
+    task._function();
+    task._endSec = _frameTimer.TotalTime();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t dependentIndex = 0; dependentIndex < task._dependents.size();
+            dependentIndex++)
+        {
+            Task &dependent = _tasks[task._dependents[dependentIndex]];
+            dependent._numDependenciesLeft--;
+            if (dependent._numDependenciesLeft == 0)
+            {
+                MakeReady(task._dependents[dependentIndex]);
+            }
+        }
+        _numTasksLeft--;
+    }
+
+    // Note: Waking the main thread after every task is crude, but there are only a few tasks 
+    // per frame.
+    _mainCondition.notify_one();
+}
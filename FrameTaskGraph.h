@@ -0,0 +1,116 @@
+#pragma once
+
+#include "ParticleTaskScheduler.h"
+#include "Stopwatch.h"
+
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// which threads may run a task; OpenGL calls must be made on the thread that has the context
+enum FrameTaskThread
+{
+    FRAME_TASK_ANY_THREAD = 0,
+    FRAME_TASK_MAIN_THREAD,     // the thread that calls FrameTaskGraph::Run()
+};
+
+typedef std::function<void()> FrameTaskFunction;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs the phases of a frame in whatever order their inputs and outputs allow instead of the
+    order that they were written in, so that CPU work that doesn't depend on the OpenGL calls
+    (like the next frame's particle update and the HUD's text) runs on other threads while
+    the main thread submits the OpenGL calls.
+
+    Each task names the things that it reads and writes (any names will do; "particles",
+    "framebuffer", ...).  The dependencies come from the order that the tasks were added: a
+    task that reads something runs after the last task before it that wrote it, and a task
+    that writes something also runs after every task before it that read it since then.  So
+    the graph does the same thing as running the tasks in the order that they were added, just
+    with more going on at once.
+
+    The graph is made once and run every frame.  Tasks that must make OpenGL calls are marked
+    as main thread tasks.  The others are spawned on the worker threads of a
+    ParticleTaskScheduler as soon as they're ready (or run on the main thread, if there are no
+    workers).  The graph has no threads of its own, so the particle update can split itself
+    over the same workers that the graph runs on instead of two sets of threads fighting over
+    the cores.  The main thread doesn't take other tasks while there are workers so that it's
+    always free for the next OpenGL task.
+
+    Every run records when each task started and stopped and on which thread.  DumpLastFrame()
+    prints that, along with each task's dependencies and the critical path: the chain of
+    dependent tasks that took the longest, which is the shortest that the frame could take no
+    matter how many threads there are.
+
+    Tasks are a handful per frame, so a single mutex guards the main thread's "ready" list.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class FrameTaskGraph
+{
+public:
+    FrameTaskGraph();
+    void Init(ParticleTaskScheduler *pScheduler);
+
+    unsigned int AddTask(const char *name, const FrameTaskThread thread,
+        std::initializer_list<const char *> inputs, std::initializer_list<const char *> outputs,
+        const FrameTaskFunction &function);
+    void Run();
+    void DumpLastFrame() const;
+
+private:
+    // not copyable; the spawned tasks have a pointer to this
+    FrameTaskGraph(const FrameTaskGraph &);
+    FrameTaskGraph &operator=(const FrameTaskGraph &);
+
+    struct Task
+    {
+        std::string _name;
+        FrameTaskThread _thread;
+        FrameTaskFunction _function;
+        std::vector<unsigned int> _dependencies;    // all earlier in the list
+        std::vector<unsigned int> _dependents;      // all later in the list
+        unsigned int _numDependenciesLeft;
+
+        // from the last Run(), in seconds since the start of it; thread 0 is the main thread, 
+        // and the others are the scheduler's workers
+        double _startSec;
+        double _endSec;
+        unsigned int _threadIndex;
+    };
+
+    // the last task that wrote something, and the tasks that read it since then
+    struct Resource
+    {
+        std::string _name;
+        int _lastWriter;    // -1 for none
+        std::vector<unsigned int> _readersSinceWrite;
+    };
+
+    Resource &FindResource(const char *name);
+    void AddDependency(const unsigned int taskIndex, const unsigned int dependencyIndex);
+    bool UsesWorkers() const;
+    void MakeReady(const unsigned int taskIndex);
+    bool TakeReadyTask(unsigned int *pTaskIndex);
+    void RunTask(const unsigned int taskIndex, const unsigned int threadIndex);
+
+    std::vector<Task> _tasks;
+    std::vector<Resource> _resources;
+
+    // "any thread" tasks are spawned in the group as ranges of one task each
+    ParticleTaskScheduler *_pScheduler;
+    ParticleRangeTask _spawnedTaskRunner;
+    ParticleTaskGroup _spawnedTasks;
+
+    // everything below is guarded by the mutex during Run()
+    std::mutex _mutex;
+    std::condition_variable _mainCondition;     // the main thread waits for a ready task or the end
+    std::vector<unsigned int> _readyTasks;      // the ones that the main thread runs
+    unsigned int _numTasksLeft;
+
+    Stopwatch _frameTimer;
+    double _lastFrameSec;
+};
@@ -3,10 +3,18 @@
 #include "Particle.h"
 #include "glm/mat4x4.hpp"
 
+// forward declaration to avoid dragging the aligned array types into every emitter
+struct ParticleStorageSoA;
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     The "particle updater" must be able to easily use multiple particle emitters without much 
     trouble, so use an interface that defines the basic functionality of each particle emitter.
+
+    The ResetParticles(...) versions reset many particles in one virtual call.  Emitters 
+    generate all of a batch's random numbers up front and compute the particles in loops that 
+    vectorize (see ParticleEmitBatch), so emission-heavy frames don't pay a virtual call, a 
+    random number call, and a normalize per particle.
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
 class IParticleEmitter
@@ -14,6 +22,10 @@ class IParticleEmitter
 public:
     virtual ~IParticleEmitter() {}
     virtual void ResetParticle(Particle *resetThis) const = 0;
+    virtual void ResetParticle(ParticleStorageSoA *resetThis, const unsigned int particleIndex) const = 0;
+    virtual void ResetParticles(Particle *resetThese, const unsigned int count) const = 0;
+    virtual void ResetParticles(ParticleStorageSoA *resetThis, const unsigned int *particleIndices, 
+        const unsigned int count) const = 0;
     virtual void SetTransform(const glm::mat4 &m) = 0;
 };
 
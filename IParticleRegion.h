@@ -1,20 +1,42 @@
 #pragma once
 
-#include "Particle.h"
+#include "glm/vec2.hpp"
 #include "glm/mat4x4.hpp"
+#include "ParticlePositionSpan.h"
 
 /*-----------------------------------------------------------------------------------------------
 Description:
     The "particle updater" must be able to easily switch out particle regions (circle, polygon, 
     whatever else I come up with) without much trouble, so use an interface that defines the 
     basic functionality of each particle emitter.
+
+    The "out of bounds" check takes a position instead of a whole particle because the 
+    position is all that a region cares about, and it lets particle storage that doesn't keep 
+    Particle structures (ParticleStorageSoA) use the regions too.
+
+    There is also an integer version of the check for ParticleStorageFixedPoint, which takes 
+    positions in ParticleFixedPoint units (32767 == +1.0).  Regions keep fixed-point copies of 
+    their shapes for it so that the check never touches a float.
+
+    The batch version of the check tests a whole span of positions in one virtual call and 
+    sets bit N of word N / 64 of the output if position N is out of bounds.  That lets each 
+    region run a tight (and vectorized) loop instead of paying a virtual call per particle.
+
+    Particles move in straight lines at constant velocity, so the exit time query says how 
+    long a particle has until it leaves the region.  That lets the updater schedule each 
+    particle's retirement when it is emitted instead of checking it every frame (see 
+    ParticleUpdater::UpdateScheduled(...)).
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
 class IParticleRegion
 {
 public:
     virtual ~IParticleRegion() {}
-    virtual bool OutOfBounds(const Particle &p) const = 0;
+    virtual bool OutOfBounds(const glm::vec2 &position) const = 0;
+    virtual bool OutOfBoundsFixedPoint(const int positionX, const int positionY) const = 0;
+    virtual void OutOfBoundsBatch(const ParticlePositionSpan &positions, 
+        unsigned long long *outOfBoundsBits) const = 0;
+    virtual float ExitTime(const glm::vec2 &position, const glm::vec2 &velocity) const = 0;
     virtual void SetTransform(const glm::mat4 &m) = 0;
 };
 
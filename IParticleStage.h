@@ -0,0 +1,33 @@
+#pragma once
+
+// forward declaration to avoid dragging the aligned array types into every stage
+struct ParticleStorageSoA;
+
+// where in a tile's update a stage runs (see ParticleUpdater::UpdateTiled(...))
+enum ParticleStageSlot
+{
+    PARTICLE_STAGE_BEFORE_INTEGRATE = 0,    // forces, drag, anything that changes velocity
+    PARTICLE_STAGE_AFTER_EMIT,              // collisions, counters, anything that reads the result
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    An extra step of the particle update, like a force or a counter, that the particle updater 
+    runs on one tile of particles at a time along with its own steps (integration, the bounds 
+    check, and emission).  A tile is small enough to stay in the L1 cache, so a stage that 
+    reads the tile right after the one before it doesn't cost another pass over memory.
+
+    Like the emitters and regions, stages are given to the updater as const pointers and it 
+    doesn't delete them.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class IParticleStage
+{
+public:
+    virtual ~IParticleStage() {}
+
+    // tileStart is a multiple of 64, so the tile is made of whole chunks of the active mask 
+    // (tileEnd may cut the last one short at the end of the storage)
+    virtual void Run(ParticleStorageSoA *pStorage, const unsigned int tileStart, 
+        const unsigned int tileEnd, const float deltaTimeSec) const = 0;
+};
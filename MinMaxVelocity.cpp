@@ -2,6 +2,7 @@
 
 #include "glm/detail/func_geometric.hpp" // for normalizing glm vectors
 #include "RandomToast.h"
+#include <math.h>   // for sqrtf(...)
 
 
 /*-----------------------------------------------------------------------------------------------
@@ -74,7 +75,8 @@ Description:
 Parameters: None
 Returns:    
     A 2D vector whose magnitude is between the initialized "min" and "max" values and whose 
-    direction is random.
+    direction is random.  The (very unlikely) random direction of length 0 gives a 0 velocity 
+    instead of NaN, like GetNewBatch(...).
 Exception:  Safe
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
@@ -89,10 +91,14 @@ glm::vec2 MinMaxVelocity::GetNew() const
         // create a normalized random vector, then multiple all items by the magnitude
         // Note: The hard-coded mod100 is just to prevent the random axis magnitudes from 
         // getting too crazy different from each other.
+        // Note: Both axes are 0 about 1 time in 39,601, and glm::normalize(...) would divide 
+        // by 0, so keep the length above 0 instead.
         float newX = (float)(RandomPosAndNeg() % 100);
         float newY = (float)(RandomPosAndNeg() % 100);
-        glm::vec2 randomVelocityVector = glm::normalize(glm::vec2(newX, newY));
-        return (randomVelocityVector * velocityMagnitude);
+        float lengthSqr = (newX * newX) + (newY * newY);
+        lengthSqr = (lengthSqr > 1e-12f) ? lengthSqr : 1e-12f;
+        float scale = velocityMagnitude / sqrtf(lengthSqr);
+        return glm::vec2(newX * scale, newY * scale);
     }
     else  // read, "don't use random direction"
     {
@@ -100,3 +106,68 @@ glm::vec2 MinMaxVelocity::GetNew() const
     }
 }
 
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The batch version of GetNew().  All the random numbers for a group of up to 64 velocities 
+    are generated up front with RandomOnRange0to1Batch(...), and then the velocities are 
+    computed in branch-free loops that the compiler can vectorize.
+
+    Random directions come from a random point in the [-1,+1] square, like GetNew()'s, but 
+    normalized with a multiply by 1/sqrt instead of glm::normalize(...).  The length is kept 
+    above 0 so that the (very unlikely) point at the origin gives a 0 velocity instead of NaN.
+Parameters:
+    velocityX   Must fit "count" floats.
+    velocityY   Same.
+    count       Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void MinMaxVelocity::GetNewBatch(float *velocityX, float *velocityY, 
+    const unsigned int count) const
+{
+    static const unsigned int GROUP_SIZE = 64;
+    float magnitudes[GROUP_SIZE];
+    float directionX[GROUP_SIZE];
+    float directionY[GROUP_SIZE];
+    for (unsigned int groupStart = 0; groupStart < count; groupStart += GROUP_SIZE)
+    {
+        unsigned int numInGroup = count - groupStart;
+        if (numInGroup > GROUP_SIZE)
+        {
+            numInGroup = GROUP_SIZE;
+        }
+        float *groupX = velocityX + groupStart;
+        float *groupY = velocityY + groupStart;
+
+        RandomOnRange0to1Batch(magnitudes, numInGroup);
+        for (unsigned int index = 0; index < numInGroup; index++)
+        {
+            magnitudes[index] = _min + (magnitudes[index] * _velocityDelta);
+        }
+
+        if (_useRandomDir)
+        {
+            RandomOnRange0to1Batch(directionX, numInGroup);
+            RandomOnRange0to1Batch(directionY, numInGroup);
+            for (unsigned int index = 0; index < numInGroup; index++)
+            {
+                float x = (directionX[index] * 2.0f) - 1.0f;
+                float y = (directionY[index] * 2.0f) - 1.0f;
+                float lengthSqr = (x * x) + (y * y);
+                lengthSqr = (lengthSqr > 1e-12f) ? lengthSqr : 1e-12f;
+                float scale = magnitudes[index] / sqrtf(lengthSqr);
+                groupX[index] = x * scale;
+                groupY[index] = y * scale;
+            }
+        }
+        else
+        {
+            for (unsigned int index = 0; index < numInGroup; index++)
+            {
+                groupX[index] = _dir.x * magnitudes[index];
+                groupY[index] = _dir.y * magnitudes[index];
+            }
+        }
+    }
+}
@@ -22,6 +22,7 @@ public:
     void UseRandomDir();
 
     glm::vec2 GetNew() const;
+    void GetNewBatch(float *velocityX, float *velocityY, const unsigned int count) const;
 private:
     // why store the max if I'm going to be calculating the delta all the time?
     float _velocityDelta;
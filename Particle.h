@@ -4,25 +4,18 @@
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    This is a simple structure that says where a particle is, where it is going, and whether it
-    has gone out of bounds ("is active" flag).  That flag also serves to prevent all particles
-    from going out all at once upon creation by letting the "particle updater" regulate how many
-    are emitted every frame.
+    This is a simple structure that says where a particle is and where it is going.
+
+    Whether it has gone out of bounds ("is active" flag) is not stored here.  It used to be an 
+    integer in this structure, but that made the structure 20 bytes instead of 16, the updater 
+    had to pull it into the cache for every particle, and it was uploaded to the GPU for 
+    nothing.  The flags now live in a bit mask in the particle storage (see ParticleActiveMask), 
+    where the updater can skip whole chunks of inactive particles at once.
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
 struct Particle
 {
-    Particle() : 
-        // glm structures already have "set to 0" constructors
-        _isActive(0)
-    {
-    }
-
+    // glm structures already have "set to 0" constructors
     glm::vec2 _position;
     glm::vec2 _velocity;
-
-    // Note: Booleans cannot be uploaded to the shader 
-    // (https://www.opengl.org/sdk/docs/man/html/glVertexAttribPointer.xhtml), so send the 
-    // "is active" flag as an integer.  It is understood 
-    int _isActive;
 };
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "ParticleActiveMask.h"
+
+#include "BitOperations.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleActiveMask::ParticleActiveMask() :
+    _numParticles(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates enough bits for the provided number of particles and marks all of them as
+    inactive.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleActiveMask::Init(const unsigned int numParticles)
+{
+    _numParticles = numParticles;
+
+    // round up
+    unsigned int numChunks = (numParticles + 63) / 64;
+    unsigned int numOccupancyWords = (numChunks + 63) / 64;
+    _activeBits.assign(numChunks, 0);
+    _occupiedChunks.assign(numOccupancyWords, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Changes the number of particles without changing the bits of the particles that are kept.
+    New particles are inactive.  The bits of particles that are cut off are cleared (including
+    any past the end in the last chunk) so that they don't show up as active if the mask grows
+    again.
+
+    The occupancy bits are rebuilt from scratch.  That is one pass over the chunk words, which
+    is nothing next to reallocating the particles themselves.
+Parameters:
+    numParticles    The new size.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleActiveMask::Resize(const unsigned int numParticles)
+{
+    _numParticles = numParticles;
+
+    unsigned int numChunks = (numParticles + 63) / 64;
+    unsigned int numOccupancyWords = (numChunks + 63) / 64;
+    _activeBits.resize(numChunks, 0);
+    if (numParticles % 64 != 0)
+    {
+        _activeBits[numChunks - 1] &= (1ULL << (numParticles % 64)) - 1;
+    }
+
+    _occupiedChunks.assign(numOccupancyWords, 0);
+    for (unsigned int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+    {
+        UpdateOccupancy(chunkIndex);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles that the mask was initialized or resized with.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleActiveMask::Size() const
+{
+    return _numParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of 64-particle chunks.  The last one may be partial.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleActiveMask::NumChunks() const
+{
+    return _activeBits.size();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Finds the first chunk at or after the provided one that has at least one active particle.
+    Whole occupancy words that are 0 are skipped at once, so a mostly idle particle system
+    costs one check per 4096 particles.
+Parameters:
+    chunkIndex  Start searching here (inclusive).
+Returns:
+    The index of an occupied chunk, or NumChunks() if there are no more.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleActiveMask::NextOccupiedChunk(const unsigned int chunkIndex) const
+{
+    return NextOccupiedChunk(chunkIndex, _activeBits.size());
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A version of NextOccupiedChunk(...) that stops at the provided chunk.  It never reads the 
+    occupancy words past the one that "end chunk" is in, so if "end chunk" is a multiple of 64, 
+    threads that each search their own multiple-of-64 range of chunks don't read each other's 
+    occupancy words (see ParticleUpdater::UpdateParallel(...)).
+Parameters:
+    chunkIndex  Start searching here (inclusive).
+    endChunk    Stop searching here (exclusive).
+Returns:
+    The index of an occupied chunk, or "end chunk" (or NumChunks(), if that is smaller) if 
+    there are no more before it.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleActiveMask::NextOccupiedChunk(const unsigned int chunkIndex, 
+    const unsigned int endChunk) const
+{
+    unsigned int numChunks = _activeBits.size();
+    unsigned int searchEnd = (endChunk < numChunks) ? endChunk : numChunks;
+    if (chunkIndex >= searchEnd)
+    {
+        return searchEnd;
+    }
+
+    // ignore the occupancy bits for the chunks before the starting one
+    unsigned int occupancyIndex = chunkIndex / 64;
+    unsigned long long occupiedBits = _occupiedChunks[occupancyIndex] & (~0ULL << (chunkIndex % 64));
+    while (occupiedBits == 0)
+    {
+        occupancyIndex++;
+        if (occupancyIndex * 64 >= searchEnd)
+        {
+            return searchEnd;
+        }
+        occupiedBits = _occupiedChunks[occupancyIndex];
+    }
+
+    unsigned int occupiedChunk = (occupancyIndex * 64) + CountTrailingZeros64(occupiedBits);
+    return (occupiedChunk < searchEnd) ? occupiedChunk : searchEnd;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Counts the active particles with a popcount of each occupied chunk.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleActiveMask::CountActive() const
+{
+    unsigned int numActive = 0;
+    for (unsigned int chunkIndex = NextOccupiedChunk(0); chunkIndex < _activeBits.size();
+        chunkIndex = NextOccupiedChunk(chunkIndex + 1))
+    {
+        numActive += PopCount64(_activeBits[chunkIndex]);
+    }
+    return numActive;
+}
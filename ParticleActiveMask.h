@@ -0,0 +1,160 @@
+#pragma once
+
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Stores the "is active" flag of every particle as a single bit instead of as an integer in
+    each particle.  The bits are grouped into 64bit "chunk words" (one word per 64 particles),
+    and there is a second, smaller set of "occupancy" bits with one bit per chunk word that is
+    set if any particle in that chunk is active.
+
+    This lets the particle updater:
+    - skip any 64-particle chunk that is entirely inactive by checking one word,
+    - skip 4096 particles at a time when an occupancy word is 0,
+    - visit only the active particles in a chunk by walking its set bits, and
+    - count the active particles with popcount instead of incrementing a counter per particle.
+
+    The occupancy bits are kept up to date by every method that changes a chunk word, so don't
+    get around them.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleActiveMask
+{
+public:
+    ParticleActiveMask();
+    void Init(const unsigned int numParticles);
+    void Resize(const unsigned int numParticles);
+    unsigned int Size() const;
+
+    bool IsActive(const unsigned int particleIndex) const;
+    void Activate(const unsigned int particleIndex);
+    void Deactivate(const unsigned int particleIndex);
+
+    unsigned int NumChunks() const;
+    unsigned long long GetChunk(const unsigned int chunkIndex) const;
+    void SetChunk(const unsigned int chunkIndex, const unsigned long long activeBits);
+    unsigned int NextOccupiedChunk(const unsigned int chunkIndex) const;
+    unsigned int NextOccupiedChunk(const unsigned int chunkIndex, 
+        const unsigned int endChunk) const;
+
+    unsigned int CountActive() const;
+
+private:
+    void UpdateOccupancy(const unsigned int chunkIndex);
+
+    unsigned int _numParticles;
+
+    // bit N of chunk word M is the "is active" flag of particle (M * 64) + N
+    std::vector<unsigned long long> _activeBits;
+
+    // bit N of occupancy word M is set if chunk word (M * 64) + N is not 0
+    std::vector<unsigned long long> _occupiedChunks;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks a single particle's "is active" bit.
+
+    The single-bit accessors are defined here in the header so that they can be inlined into
+    the particle updater's loops.
+Parameters:
+    particleIndex   Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline bool ParticleActiveMask::IsActive(const unsigned int particleIndex) const
+{
+    return ((_activeBits[particleIndex / 64] >> (particleIndex % 64)) & 1) != 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets a single particle's "is active" bit and marks its chunk as occupied.
+Parameters:
+    particleIndex   Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline void ParticleActiveMask::Activate(const unsigned int particleIndex)
+{
+    unsigned int chunkIndex = particleIndex / 64;
+    _activeBits[chunkIndex] |= (1ULL << (particleIndex % 64));
+    _occupiedChunks[chunkIndex / 64] |= (1ULL << (chunkIndex % 64));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Clears a single particle's "is active" bit and, if that was the last active particle in
+    the chunk, marks the chunk as unoccupied.
+Parameters:
+    particleIndex   Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline void ParticleActiveMask::Deactivate(const unsigned int particleIndex)
+{
+    unsigned int chunkIndex = particleIndex / 64;
+    _activeBits[chunkIndex] &= ~(1ULL << (particleIndex % 64));
+    UpdateOccupancy(chunkIndex);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the 64 "is active" bits of a chunk.
+Parameters:
+    chunkIndex  Particle index / 64.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline unsigned long long ParticleActiveMask::GetChunk(const unsigned int chunkIndex) const
+{
+    return _activeBits[chunkIndex];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Replaces all 64 "is active" bits of a chunk at once and updates the chunk's occupancy bit.
+    The updater uses this to write back a chunk after deactivating particles in a local copy.
+Parameters:
+    chunkIndex  Particle index / 64.
+    activeBits  The new bits.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline void ParticleActiveMask::SetChunk(const unsigned int chunkIndex,
+    const unsigned long long activeBits)
+{
+    _activeBits[chunkIndex] = activeBits;
+    UpdateOccupancy(chunkIndex);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets or clears the chunk's occupancy bit depending on whether any of its particles are
+    active.
+Parameters:
+    chunkIndex  Particle index / 64.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline void ParticleActiveMask::UpdateOccupancy(const unsigned int chunkIndex)
+{
+    unsigned long long occupiedBit = 1ULL << (chunkIndex % 64);
+    if (_activeBits[chunkIndex] != 0)
+    {
+        _occupiedChunks[chunkIndex / 64] |= occupiedBit;
+    }
+    else
+    {
+        _occupiedChunks[chunkIndex / 64] &= ~occupiedBit;
+    }
+}
@@ -0,0 +1,889 @@
+#include "ParticleBenchmark.h"
+
+#include "ParticleStorage.h"
+#include "ParticleStorageSoA.h"
+#include "ParticleStorageAoSoA.h"
+#include "ParticleStorageFixedPoint.h"
+#include "ParticleRegionPolygon.h"
+#include "ParticleRegionPolygonGrid.h"
+#include "ParticleStageForce.h"
+#include "ParticleTaskScheduler.h"
+#include "ParticleKernels.h"
+#include "AlignedAllocator.h"
+#include "BitOperations.h"
+#include "RandomToast.h"
+#include "Stopwatch.h"
+
+#include <stdio.h>
+#include <math.h>   // for cosf(...) and sinf(...)
+#include <algorithm>    // for std::fill
+
+// every benchmark uses the same delta time as the demo so that particles live as long as they
+// do on screen
+static const float BENCHMARK_DELTA_TIME_SEC = 0.01f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs the updater over a freshly initialized storage for a number of frames to let the
+    number of active particles level off, and then times a number of frames.
+
+    This is a template so that it works with any storage that has InitParticles(...) and that
+    the updater (ParticleUpdater or a ParticleUpdaterT<...>) has Update(...) and Emit(...) for.
+Parameters:
+    updater         Has the region and emitters.
+    storage         Will be re-initialized.
+    numParticles    Self-explanatory.
+    numWarmupFrames Not timed.
+    numTimedFrames  Self-explanatory.
+    pNumActive      Receives the number of active particles after the last timed frame.
+Returns:
+    The average number of milliseconds per timed frame.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename UpdaterT, typename StorageT>
+static double TimeUpdates(const UpdaterT &updater, StorageT &storage,
+    const unsigned int numParticles, const unsigned int numWarmupFrames,
+    const unsigned int numTimedFrames, unsigned int *pNumActive)
+{
+    storage.InitParticles(numParticles);
+    unsigned int numActive = 0;
+    for (unsigned int frameCount = 0; frameCount < numWarmupFrames; frameCount++)
+    {
+        updater.Update(storage, 0, numParticles, BENCHMARK_DELTA_TIME_SEC);
+        updater.Emit(storage);
+    }
+
+    Stopwatch timer;
+    timer.Init();
+    timer.Start();
+    for (unsigned int frameCount = 0; frameCount < numTimedFrames; frameCount++)
+    {
+        numActive = updater.Update(storage, 0, numParticles, BENCHMARK_DELTA_TIME_SEC);
+        numActive += updater.Emit(storage);
+    }
+    double elapsedSec = timer.TotalTime();
+
+    *pNumActive = numActive;
+    return (elapsedSec * 1000.0) / numTimedFrames;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times Update(...) + Emit(...) for the "array of structures", "structure of arrays", 
+    "array of structures of arrays" (blocks of 8 and 16), and 16-bit fixed-point storage 
+    layouts and prints a table of milliseconds per frame.
+
+    Each layout gets its own storage that only lives as long as this function.  The storages
+    don't create any OpenGL objects.
+Parameters:
+    updater         Should have emission quotas high enough that a good fraction of the
+                    particles are active, or else all layouts will spend all their time
+                    skipping inactive chunks and look the same.
+    numParticles    Self-explanatory.
+    numWarmupFrames Frames to run before timing.
+    numTimedFrames  Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkStorageLayouts(const ParticleUpdater &updater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames)
+{
+    printf("storage layout benchmark: %u particles, %u frames\n", numParticles, numTimedFrames);
+    printf("    %-32s %10s %10s\n", "layout", "ms/frame", "active");
+
+    unsigned int numActive = 0;
+    double msPerFrame = 0.0;
+    {
+        ParticleStorage storage;
+        msPerFrame = TimeUpdates(updater, storage, numParticles, numWarmupFrames,
+            numTimedFrames, &numActive);
+        printf("    %-32s %10.3lf %10u\n", "array of structures", msPerFrame, numActive);
+    }
+    {
+        ParticleStorageSoA storage;
+        msPerFrame = TimeUpdates(updater, storage, numParticles, numWarmupFrames,
+            numTimedFrames, &numActive);
+        printf("    %-32s %10.3lf %10u\n", "structure of arrays", msPerFrame, numActive);
+    }
+    {
+        ParticleStorageAoSoA<8> storage;
+        msPerFrame = TimeUpdates(updater, storage, numParticles, numWarmupFrames,
+            numTimedFrames, &numActive);
+        printf("    %-32s %10.3lf %10u\n", "blocks of 8", msPerFrame, numActive);
+    }
+    {
+        ParticleStorageAoSoA<16> storage;
+        msPerFrame = TimeUpdates(updater, storage, numParticles, numWarmupFrames,
+            numTimedFrames, &numActive);
+        printf("    %-32s %10.3lf %10u\n", "blocks of 16", msPerFrame, numActive);
+    }
+    {
+        ParticleStorageFixedPoint storage;
+        msPerFrame = TimeUpdates(updater, storage, numParticles, numWarmupFrames,
+            numTimedFrames, &numActive);
+        printf("    %-32s %10.3lf %10u\n", "16-bit fixed point", msPerFrame, numActive);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Not a timing.  Compares the regions' fixed-point OutOfBoundsFixedPoint(...) against their 
+    float OutOfBounds(...) for random points over the whole window and prints how many points 
+    the two disagree on.  This is what the "16-bit fixed point" layout gives up for its speed.
+
+    "near edge" is how many of the disagreements have a float answer that changes within 
+    FIXED_POINT_EDGE_UNITS position units of the point.  The positions are rounded by half a 
+    unit, but the polygon's normals are rounded to 1/16384, which can move a face a few units 
+    at the far side of the window, so "near" is wider than the position rounding alone.
+Parameters:
+    name        For the table.
+    region      Self-explanatory.
+    numPoints   Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static void CompareFixedPointRegion(const char *name, const IParticleRegion &region, 
+    const unsigned int numPoints)
+{
+    static const float FIXED_POINT_EDGE_UNITS = 8.0f;
+    const float edgeOffset = FIXED_POINT_EDGE_UNITS / FIXED_POINT_POSITION_ONE;
+
+    unsigned int numDisagree = 0;
+    unsigned int numNearEdge = 0;
+    for (unsigned int pointCount = 0; pointCount < numPoints; pointCount++)
+    {
+        glm::vec2 position((RandomOnRange0to1() * 2.0f) - 1.0f, 
+            (RandomOnRange0to1() * 2.0f) - 1.0f);
+        bool outFloat = region.OutOfBounds(position);
+        bool outFixed = region.OutOfBoundsFixedPoint(
+            ToFixedPoint(position.x, FIXED_POINT_POSITION_ONE), 
+            ToFixedPoint(position.y, FIXED_POINT_POSITION_ONE));
+        if (outFloat == outFixed)
+        {
+            continue;
+        }
+
+        numDisagree++;
+        bool nearEdge = 
+            (region.OutOfBounds(position + glm::vec2(+edgeOffset, 0.0f)) != outFloat) ||
+            (region.OutOfBounds(position + glm::vec2(-edgeOffset, 0.0f)) != outFloat) ||
+            (region.OutOfBounds(position + glm::vec2(0.0f, +edgeOffset)) != outFloat) ||
+            (region.OutOfBounds(position + glm::vec2(0.0f, -edgeOffset)) != outFloat);
+        numNearEdge += nearEdge ? 1 : 0;
+    }
+
+    printf("    %-32s %10u %10u %10u\n", name, numPoints, numDisagree, numNearEdge);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Prints CompareFixedPointRegion(...) for the demo's circle and polygon.  Run it next to 
+    BenchmarkStorageLayouts(...) so that the fixed-point row's time can be weighed against its 
+    accuracy.
+Parameters:
+    circleRegion    Self-explanatory.
+    polygonRegion   Self-explanatory.
+    numPoints       Per region.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkFixedPointRegions(const IParticleRegion &circleRegion, 
+    const IParticleRegion &polygonRegion, const unsigned int numPoints)
+{
+    printf("fixed-point region accuracy: %u random points per region\n", numPoints);
+    printf("    %-32s %10s %10s %10s\n", "region", "points", "disagree", "near edge");
+    CompareFixedPointRegion("circle", circleRegion, numPoints);
+    CompareFixedPointRegion("polygon", polygonRegion, numPoints);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the "array of structures" Update(...) + Emit(...) with the virtual ParticleUpdater 
+    and with the devirtualized ParticleUpdaterT<...> for the same scene and prints both.
+Parameters:
+    virtualUpdater  Should have the same region shape and emitters as the other one.
+    fixedUpdater    Self-explanatory.
+    numParticles    Self-explanatory.
+    numWarmupFrames Frames to run before timing.
+    numTimedFrames  Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkDevirtualizedUpdater(const ParticleUpdater &virtualUpdater, 
+    const DemoParticleUpdaterT &fixedUpdater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames)
+{
+    printf("updater dispatch benchmark: %u particles, %u frames\n", numParticles, 
+        numTimedFrames);
+    printf("    %-32s %10s %10s\n", "updater", "ms/frame", "active");
+
+    unsigned int numActive = 0;
+    double msPerFrame = 0.0;
+    {
+        ParticleStorage storage;
+        msPerFrame = TimeUpdates(virtualUpdater, storage, numParticles, numWarmupFrames,
+            numTimedFrames, &numActive);
+        printf("    %-32s %10.3lf %10u\n", "virtual", msPerFrame, numActive);
+    }
+    {
+        ParticleStorage storage;
+        msPerFrame = TimeUpdates(fixedUpdater, storage, numParticles, numWarmupFrames,
+            numTimedFrames, &numActive);
+        printf("    %-32s %10.3lf %10u\n", "template (devirtualized)", msPerFrame, numActive);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times each of the particle kernels for every variant that this machine supports on the 
+    same random "structure of arrays" data and prints a table of milliseconds per pass.  Each 
+    variant's results are also compared against the scalar variant's, which they should match 
+    bit for bit.
+
+    About 3/4 of the particles are active.  The polygon is a hexagon, like the demo's region.
+Parameters:
+    numParticles    Self-explanatory.
+    numIterations   Passes of each kernel to average over.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkParticleKernels(const unsigned int numParticles, const unsigned int numIterations)
+{
+    typedef std::vector<float, AlignedAllocator<float>> FloatArray;
+    FloatArray originalX(numParticles);
+    FloatArray originalY(numParticles);
+    FloatArray velocityX(numParticles);
+    FloatArray velocityY(numParticles);
+    for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+    {
+        originalX[particleIndex] = (RandomOnRange0to1() * 2.0f) - 1.0f;
+        originalY[particleIndex] = (RandomOnRange0to1() * 2.0f) - 1.0f;
+        velocityX[particleIndex] = RandomOnRange0to1() - 0.5f;
+        velocityY[particleIndex] = RandomOnRange0to1() - 0.5f;
+    }
+
+    unsigned int numWords = (numParticles + 63) / 64;
+    std::vector<unsigned long long> activeBits(numWords);
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        activeBits[wordIndex] = ((unsigned long long)Random() << 32) | Random();
+        activeBits[wordIndex] |= ((unsigned long long)Random() << 32) | Random();
+    }
+
+    // a regular hexagon of radius 0.5, with outward normals
+    static const unsigned int NUM_FACES = 6;
+    glm::vec2 faceCenters[NUM_FACES];
+    glm::vec2 faceNormals[NUM_FACES];
+    for (unsigned int faceIndex = 0; faceIndex < NUM_FACES; faceIndex++)
+    {
+        float angle = (faceIndex + 0.5f) * (2.0f * 3.14159265f / NUM_FACES);
+        faceNormals[faceIndex] = glm::vec2(cosf(angle), sinf(angle));
+        faceCenters[faceIndex] = faceNormals[faceIndex] * (0.5f * 0.8660254f);
+    }
+
+    printf("particle kernel benchmark: %u particles, %u passes (using %s)\n", numParticles, 
+        numIterations, ParticleKernelVariantName(GetParticleKernels()._variant));
+    printf("    %-10s %12s %12s %12s %10s\n", "variant", "integrate", "circle", "polygon", 
+        "matches");
+
+    FloatArray scalarX;
+    FloatArray scalarY;
+    std::vector<unsigned long long> scalarCircleBits;
+    std::vector<unsigned long long> scalarPolygonBits;
+    for (int variantIndex = 0; variantIndex < PARTICLE_KERNEL_NUM_VARIANTS; variantIndex++)
+    {
+        ParticleKernelVariant variant = (ParticleKernelVariant)variantIndex;
+        if (!ParticleKernelVariantSupported(variant))
+        {
+            continue;
+        }
+        const ParticleKernels &kernels = GetParticleKernels(variant);
+
+        FloatArray positionX(originalX);
+        FloatArray positionY(originalY);
+        std::vector<unsigned long long> circleBits(numWords);
+        std::vector<unsigned long long> polygonBits(numWords);
+        Stopwatch timer;
+        timer.Init();
+
+        timer.Start();
+        for (unsigned int iteration = 0; iteration < numIterations; iteration++)
+        {
+            kernels._integrate(positionX.data(), positionY.data(), velocityX.data(), 
+                velocityY.data(), activeBits.data(), numParticles, BENCHMARK_DELTA_TIME_SEC);
+        }
+        double integrateMs = (timer.Lap() * 1000.0) / numIterations;
+
+        for (unsigned int iteration = 0; iteration < numIterations; iteration++)
+        {
+            kernels._outOfBoundsCircle(positionX.data(), positionY.data(), numParticles, 
+                glm::vec2(0.0f, 0.0f), 0.25f, circleBits.data());
+        }
+        double circleMs = (timer.Lap() * 1000.0) / numIterations;
+
+        for (unsigned int iteration = 0; iteration < numIterations; iteration++)
+        {
+            kernels._outOfBoundsHalfPlanes(positionX.data(), positionY.data(), numParticles, 
+                faceCenters, faceNormals, NUM_FACES, polygonBits.data());
+        }
+        double polygonMs = (timer.Lap() * 1000.0) / numIterations;
+
+        bool matches = true;
+        if (variant == PARTICLE_KERNEL_SCALAR)
+        {
+            scalarX = positionX;
+            scalarY = positionY;
+            scalarCircleBits = circleBits;
+            scalarPolygonBits = polygonBits;
+        }
+        else
+        {
+            matches = (positionX == scalarX) && (positionY == scalarY) && 
+                (circleBits == scalarCircleBits) && (polygonBits == scalarPolygonBits);
+        }
+
+        printf("    %-10s %12.3lf %12.3lf %12.3lf %10s\n", ParticleKernelVariantName(variant), 
+            integrateMs, circleMs, polygonMs, matches ? "yes" : "NO");
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the half-plane kernel with and without the inner and outer circle early-outs (see 
+    ParticlePolygonBounds) for regular polygons of 3 up to MAX_POLYGON_FACES faces, for every 
+    variant that this machine supports, and prints a table of milliseconds per pass.  The two 
+    should give the same bits, which is checked too.  "used" is the one that the polygon 
+    regions pick (see OutOfBoundsConvexPolygon(...)).
+
+    The polygons' corners are 0.5 from the origin and the particles are spread evenly over a 
+    square a little larger than that, so some are inside the inner circle, some are outside 
+    the outer circle, and the rest need the faces.  "decided" is the fraction that the circles 
+    settled.
+
+    The kernels are called 64 particles at a time, like ParticleUpdater::Update(...) does, so 
+    give this few enough particles to stay in the cache.
+Parameters:
+    numParticles    Self-explanatory.
+    numIterations   Passes of each kernel to average over.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkPolygonEarlyOut(const unsigned int numParticles, const unsigned int numIterations)
+{
+    typedef std::vector<float, AlignedAllocator<float>> FloatArray;
+    FloatArray positionX(numParticles);
+    FloatArray positionY(numParticles);
+    for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+    {
+        positionX[particleIndex] = (RandomOnRange0to1() * 1.2f) - 0.6f;
+        positionY[particleIndex] = (RandomOnRange0to1() * 1.2f) - 0.6f;
+    }
+
+    printf("polygon early-out benchmark: %u particles, %u passes\n", numParticles, 
+        numIterations);
+    printf("    %-10s %6s %10s %12s %12s %10s %10s %10s\n", "variant", "faces", "decided", 
+        "all faces", "early-out", "speedup", "used", "matches");
+
+    unsigned int numWords = (numParticles + 63) / 64;
+    for (unsigned int numFaces = 3; numFaces <= MAX_POLYGON_FACES; numFaces++)
+    {
+        // counterclockwise corners, with the faces made the same way as ParticleRegionPolygon
+        glm::vec2 faceCenters[MAX_POLYGON_FACES];
+        glm::vec2 faceNormals[MAX_POLYGON_FACES];
+        for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+        {
+            float angle1 = faceIndex * (2.0f * 3.14159265f / numFaces);
+            float angle2 = (faceIndex + 1) * (2.0f * 3.14159265f / numFaces);
+            glm::vec2 corner1 = glm::vec2(cosf(angle1), sinf(angle1)) * 0.5f;
+            glm::vec2 corner2 = glm::vec2(cosf(angle2), sinf(angle2)) * 0.5f;
+            glm::vec2 cornerToCorner = corner2 - corner1;
+            faceCenters[faceIndex] = (corner1 + corner2) * 0.5f;
+            faceNormals[faceIndex] = glm::vec2(cornerToCorner.y, -(cornerToCorner.x));
+        }
+        ParticlePolygonBounds bounds = CalculatePolygonBounds(faceCenters, faceNormals, numFaces);
+
+        unsigned int numDecided = 0;
+        for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+        {
+            float dx = positionX[particleIndex] - bounds._center.x;
+            float dy = positionY[particleIndex] - bounds._center.y;
+            float distSqr = (dx * dx) + (dy * dy);
+            if (distSqr < bounds._innerRadiusSqr || distSqr > bounds._outerRadiusSqr)
+            {
+                numDecided++;
+            }
+        }
+
+        for (int variantIndex = 0; variantIndex < PARTICLE_KERNEL_NUM_VARIANTS; variantIndex++)
+        {
+            ParticleKernelVariant variant = (ParticleKernelVariant)variantIndex;
+            if (!ParticleKernelVariantSupported(variant))
+            {
+                continue;
+            }
+            const ParticleKernels &kernels = GetParticleKernels(variant);
+
+            std::vector<unsigned long long> allFacesBits(numWords);
+            std::vector<unsigned long long> earlyOutBits(numWords);
+            Stopwatch timer;
+            timer.Init();
+
+            timer.Start();
+            for (unsigned int iteration = 0; iteration < numIterations; iteration++)
+            {
+                for (unsigned int chunkStart = 0; chunkStart < numParticles; chunkStart += 64)
+                {
+                    unsigned int numInChunk = numParticles - chunkStart;
+                    numInChunk = (numInChunk < 64) ? numInChunk : 64;
+                    kernels._outOfBoundsHalfPlanes(&positionX[chunkStart], 
+                        &positionY[chunkStart], numInChunk, faceCenters, faceNormals, numFaces, 
+                        &allFacesBits[chunkStart / 64]);
+                }
+            }
+            double allFacesMs = (timer.Lap() * 1000.0) / numIterations;
+
+            for (unsigned int iteration = 0; iteration < numIterations; iteration++)
+            {
+                for (unsigned int chunkStart = 0; chunkStart < numParticles; chunkStart += 64)
+                {
+                    unsigned int numInChunk = numParticles - chunkStart;
+                    numInChunk = (numInChunk < 64) ? numInChunk : 64;
+                    kernels._outOfBoundsHalfPlanesBounded(&positionX[chunkStart], 
+                        &positionY[chunkStart], numInChunk, faceCenters, faceNormals, numFaces, 
+                        bounds, &earlyOutBits[chunkStart / 64]);
+                }
+            }
+            double earlyOutMs = (timer.Lap() * 1000.0) / numIterations;
+
+            printf("    %-10s %6u %9.1lf%% %12.3lf %12.3lf %9.2lfx %10s %10s\n", 
+                ParticleKernelVariantName(variant), numFaces, 
+                (numDecided * 100.0) / numParticles, allFacesMs, earlyOutMs, 
+                allFacesMs / earlyOutMs, 
+                (numFaces >= kernels._boundedMinFaces) ? "early-out" : "all faces",
+                (allFacesBits == earlyOutBits) ? "yes" : "NO");
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The plain even-odd point-in-polygon test over every edge, for BenchmarkPolygonGrid(...) to
+    compare against.  A horizontal line is cast to the left of the point, and the point is
+    inside if an odd number of edges cross it.
+Parameters:
+    corners     A closed loop of 2D points.
+    position    Self-explanatory.
+Returns:
+    True if the position is outside of the polygon, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static bool OutOfBoundsAllEdges(const std::vector<glm::vec2> &corners, 
+    const glm::vec2 &position)
+{
+    bool inside = false;
+    unsigned int numCorners = corners.size();
+    for (unsigned int cornerIndex = 0, prevIndex = numCorners - 1; cornerIndex < numCorners; 
+        prevIndex = cornerIndex++)
+    {
+        const glm::vec2 &a = corners[cornerIndex];
+        const glm::vec2 &b = corners[prevIndex];
+        if ((a.y > position.y) != (b.y > position.y))
+        {
+            float crossingX = a.x + ((position.y - a.y) * (b.x - a.x) / (b.y - a.y));
+            inside ^= (crossingX < position.x);
+        }
+    }
+    return !inside;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times ParticleRegionPolygonGrid against the plain even-odd test over every edge for star
+    polygons (concave, with spikes that alternate between two radii) of more and more edges,
+    and prints a table of milliseconds per pass.  The two should agree except for particles
+    that are within float rounding of an edge, so "mismatched" counts the ones that don't.
+
+    The particles are spread evenly over a square a little larger than the star, like
+    BenchmarkPolygonEarlyOut(...).  The grid is called through OutOfBoundsBatch(...) 64
+    particles at a time, like ParticleUpdater::Update(...) does.
+Parameters:
+    numParticles    Self-explanatory.
+    numIterations   Passes of each to average over.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkPolygonGrid(const unsigned int numParticles, const unsigned int numIterations)
+{
+    typedef std::vector<float, AlignedAllocator<float>> FloatArray;
+    FloatArray positionX(numParticles);
+    FloatArray positionY(numParticles);
+    for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+    {
+        positionX[particleIndex] = (RandomOnRange0to1() * 1.2f) - 0.6f;
+        positionY[particleIndex] = (RandomOnRange0to1() * 1.2f) - 0.6f;
+    }
+
+    printf("polygon grid benchmark: %u particles, %u passes\n", numParticles, numIterations);
+    printf("    %6s %10s %10s %12s %12s %10s %10s\n", "edges", "cells", "boundary", 
+        "all edges", "grid", "speedup", "mismatched");
+
+    unsigned int numWords = (numParticles + 63) / 64;
+    const unsigned int edgeCounts[] = { 8, 32, 128, 512, 2048 };
+    for (unsigned int edgeCountIndex = 0; edgeCountIndex < 5; edgeCountIndex++)
+    {
+        unsigned int numEdges = edgeCounts[edgeCountIndex];
+        std::vector<glm::vec2> corners(numEdges);
+        for (unsigned int cornerIndex = 0; cornerIndex < numEdges; cornerIndex++)
+        {
+            float angle = cornerIndex * (2.0f * 3.14159265f / numEdges);
+            float radius = (cornerIndex % 2 == 0) ? 0.5f : 0.3f;
+            corners[cornerIndex] = glm::vec2(cosf(angle), sinf(angle)) * radius;
+        }
+        ParticleRegionPolygonGrid grid(corners);
+
+        std::vector<unsigned long long> allEdgesBits(numWords);
+        std::vector<unsigned long long> gridBits(numWords);
+        Stopwatch timer;
+        timer.Init();
+
+        timer.Start();
+        for (unsigned int iteration = 0; iteration < numIterations; iteration++)
+        {
+            for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+            {
+                glm::vec2 position(positionX[particleIndex], positionY[particleIndex]);
+                unsigned long long bit = 1ull << (particleIndex % 64);
+                if (OutOfBoundsAllEdges(corners, position))
+                {
+                    allEdgesBits[particleIndex / 64] |= bit;
+                }
+                else
+                {
+                    allEdgesBits[particleIndex / 64] &= ~bit;
+                }
+            }
+        }
+        double allEdgesMs = (timer.Lap() * 1000.0) / numIterations;
+
+        for (unsigned int iteration = 0; iteration < numIterations; iteration++)
+        {
+            for (unsigned int chunkStart = 0; chunkStart < numParticles; chunkStart += 64)
+            {
+                unsigned int numInChunk = numParticles - chunkStart;
+                numInChunk = (numInChunk < 64) ? numInChunk : 64;
+                grid.OutOfBoundsBatch(MakePositionSpan(&positionX[chunkStart], 
+                    &positionY[chunkStart], numInChunk), &gridBits[chunkStart / 64]);
+            }
+        }
+        double gridMs = (timer.Lap() * 1000.0) / numIterations;
+
+        unsigned int numMismatched = 0;
+        for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+        {
+            numMismatched += PopCount64(allEdgesBits[wordIndex] ^ gridBits[wordIndex]);
+        }
+
+        printf("    %6u %10u %10u %12.3lf %12.3lf %9.2lfx %10u\n", numEdges, 
+            grid.NumCellsX() * grid.NumCellsY(), grid.NumBoundaryCells(), allEdgesMs, gridMs, 
+            allEdgesMs / gridMs, numMismatched);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times ParticleUpdater::Update(...) against ParticleUpdater::UpdatePredicated(...) for 
+    fractions of active particles from 5% to 100%, and prints a table of milliseconds per 
+    frame.  Both are followed by the same Emit(...), which is timed separately ("emit").  The active particles are picked at random so 
+    that they are mixed with the inactive ones the way that they are after the demo has run for
+    a while, which is when the branches in Update(...) are hard to predict.
+
+    Each timed frame starts from the same saved particles, active bits, and free stack, which
+    are restored outside of the timer, so the fraction doesn't drift as particles leave and are
+    emitted.  "matches" says whether the two left the same particles active.
+Parameters:
+    updater         Has the region and emitters.
+    region          The updater's region.  The particles are placed inside it.  It must 
+                    contain some of [-1,+1] in X and Y.
+    numParticles    Self-explanatory.
+    numTimedFrames  Frames to average over, for each fraction and each version.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkPredicatedUpdate(const ParticleUpdater &updater, const IParticleRegion &region,
+    const unsigned int numParticles, const unsigned int numTimedFrames)
+{
+    printf("predicated update benchmark: %u particles, %u frames\n", numParticles, 
+        numTimedFrames);
+    printf("    %8s %12s %12s %10s %10s %10s\n", "active", "branching", "predicated", 
+        "speedup", "emit", "matches");
+
+    ParticleStorage storage;
+    storage.InitParticles(numParticles);
+    unsigned int numChunks = storage._activeMask.NumChunks();
+
+    std::vector<Particle> savedParticles(numParticles);
+    std::vector<unsigned long long> savedActiveBits(numChunks);
+    std::vector<unsigned int> savedFreeIndices;
+    savedFreeIndices.reserve(numParticles);
+    std::vector<unsigned long long> branchingActiveBits(numChunks);
+
+    const unsigned int activePercents[] = { 5, 10, 25, 50, 75, 90, 100 };
+    for (unsigned int percentIndex = 0; percentIndex < 7; percentIndex++)
+    {
+        // random positions inside the region (so that only the particles near its edges leave
+        // during the frame, like in the demo) with demo-like speeds
+        float activeFraction = activePercents[percentIndex] / 100.0f;
+        std::fill(savedActiveBits.begin(), savedActiveBits.end(), 0ULL);
+        savedFreeIndices.clear();
+        for (unsigned int particleIndex = numParticles; particleIndex > 0; particleIndex--)
+        {
+            unsigned int index = particleIndex - 1;
+            Particle &p = savedParticles[index];
+            do
+            {
+                p._position = glm::vec2((RandomOnRange0to1() * 2.0f) - 1.0f, 
+                    (RandomOnRange0to1() * 2.0f) - 1.0f);
+            } while (region.OutOfBounds(p._position));
+            float angle = RandomOnRange0to1() * 2.0f * 3.14159265f;
+            float speed = 0.3f + (RandomOnRange0to1() * 0.2f);
+            p._velocity = glm::vec2(cosf(angle), sinf(angle)) * speed;
+            if (RandomOnRange0to1() < activeFraction)
+            {
+                savedActiveBits[index / 64] |= 1ULL << (index % 64);
+            }
+            else
+            {
+                savedFreeIndices.push_back(index);
+            }
+        }
+
+        double updateMs[2] = { 0.0, 0.0 };
+        double emitMs = 0.0;
+        for (unsigned int versionIndex = 0; versionIndex < 2; versionIndex++)
+        {
+            Stopwatch timer;
+            timer.Init();
+            timer.Start();
+            double updateSec = 0.0;
+            double emitSec = 0.0;
+            for (unsigned int frameCount = 0; frameCount < numTimedFrames; frameCount++)
+            {
+                for (unsigned int particleIndex = 0; particleIndex < numParticles; 
+                    particleIndex++)
+                {
+                    storage._allParticles[particleIndex] = savedParticles[particleIndex];
+                }
+                for (unsigned int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+                {
+                    storage._activeMask.SetChunk(chunkIndex, savedActiveBits[chunkIndex]);
+                }
+                storage._freeIndices = savedFreeIndices;
+                timer.Lap();
+
+                if (versionIndex == 0)
+                {
+                    updater.Update(storage, 0, numParticles, BENCHMARK_DELTA_TIME_SEC);
+                }
+                else
+                {
+                    updater.UpdatePredicated(storage, 0, numParticles, BENCHMARK_DELTA_TIME_SEC);
+                }
+                updateSec += timer.Lap();
+
+                // emission doesn't change with the version, so it is timed on its own
+                if (frameCount == 0)
+                {
+                    for (unsigned int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+                    {
+                        branchingActiveBits[chunkIndex] ^= 
+                            storage._activeMask.GetChunk(chunkIndex);
+                    }
+                }
+                timer.Lap();
+                updater.Emit(storage);
+                emitSec += timer.Lap();
+            }
+            updateMs[versionIndex] = (updateSec * 1000.0) / numTimedFrames;
+            emitMs += (emitSec * 1000.0) / (numTimedFrames * 2);
+        }
+
+        // the first frame of each version XORed its active bits in, so matching bits cancel
+        bool matches = true;
+        for (unsigned int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+        {
+            matches = matches && (branchingActiveBits[chunkIndex] == 0);
+            branchingActiveBits[chunkIndex] = 0;
+        }
+
+        printf("    %7u%% %12.3lf %12.3lf %9.2lfx %10.3lf %10s\n", 
+            activePercents[percentIndex], updateMs[0], updateMs[1], updateMs[0] / updateMs[1], 
+            emitMs, matches ? "yes" : "NO");
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times ParticleUpdater::UpdateTiled(...) at several tile sizes against the untiled 
+    "structure of arrays" frame, with a force stage (light gravity) in both, and prints a table
+    of milliseconds per frame.  The untiled frame is what adding a stage looks like without 
+    tiles: the stage's own pass over the storage, then Update(...), then Emit(...).
+Parameters:
+    updater         Has the region and emitters.  It is copied, so the stage and the tile 
+                    sizes are not left on it.
+    numParticles    Should be well past the size of the caches, or else every pass is a cache 
+                    hit and tiling can't help.
+    numWarmupFrames Frames to run before timing, for each row.
+    numTimedFrames  Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkTiledUpdate(const ParticleUpdater &updater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames)
+{
+    printf("tiled update benchmark: %u particles, %u frames\n", numParticles, numTimedFrames);
+    printf("    %-32s %10s %10s\n", "update", "ms/frame", "active");
+
+    ParticleStageForce gravity(glm::vec2(0.0f, -0.1f));
+    ParticleStorageSoA storage;
+    unsigned int numActive = 0;
+    Stopwatch timer;
+    timer.Init();
+
+    // untiled
+    storage.InitParticles(numParticles);
+    for (unsigned int frameCount = 0; frameCount < numWarmupFrames + numTimedFrames; 
+        frameCount++)
+    {
+        if (frameCount == numWarmupFrames)
+        {
+            timer.Start();
+        }
+        gravity.Run(&storage, 0, numParticles, BENCHMARK_DELTA_TIME_SEC);
+        numActive = updater.Update(storage, 0, numParticles, BENCHMARK_DELTA_TIME_SEC);
+        numActive += updater.Emit(storage);
+    }
+    double msPerFrame = (timer.TotalTime() * 1000.0) / numTimedFrames;
+    printf("    %-32s %10.3lf %10u\n", "untiled (stage, update, emit)", msPerFrame, numActive);
+
+    ParticleUpdater tiledUpdater = updater;
+    tiledUpdater.AddStage(&gravity, PARTICLE_STAGE_BEFORE_INTEGRATE);
+    const unsigned int tileSizes[] = { 256, 1024, 2048, 4096, 16384, 65536 };
+    for (unsigned int tileSizeIndex = 0; tileSizeIndex < 6; tileSizeIndex++)
+    {
+        tiledUpdater.SetTileSize(tileSizes[tileSizeIndex]);
+        storage.InitParticles(numParticles);
+        for (unsigned int frameCount = 0; frameCount < numWarmupFrames + numTimedFrames; 
+            frameCount++)
+        {
+            if (frameCount == numWarmupFrames)
+            {
+                timer.Start();
+            }
+            numActive = tiledUpdater.UpdateTiled(storage, BENCHMARK_DELTA_TIME_SEC);
+        }
+        msPerFrame = (timer.TotalTime() * 1000.0) / numTimedFrames;
+
+        char name[32];
+        sprintf(name, "tiled, %u per tile", tiledUpdater.TileSize());
+        printf("    %-32s %10.3lf %10u\n", name, msPerFrame, numActive);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times ParticleUpdater::UpdateParallel(...) with 1, 2, 4, ... workers, up to the number of 
+    hardware threads, with stealing off (each worker only runs its even share) and then on, 
+    and prints a table of milliseconds per frame, the speedup over 1 worker, and how busy the 
+    workers were.  "min busy" is the least busy worker's share of the time spent in 
+    ParallelFor(...); with a static split that doesn't balance, it is well below "avg busy", 
+    and stealing should bring them together.  Each row gets a new task scheduler and a freshly 
+    initialized storage.
+Parameters:
+    updater         Has the region and emitters.  The quotas should be scaled to the particle 
+                    count (like BenchmarkStorageLayouts(...)), or there will be too few active 
+                    particles to be worth splitting up.
+    numParticles    Self-explanatory.
+    numWarmupFrames Frames to run before timing, for each row.
+    numTimedFrames  Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BenchmarkParallelUpdate(const ParticleUpdater &updater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames)
+{
+    unsigned int maxThreads = std::thread::hardware_concurrency();
+    maxThreads = (maxThreads == 0) ? 1 : maxThreads;
+    printf("parallel update benchmark: %u particles, %u frames, %u hardware threads\n", 
+        numParticles, numTimedFrames, maxThreads);
+    printf("    %8s %8s %10s %10s %10s %10s %10s %10s\n", "workers", "stealing", "ms/frame", 
+        "speedup", "min busy", "avg busy", "steals", "active");
+
+    ParticleStorage storage;
+    Stopwatch timer;
+    timer.Init();
+    double oneThreadMs = 0.0;
+    for (unsigned int numThreads = 1; ; numThreads *= 2)
+    {
+        // always finish with every hardware thread, even if that isn't a power of 2
+        numThreads = (numThreads > maxThreads) ? maxThreads : numThreads;
+
+        for (int stealing = 0; stealing < 2; stealing++)
+        {
+            ParticleTaskScheduler taskScheduler;
+            taskScheduler.Init(numThreads);
+            taskScheduler.SetStealing(stealing != 0);
+            storage.InitParticles(numParticles);
+            unsigned int numActive = 0;
+            for (unsigned int frameCount = 0; frameCount < numWarmupFrames + numTimedFrames; 
+                frameCount++)
+            {
+                if (frameCount == numWarmupFrames)
+                {
+                    taskScheduler.ResetStats();
+                    timer.Start();
+                }
+                numActive = updater.UpdateParallel(storage, taskScheduler, 
+                    BENCHMARK_DELTA_TIME_SEC);
+            }
+            double msPerFrame = (timer.TotalTime() * 1000.0) / numTimedFrames;
+            oneThreadMs = (numThreads == 1 && stealing == 0) ? msPerFrame : oneThreadMs;
+
+            double minBusySec = taskScheduler.WorkerStats(0)._busySec;
+            double totalBusySec = 0.0;
+            unsigned int numSteals = 0;
+            for (unsigned int workerIndex = 0; workerIndex < taskScheduler.NumWorkers(); 
+                workerIndex++)
+            {
+                const ParticleWorkerStats &stats = taskScheduler.WorkerStats(workerIndex);
+                minBusySec = (stats._busySec < minBusySec) ? stats._busySec : minBusySec;
+                totalBusySec += stats._busySec;
+                numSteals += stats._numSteals;
+            }
+            double parallelSec = taskScheduler.ParallelSec();
+            double minBusyPercent = (parallelSec > 0.0) ? (100.0 * minBusySec / parallelSec) : 0.0;
+            double avgBusyPercent = (parallelSec > 0.0) ? 
+                (100.0 * totalBusySec / (parallelSec * taskScheduler.NumWorkers())) : 0.0;
+
+            printf("    %8u %8s %10.3lf %9.2lfx %9.1lf%% %9.1lf%% %10u %10u\n", numThreads, 
+                (stealing != 0) ? "on" : "off", msPerFrame, oneThreadMs / msPerFrame, 
+                minBusyPercent, avgBusyPercent, numSteals, numActive);
+        }
+
+        if (numThreads == maxThreads)
+        {
+            break;
+        }
+    }
+}
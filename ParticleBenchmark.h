@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ParticleUpdater.h"
+#include "ParticleUpdaterT.h"
+#include "ParticleRegionPolygonFixed.h"
+#include "ParticleEmitterBar.h"
+#include "ParticleEmitterPoint.h"
+
+// the demo's scene (a 4-sided polygon with a bar and a point emitter) as a ParticleUpdaterT
+typedef ParticleUpdaterT<ParticleRegionPolygonFixed<4>, ParticleEmitterBar, 
+    ParticleEmitterPoint> DemoParticleUpdaterT;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Crude CPU timing of the particle update for each particle storage layout.  These run in the
+    demo itself (see Keyboard(...) in main.cpp) and print their results to the console, so they
+    don't need their own executable.
+
+    Only the CPU side (Update(...) and Emit(...)) is timed.  Uploading and drawing are left out
+    because they are the same number of bytes per particle for most layouts and would hide the
+    differences.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+
+void BenchmarkStorageLayouts(const ParticleUpdater &updater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames);
+void BenchmarkFixedPointRegions(const IParticleRegion &circleRegion, 
+    const IParticleRegion &polygonRegion, const unsigned int numPoints);
+void BenchmarkDevirtualizedUpdater(const ParticleUpdater &virtualUpdater, 
+    const DemoParticleUpdaterT &fixedUpdater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames);
+void BenchmarkParticleKernels(const unsigned int numParticles, const unsigned int numIterations);
+void BenchmarkPolygonEarlyOut(const unsigned int numParticles, const unsigned int numIterations);
+void BenchmarkPredicatedUpdate(const ParticleUpdater &updater, const IParticleRegion &region,
+    const unsigned int numParticles, const unsigned int numTimedFrames);
+void BenchmarkTiledUpdate(const ParticleUpdater &updater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames);
+void BenchmarkParallelUpdate(const ParticleUpdater &updater, const unsigned int numParticles,
+    const unsigned int numWarmupFrames, const unsigned int numTimedFrames);
+void BenchmarkPolygonGrid(const unsigned int numParticles, const unsigned int numIterations);
@@ -0,0 +1,81 @@
+#include "ParticleEmissionBudget.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.  Every budget starts empty.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleEmissionBudget::ParticleEmissionBudget()
+{
+    for (unsigned int emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        _counters[emitterIndex]._remaining.store(0);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets an emitter's budget for the coming frame.  Must not be called while other threads are
+    claiming.
+Parameters:
+    emitterIndex    Must be less than MAX_EMITTERS.
+    quota           How many particles the emitter may emit.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmissionBudget::Reset(const unsigned int emitterIndex, const unsigned int quota)
+{
+    _counters[emitterIndex]._remaining.store((int)quota, std::memory_order_relaxed);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes up to the wanted number of particles out of an emitter's budget.  Safe to call on
+    several threads at once.
+Parameters:
+    emitterIndex    Must be less than MAX_EMITTERS.
+    numWanted       The most to take.  Should be no more than the free slots that the caller
+                    has, because whatever is claimed is gone even if it isn't emitted.
+Returns:
+    How many were claimed, from 0 (the budget is used up) to numWanted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleEmissionBudget::Claim(const unsigned int emitterIndex,
+    const unsigned int numWanted)
+{
+    // the counter only guards itself, so relaxed is enough
+    std::atomic<int> &remaining = _counters[emitterIndex]._remaining;
+    if (numWanted == 0 || remaining.load(std::memory_order_relaxed) <= 0)
+    {
+        return 0;
+    }
+
+    int before = remaining.fetch_sub((int)numWanted, std::memory_order_relaxed);
+    if (before <= 0)
+    {
+        return 0;
+    }
+    return ((unsigned int)before < numWanted) ? (unsigned int)before : numWanted;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for how much of an emitter's budget hasn't been claimed.  Only exact when
+    no other thread is claiming.
+Parameters:
+    emitterIndex    Must be less than MAX_EMITTERS.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleEmissionBudget::Remaining(const unsigned int emitterIndex) const
+{
+    int remaining = _counters[emitterIndex]._remaining.load(std::memory_order_relaxed);
+    return (remaining > 0) ? (unsigned int)remaining : 0;
+}
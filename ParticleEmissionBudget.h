@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    How many more particles each emitter may emit this frame, shared by every thread of a
+    parallel update (see ParticleUpdater::UpdateParallel(...)).
+
+    Each emitter has an atomic counter that starts at its quota.  A thread that has free slots
+    claims a batch with one fetch_sub(...) and gets however much of the batch was still left,
+    so the claims add up to exactly the quota (or less, if the threads run out of free slots)
+    no matter how many threads there are or which one gets there first.  Nothing is locked and
+    nobody has to go over the whole storage afterwards to hand out what is left.
+
+    The counters may go below 0 when several threads claim the last few particles at once.
+    The extra is just never given out.  Once a counter is used up, Claim(...) only reads it,
+    so threads that are still asking don't fight over the cache line.  Each counter has a
+    cache line to itself so that claiming from one emitter doesn't slow down claims from
+    another.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleEmissionBudget
+{
+public:
+    static const unsigned int MAX_EMITTERS = 8;
+
+    ParticleEmissionBudget();
+    void Reset(const unsigned int emitterIndex, const unsigned int quota);
+    unsigned int Claim(const unsigned int emitterIndex, const unsigned int numWanted);
+    unsigned int Remaining(const unsigned int emitterIndex) const;
+
+private:
+    // not copyable, just like the atomics
+    ParticleEmissionBudget(const ParticleEmissionBudget &);
+    ParticleEmissionBudget &operator=(const ParticleEmissionBudget &);
+
+    // one to a typical 64-byte cache line
+    struct alignas(64) Counter
+    {
+        std::atomic<int> _remaining;
+    };
+
+    Counter _counters[MAX_EMITTERS];
+};
@@ -0,0 +1,55 @@
+#include "ParticleEmitBatch.h"
+
+#include "ParticleStorageSoA.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Interleaves a batch into a contiguous run of Particle structures.
+Parameters:
+    batch       Self-explanatory.
+    particles   Must fit "count" particles.
+    count       No more than PARTICLE_EMIT_BATCH_SIZE.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void StoreParticleEmitBatch(const ParticleEmitBatch &batch, Particle *particles,
+    const unsigned int count)
+{
+    for (unsigned int index = 0; index < count; index++)
+    {
+        particles[index]._position.x = batch._positionX[index];
+        particles[index]._position.y = batch._positionY[index];
+        particles[index]._velocity.x = batch._velocityX[index];
+        particles[index]._velocity.y = batch._velocityY[index];
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Copies a batch into the "structure of arrays" storage at the provided indices.
+Parameters:
+    batch           Self-explanatory.
+    pStorage        Self-explanatory.
+    particleIndices Where batch item N goes.
+    count           No more than PARTICLE_EMIT_BATCH_SIZE.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ScatterParticleEmitBatch(const ParticleEmitBatch &batch, ParticleStorageSoA *pStorage,
+    const unsigned int *particleIndices, const unsigned int count)
+{
+    float *positionX = pStorage->_positionX.data();
+    float *positionY = pStorage->_positionY.data();
+    float *velocityX = pStorage->_velocityX.data();
+    float *velocityY = pStorage->_velocityY.data();
+    for (unsigned int index = 0; index < count; index++)
+    {
+        unsigned int particleIndex = particleIndices[index];
+        positionX[particleIndex] = batch._positionX[index];
+        positionY[particleIndex] = batch._positionY[index];
+        velocityX[particleIndex] = batch._velocityX[index];
+        velocityY[particleIndex] = batch._velocityY[index];
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Particle.h"
+
+// forward declaration for the same reason as in IParticleEmitter.h
+struct ParticleStorageSoA;
+
+// the most particles that an emitter resets in one go; bigger requests are done in batches of
+// this many
+const unsigned int PARTICLE_EMIT_BATCH_SIZE = 64;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Newly emitted particles as a small "structure of arrays" on the stack.  The emitters'
+    ResetParticles(...) fill one of these with branch-free loops over the arrays, which the
+    compiler can vectorize, and then store or scatter it into whatever storage asked for the
+    particles.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleEmitBatch
+{
+    float _positionX[PARTICLE_EMIT_BATCH_SIZE];
+    float _positionY[PARTICLE_EMIT_BATCH_SIZE];
+    float _velocityX[PARTICLE_EMIT_BATCH_SIZE];
+    float _velocityY[PARTICLE_EMIT_BATCH_SIZE];
+};
+
+void StoreParticleEmitBatch(const ParticleEmitBatch &batch, Particle *particles,
+    const unsigned int count);
+void ScatterParticleEmitBatch(const ParticleEmitBatch &batch, ParticleStorageSoA *pStorage,
+    const unsigned int *particleIndices, const unsigned int count);
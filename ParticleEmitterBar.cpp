@@ -1,5 +1,6 @@
 #include "ParticleEmitterBar.h"
 
+#include "ParticleStorageSoA.h"
 #include "RandomToast.h"
 
 /*-----------------------------------------------------------------------------------------------
@@ -53,6 +54,106 @@ void ParticleEmitterBar::ResetParticle(Particle *resetThis) const
     resetThis->_velocity = _velocityCalculator.GetNew();
 }
 
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "structure of arrays" version of ResetParticle(...).  Resets a Particle structure and 
+    then scatters its members into the storage's arrays.  Does NOT alter the "is active" flag.
+Parameters:
+    resetThis       The storage that holds the particle.
+    particleIndex   Which particle in the storage's arrays.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterBar::ResetParticle(ParticleStorageSoA *resetThis, 
+    const unsigned int particleIndex) const
+{
+    Particle p;
+    ResetParticle(&p);
+    resetThis->_positionX[particleIndex] = p._position.x;
+    resetThis->_positionY[particleIndex] = p._position.y;
+    resetThis->_velocityX[particleIndex] = p._velocity.x;
+    resetThis->_velocityY[particleIndex] = p._velocity.y;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The batch version of ResetParticle(...) for a contiguous run of Particle structures.  Does 
+    NOT alter the "is active" flags.
+Parameters:
+    resetThese  Must fit "count" particles.
+    count       Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterBar::ResetParticles(Particle *resetThese, const unsigned int count) const
+{
+    ParticleEmitBatch batch;
+    for (unsigned int batchStart = 0; batchStart < count; batchStart += PARTICLE_EMIT_BATCH_SIZE)
+    {
+        unsigned int numInBatch = count - batchStart;
+        if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+        {
+            numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+        }
+        FillBatch(&batch, numInBatch);
+        StoreParticleEmitBatch(batch, resetThese + batchStart, numInBatch);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The batch version of ResetParticle(...) for "structure of arrays" storage.  Does NOT alter 
+    the "is active" flags.
+Parameters:
+    resetThis       The storage that holds the particles.
+    particleIndices Which particles in the storage's arrays.
+    count           The number of indices.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterBar::ResetParticles(ParticleStorageSoA *resetThis, 
+    const unsigned int *particleIndices, const unsigned int count) const
+{
+    ParticleEmitBatch batch;
+    for (unsigned int batchStart = 0; batchStart < count; batchStart += PARTICLE_EMIT_BATCH_SIZE)
+    {
+        unsigned int numInBatch = count - batchStart;
+        if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+        {
+            numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+        }
+        FillBatch(&batch, numInBatch);
+        ScatterParticleEmitBatch(batch, resetThis, particleIndices + batchStart, numInBatch);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Computes up to one batch of new particles: random points along the bar, launched in the 
+    emission direction.  Same distribution as ResetParticle(...).
+Parameters:
+    pBatch  Receives the particles.
+    count   No more than PARTICLE_EMIT_BATCH_SIZE.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterBar::FillBatch(ParticleEmitBatch *pBatch, const unsigned int count) const
+{
+    float alongBar[PARTICLE_EMIT_BATCH_SIZE];
+    RandomOnRange0to1Batch(alongBar, count);
+    for (unsigned int index = 0; index < count; index++)
+    {
+        pBatch->_positionX[index] = _currentBarStart.x + (alongBar[index] * _currentBarStartToEnd.x);
+        pBatch->_positionY[index] = _currentBarStart.y + (alongBar[index] * _currentBarStartToEnd.y);
+    }
+
+    _velocityCalculator.GetNewBatch(pBatch->_velocityX, pBatch->_velocityY, count);
+}
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Applies the transform to the emission direction and to the points that make up the bar.  The 
@@ -3,6 +3,7 @@
 #include "IParticleEmitter.h"
 #include "Particle.h"
 #include "MinMaxVelocity.h"
+#include "ParticleEmitBatch.h"
 #include "glm/vec2.hpp"
 
 /*-----------------------------------------------------------------------------------------------
@@ -12,14 +13,20 @@ Description:
     distributed along the bar.
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
-class ParticleEmitterBar : public IParticleEmitter
+class ParticleEmitterBar final : public IParticleEmitter
 {
 public:
     ParticleEmitterBar(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &emitDir,
         const float minVel, const float maxVel);
     virtual void ResetParticle(Particle *resetThis) const;
+    virtual void ResetParticle(ParticleStorageSoA *resetThis, const unsigned int particleIndex) const;
+    virtual void ResetParticles(Particle *resetThese, const unsigned int count) const;
+    virtual void ResetParticles(ParticleStorageSoA *resetThis, const unsigned int *particleIndices, 
+        const unsigned int count) const;
     virtual void SetTransform(const glm::mat4 &m);
 private:
+    void FillBatch(ParticleEmitBatch *pBatch, const unsigned int count) const;
+
     // I need the bar's start and start->end vector on every frame, but I don't need the end 
     // point except to calculate the start->end vector, so I'll calculate the later on class 
     // initialization and won't bother storing the end point
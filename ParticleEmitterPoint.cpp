@@ -1,7 +1,9 @@
 #include "ParticleEmitterPoint.h"
 
+#include "ParticleStorageSoA.h"
 #include "RandomToast.h"
 #include "glm/detail/func_geometric.hpp" // for normalizing glm vectors
+#include <math.h>   // for sqrtf(...)
 
 /*-----------------------------------------------------------------------------------------------
 Description:
@@ -49,6 +51,117 @@ void ParticleEmitterPoint::ResetParticle(Particle *resetThis) const
     resetThis->_velocity = _velocityCalculator.GetNew();
 }
 
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "structure of arrays" version of ResetParticle(...).  Resets a Particle structure and 
+    then scatters its members into the storage's arrays.  Does NOT alter the "is active" flag.
+Parameters:
+    resetThis       The storage that holds the particle.
+    particleIndex   Which particle in the storage's arrays.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterPoint::ResetParticle(ParticleStorageSoA *resetThis, 
+    const unsigned int particleIndex) const
+{
+    Particle p;
+    ResetParticle(&p);
+    resetThis->_positionX[particleIndex] = p._position.x;
+    resetThis->_positionY[particleIndex] = p._position.y;
+    resetThis->_velocityX[particleIndex] = p._velocity.x;
+    resetThis->_velocityY[particleIndex] = p._velocity.y;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The batch version of ResetParticle(...) for a contiguous run of Particle structures.  Does 
+    NOT alter the "is active" flags.
+Parameters:
+    resetThese  Must fit "count" particles.
+    count       Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterPoint::ResetParticles(Particle *resetThese, const unsigned int count) const
+{
+    ParticleEmitBatch batch;
+    for (unsigned int batchStart = 0; batchStart < count; batchStart += PARTICLE_EMIT_BATCH_SIZE)
+    {
+        unsigned int numInBatch = count - batchStart;
+        if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+        {
+            numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+        }
+        FillBatch(&batch, numInBatch);
+        StoreParticleEmitBatch(batch, resetThese + batchStart, numInBatch);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The batch version of ResetParticle(...) for "structure of arrays" storage.  Does NOT alter 
+    the "is active" flags.
+Parameters:
+    resetThis       The storage that holds the particles.
+    particleIndices Which particles in the storage's arrays.
+    count           The number of indices.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterPoint::ResetParticles(ParticleStorageSoA *resetThis, 
+    const unsigned int *particleIndices, const unsigned int count) const
+{
+    ParticleEmitBatch batch;
+    for (unsigned int batchStart = 0; batchStart < count; batchStart += PARTICLE_EMIT_BATCH_SIZE)
+    {
+        unsigned int numInBatch = count - batchStart;
+        if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+        {
+            numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+        }
+        FillBatch(&batch, numInBatch);
+        ScatterParticleEmitBatch(batch, resetThis, particleIndices + batchStart, numInBatch);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Computes up to one batch of new particles: random points within a small radius of the 
+    emitter, launched in random directions.  Same idea as ResetParticle(...), but the offset 
+    direction comes from a random point in the [-1,+1] square that is normalized with 1/sqrt 
+    (see MinMaxVelocity::GetNewBatch(...)).
+Parameters:
+    pBatch  Receives the particles.
+    count   No more than PARTICLE_EMIT_BATCH_SIZE.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterPoint::FillBatch(ParticleEmitBatch *pBatch, const unsigned int count) const
+{
+    float directionX[PARTICLE_EMIT_BATCH_SIZE];
+    float directionY[PARTICLE_EMIT_BATCH_SIZE];
+    float distance[PARTICLE_EMIT_BATCH_SIZE];
+    RandomOnRange0to1Batch(directionX, count);
+    RandomOnRange0to1Batch(directionY, count);
+    RandomOnRange0to1Batch(distance, count);
+    for (unsigned int index = 0; index < count; index++)
+    {
+        float x = (directionX[index] * 2.0f) - 1.0f;
+        float y = (directionY[index] * 2.0f) - 1.0f;
+        float lengthSqr = (x * x) + (y * y);
+        lengthSqr = (lengthSqr > 1e-12f) ? lengthSqr : 1e-12f;
+        float scale = (0.05f * distance[index]) / sqrtf(lengthSqr);
+        pBatch->_positionX[index] = _currentPosition.x + (x * scale);
+        pBatch->_positionY[index] = _currentPosition.y + (y * scale);
+    }
+
+    _velocityCalculator.GetNewBatch(pBatch->_velocityX, pBatch->_velocityY, count);
+}
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Applies the transform to the emission point.
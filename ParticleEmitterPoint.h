@@ -3,6 +3,7 @@
 #include "IParticleEmitter.h"
 #include "Particle.h"
 #include "MinMaxVelocity.h"
+#include "ParticleEmitBatch.h"
 #include "glm/vec2.hpp"
 
 /*-----------------------------------------------------------------------------------------------
@@ -11,14 +12,20 @@ Description:
     velocity to a random vector anywhere within 360 degrees.
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
-class ParticleEmitterPoint : public IParticleEmitter
+class ParticleEmitterPoint final : public IParticleEmitter
 {
 public:
     // emits randomly from the origin point
     ParticleEmitterPoint(const glm::vec2 &emitterPos, const float minVel, const float maxVel);
     virtual void ResetParticle(Particle *resetThis) const;
+    virtual void ResetParticle(ParticleStorageSoA *resetThis, const unsigned int particleIndex) const;
+    virtual void ResetParticles(Particle *resetThese, const unsigned int count) const;
+    virtual void ResetParticles(ParticleStorageSoA *resetThis, const unsigned int *particleIndices, 
+        const unsigned int count) const;
     virtual void SetTransform(const glm::mat4 &m);
 private:
+    void FillBatch(ParticleEmitBatch *pBatch, const unsigned int count) const;
+
     glm::vec2 _originalPosition;
     glm::vec2 _currentPosition;
     MinMaxVelocity _velocityCalculator;
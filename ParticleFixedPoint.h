@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Particle.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    An 8-byte alternative to the 16-byte Particle for when the whole world is window space.
+    Both position and velocity are 16-bit signed fixed-point numbers:
+    - Position: 32767 is +1.0 and -32767 is -1.0 (1 unit is about 0.00003 window widths).
+    - Velocity: 16384 is +1.0 per second, so the range is about +/-2 windows per second.
+
+    The position scale is exactly what OpenGL's "normalized" GL_SHORT vertex attributes use,
+    so the GPU turns the shorts back into floats on [-1,+1] for free as it fetches them (see
+    ParticleStorageFixedPoint::Init(...)).
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleFixedPoint
+{
+    short _positionX;
+    short _positionY;
+    short _velocityX;
+    short _velocityY;
+};
+
+static const float FIXED_POINT_POSITION_ONE = 32767.0f;
+static const float FIXED_POINT_VELOCITY_ONE = 16384.0f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Converts a float to a 16-bit fixed-point value with the provided scale, rounding to the
+    nearest value and clamping to the range of a short instead of wrapping.  NaN becomes 0.
+Parameters:
+    value   Self-explanatory.
+    one     The fixed-point value that represents 1.0.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline short ToFixedPoint(const float value, const float one)
+{
+    float scaled = value * one;
+
+    // NaN fails both of the clamp's comparisons, and casting it to a short is undefined
+    if (scaled != scaled)
+    {
+        return 0;
+    }
+    else if (scaled >= 32767.0f)
+    {
+        return 32767;
+    }
+    else if (scaled <= -32768.0f)
+    {
+        return -32768;
+    }
+
+    return (short)((scaled < 0.0f) ? (scaled - 0.5f) : (scaled + 0.5f));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Converts an emitted Particle to fixed point.  The emitters all work with floats, and
+    emission is rare next to updating, so this is where the conversion happens.
+Parameters:
+    p   Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline ParticleFixedPoint ToFixedPoint(const Particle &p)
+{
+    ParticleFixedPoint fixedPoint;
+    fixedPoint._positionX = ToFixedPoint(p._position.x, FIXED_POINT_POSITION_ONE);
+    fixedPoint._positionY = ToFixedPoint(p._position.y, FIXED_POINT_POSITION_ONE);
+    fixedPoint._velocityX = ToFixedPoint(p._velocity.x, FIXED_POINT_VELOCITY_ONE);
+    fixedPoint._velocityY = ToFixedPoint(p._velocity.y, FIXED_POINT_VELOCITY_ONE);
+    return fixedPoint;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Integer integration works in steps of 1/65536 of a fixed-point position unit per
+    fixed-point velocity unit: position += (velocity * stepScale) >> 16.  A velocity unit is
+    2 position units per second (see the scales above), so the step scale is
+    deltaTime * 2 * 65536.
+
+    The step scale is clamped so that velocity * stepScale can't overflow a 32-bit int, which
+    limits a single step to about half a second.
+Parameters:
+    deltaTimeSec    Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline int FixedPointStepScale(const float deltaTimeSec)
+{
+    float stepScale = deltaTimeSec * (FIXED_POINT_POSITION_ONE / FIXED_POINT_VELOCITY_ONE) * 65536.0f;
+    if (stepScale > 65535.0f)
+    {
+        return 65535;
+    }
+    else if (stepScale < 0.0f)
+    {
+        return 0;
+    }
+
+    return (int)(stepScale + 0.5f);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Moves a fixed-point position by one integration step.  The result is clamped to the range 
+    of a short so that a particle that runs off the edge of the window stays on that edge 
+    instead of wrapping around to the other side.
+Parameters:
+    position    Self-explanatory.
+    velocity    Self-explanatory.
+    stepScale   From FixedPointStepScale(...).
+Returns:
+    The new position.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline short FixedPointStep(const short position, const short velocity, const int stepScale)
+{
+    // round to nearest
+    int newPosition = position + (((velocity * stepScale) + 32768) >> 16);
+    if (newPosition > 32767)
+    {
+        newPosition = 32767;
+    }
+    else if (newPosition < -32768)
+    {
+        newPosition = -32768;
+    }
+    return (short)newPosition;
+}
@@ -0,0 +1,1257 @@
+#include "ParticleKernels.h"
+
+#include "BitOperations.h"
+
+#include <math.h>   // for sqrtf(...)
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PARTICLE_KERNELS_X86
+#endif
+
+// VS2015's compiler doesn't know the AVX-512 intrinsics (they arrived in VS2017 15.3), so that
+// build only goes up to AVX2
+#if defined(PARTICLE_KERNELS_X86) && (!defined(_MSC_VER) || _MSC_VER >= 1911)
+#define PARTICLE_KERNELS_AVX512
+#endif
+
+#ifdef PARTICLE_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>     // for __cpuid(...) and __cpuidex(...)
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// MSVC lets any function use any intrinsic, but GCC and Clang need each function that uses a
+// newer instruction set to say so, because the rest of the file is compiled for the baseline
+// CPU
+#ifdef _MSC_VER
+#define PARTICLE_KERNEL_TARGET(isa)
+#else
+#define PARTICLE_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// GCC will otherwise fuse a multiply and an add into an FMA in any function whose target has 
+// one (AVX-512 does), which rounds differently from the other variants
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The scalar version of one particle's worth of each kernel.  The vector kernels use these
+    for the leftover particles at the end of a 64-particle word.
+
+    Integration multiplies inactive particles' step by 0 instead of skipping them, like the
+    vector kernels do with a lane mask.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline void IntegrateOne(float *positionX, float *positionY, const float *velocityX,
+    const float *velocityY, const unsigned int particleIndex, const float stepSec)
+{
+    positionX[particleIndex] += velocityX[particleIndex] * stepSec;
+    positionY[particleIndex] += velocityY[particleIndex] * stepSec;
+}
+
+static inline bool OutOfBoundsCircleOne(const float positionX, const float positionY,
+    const glm::vec2 &center, const float radiusSqr)
+{
+    float dx = positionX - center.x;
+    float dy = positionY - center.y;
+    return ((dx * dx) + (dy * dy)) > radiusSqr;
+}
+
+static inline bool OutOfBoundsHalfPlanesOne(const float positionX, const float positionY,
+    const glm::vec2 *faceCenters, const glm::vec2 *faceNormals, const unsigned int numFaces)
+{
+    bool outsidePolygon = false;
+    for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+    {
+        float dx = positionX - faceCenters[faceIndex].x;
+        float dy = positionY - faceCenters[faceIndex].y;
+        outsidePolygon |= ((dx * faceNormals[faceIndex].x) + (dy * faceNormals[faceIndex].y)) > 0.0f;
+    }
+    return outsidePolygon;
+}
+
+// the bounded half-plane kernels that pack the undecided particles together do it over this 
+// many particles at a time (a multiple of 64); the packed positions are read back a little 
+// later instead of right after they are written, which some CPUs stall on
+static const unsigned int BOUNDED_BLOCK_SIZE = 256;
+
+// sets "undecided" if the particle is between the bounds' circles and needs the faces
+static inline bool OutOfBoundsCirclesOne(const float positionX, const float positionY,
+    const ParticlePolygonBounds &bounds, bool *pUndecided)
+{
+    float dx = positionX - bounds._center.x;
+    float dy = positionY - bounds._center.y;
+    float distSqr = (dx * dx) + (dy * dy);
+    bool outside = distSqr > bounds._outerRadiusSqr;
+    *pUndecided = !outside & !(distSqr < bounds._innerRadiusSqr);
+    return outside;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The number of particles in word "wordIndex" of a "count"-particle range: 64, except
+    possibly for the last word.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline unsigned int NumParticlesInWord(const unsigned int wordIndex,
+    const unsigned int count)
+{
+    unsigned int remaining = count - (wordIndex * 64);
+    return (remaining < 64) ? remaining : 64;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    For the SSE2 bounded half-plane kernel, which has no instructions to do this in registers.
+    CompactPositions(...) copies the positions of the particles whose bits are set in "bits" 
+    (relative to "wordStart") to the front of the "compact" arrays so that the face test runs 
+    on full vectors of only those particles.  ExpandBits(...) puts the face test's results 
+    back in those particles' bit positions.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline unsigned int CompactPositions(const float *positionX, const float *positionY,
+    const unsigned int wordStart, unsigned long long bits, float *compactX, float *compactY)
+{
+    unsigned int numCompacted = 0;
+    while (bits != 0)
+    {
+        unsigned int particleIndex = wordStart + CountTrailingZeros64(bits);
+        compactX[numCompacted] = positionX[particleIndex];
+        compactY[numCompacted] = positionY[particleIndex];
+        numCompacted++;
+        bits &= bits - 1;
+    }
+    return numCompacted;
+}
+
+static inline unsigned long long ExpandBits(unsigned long long compactBits,
+    unsigned long long positionBits)
+{
+    unsigned long long expanded = 0;
+    while (positionBits != 0)
+    {
+        unsigned long long lowestBit = positionBits & (~positionBits + 1);
+        expanded |= lowestBit & (0 - (compactBits & 1));
+        compactBits >>= 1;
+        positionBits &= positionBits - 1;
+    }
+    return expanded;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The scalar kernels.  Any CPU can run these.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static void IntegrateScalar(float *positionX, float *positionY, const float *velocityX,
+    const float *velocityY, const unsigned long long *activeBits, const unsigned int count,
+    const float deltaTimeSec)
+{
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned long long bits = activeBits[wordIndex];
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex++)
+        {
+            float stepSec = deltaTimeSec * (float)((bits >> bitIndex) & 1);
+            IntegrateOne(positionX, positionY, velocityX, velocityY, wordStart + bitIndex, stepSec);
+        }
+    }
+}
+
+static void OutOfBoundsCircleScalar(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 &center, const float radiusSqr,
+    unsigned long long *outOfBoundsBits)
+{
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bits |= (unsigned long long)OutOfBoundsCircleOne(positionX[particleIndex],
+                positionY[particleIndex], center, radiusSqr) << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+}
+
+static void OutOfBoundsHalfPlanesScalar(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, unsigned long long *outOfBoundsBits)
+{
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bits |= (unsigned long long)OutOfBoundsHalfPlanesOne(positionX[particleIndex],
+                positionY[particleIndex], faceCenters, faceNormals, numFaces) << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+}
+
+static void OutOfBoundsHalfPlanesBoundedScalar(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, const ParticlePolygonBounds &bounds,
+    unsigned long long *outOfBoundsBits)
+{
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        unsigned long long undecidedBits = 0;
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bool undecided = false;
+            bits |= (unsigned long long)OutOfBoundsCirclesOne(positionX[particleIndex],
+                positionY[particleIndex], bounds, &undecided) << bitIndex;
+            undecidedBits |= (unsigned long long)undecided << bitIndex;
+        }
+
+        // visit only the undecided particles instead of branching on every particle, which 
+        // the CPU can't predict when they are mixed together
+        while (undecidedBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(undecidedBits);
+            unsigned int particleIndex = wordStart + bitIndex;
+            bits |= (unsigned long long)OutOfBoundsHalfPlanesOne(positionX[particleIndex],
+                positionY[particleIndex], faceCenters, faceNormals, numFaces) << bitIndex;
+            undecidedBits &= undecidedBits - 1;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+}
+
+#ifdef PARTICLE_KERNELS_X86
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The SSE2 kernels: 4 particles per instruction.  Every x86 CPU since the Pentium 4 has SSE2,
+    and every x64 CPU does, so this is the floor on anything but ancient 32bit machines.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+PARTICLE_KERNEL_TARGET("sse2")
+static void IntegrateSSE2(float *positionX, float *positionY, const float *velocityX,
+    const float *velocityY, const unsigned long long *activeBits, const unsigned int count,
+    const float deltaTimeSec)
+{
+    const __m128i laneBits = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128 deltaTime = _mm_set1_ps(deltaTimeSec);
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned long long bits = activeBits[wordIndex];
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned int bitIndex = 0;
+        for (; bitIndex + 4 <= numInWord; bitIndex += 4)
+        {
+            // spread the 4 active bits across the lanes and turn each into all 1s or all 0s
+            __m128i fourBits = _mm_set1_epi32((int)((bits >> bitIndex) & 0xF));
+            __m128i isActive = _mm_cmpeq_epi32(_mm_and_si128(fourBits, laneBits), laneBits);
+            __m128 stepSec = _mm_and_ps(_mm_castsi128_ps(isActive), deltaTime);
+
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m128 posX = _mm_loadu_ps(positionX + particleIndex);
+            __m128 posY = _mm_loadu_ps(positionY + particleIndex);
+            posX = _mm_add_ps(posX, _mm_mul_ps(_mm_loadu_ps(velocityX + particleIndex), stepSec));
+            posY = _mm_add_ps(posY, _mm_mul_ps(_mm_loadu_ps(velocityY + particleIndex), stepSec));
+            _mm_storeu_ps(positionX + particleIndex, posX);
+            _mm_storeu_ps(positionY + particleIndex, posY);
+        }
+        for (; bitIndex < numInWord; bitIndex++)
+        {
+            float stepSec = deltaTimeSec * (float)((bits >> bitIndex) & 1);
+            IntegrateOne(positionX, positionY, velocityX, velocityY, wordStart + bitIndex, stepSec);
+        }
+    }
+}
+
+PARTICLE_KERNEL_TARGET("sse2")
+static void OutOfBoundsCircleSSE2(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 &center, const float radiusSqr,
+    unsigned long long *outOfBoundsBits)
+{
+    const __m128 centerX = _mm_set1_ps(center.x);
+    const __m128 centerY = _mm_set1_ps(center.y);
+    const __m128 radiusSqrV = _mm_set1_ps(radiusSqr);
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        unsigned int bitIndex = 0;
+        for (; bitIndex + 4 <= numInWord; bitIndex += 4)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(positionX + particleIndex), centerX);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(positionY + particleIndex), centerY);
+            __m128 distSqr = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            unsigned int laneMask = (unsigned int)_mm_movemask_ps(_mm_cmpgt_ps(distSqr, radiusSqrV));
+            bits |= (unsigned long long)laneMask << bitIndex;
+        }
+        for (; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bits |= (unsigned long long)OutOfBoundsCircleOne(positionX[particleIndex],
+                positionY[particleIndex], center, radiusSqr) << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+}
+
+PARTICLE_KERNEL_TARGET("sse2")
+static void OutOfBoundsHalfPlanesSSE2(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, unsigned long long *outOfBoundsBits)
+{
+    const __m128 zero = _mm_setzero_ps();
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        unsigned int bitIndex = 0;
+        for (; bitIndex + 4 <= numInWord; bitIndex += 4)
+        {
+            // the positions stay in registers while the faces are broadcast one at a time
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m128 posX = _mm_loadu_ps(positionX + particleIndex);
+            __m128 posY = _mm_loadu_ps(positionY + particleIndex);
+            __m128 outside = _mm_setzero_ps();
+            for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+            {
+                __m128 dx = _mm_sub_ps(posX, _mm_set1_ps(faceCenters[faceIndex].x));
+                __m128 dy = _mm_sub_ps(posY, _mm_set1_ps(faceCenters[faceIndex].y));
+                __m128 dot = _mm_add_ps(_mm_mul_ps(dx, _mm_set1_ps(faceNormals[faceIndex].x)),
+                    _mm_mul_ps(dy, _mm_set1_ps(faceNormals[faceIndex].y)));
+                outside = _mm_or_ps(outside, _mm_cmpgt_ps(dot, zero));
+            }
+            bits |= (unsigned long long)(unsigned int)_mm_movemask_ps(outside) << bitIndex;
+        }
+        for (; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bits |= (unsigned long long)OutOfBoundsHalfPlanesOne(positionX[particleIndex],
+                positionY[particleIndex], faceCenters, faceNormals, numFaces) << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+}
+
+PARTICLE_KERNEL_TARGET("sse2")
+static void OutOfBoundsHalfPlanesBoundedSSE2(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, const ParticlePolygonBounds &bounds,
+    unsigned long long *outOfBoundsBits)
+{
+    const __m128 centerX = _mm_set1_ps(bounds._center.x);
+    const __m128 centerY = _mm_set1_ps(bounds._center.y);
+    const __m128 innerRadiusSqr = _mm_set1_ps(bounds._innerRadiusSqr);
+    const __m128 outerRadiusSqr = _mm_set1_ps(bounds._outerRadiusSqr);
+    float compactX[64];
+    float compactY[64];
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        // sort the word's particles into "outside", "inside", and "undecided" with the circles
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        unsigned long long undecidedBits = 0;
+        unsigned int bitIndex = 0;
+        for (; bitIndex + 4 <= numInWord; bitIndex += 4)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(positionX + particleIndex), centerX);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(positionY + particleIndex), centerY);
+            __m128 distSqr = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            unsigned int outside = (unsigned int)_mm_movemask_ps(_mm_cmpgt_ps(distSqr, outerRadiusSqr));
+            unsigned int inside = (unsigned int)_mm_movemask_ps(_mm_cmplt_ps(distSqr, innerRadiusSqr));
+            bits |= (unsigned long long)outside << bitIndex;
+            undecidedBits |= (unsigned long long)(~(outside | inside) & 0xF) << bitIndex;
+        }
+        for (; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bool undecided = false;
+            bits |= (unsigned long long)OutOfBoundsCirclesOne(positionX[particleIndex],
+                positionY[particleIndex], bounds, &undecided) << bitIndex;
+            undecidedBits |= (unsigned long long)undecided << bitIndex;
+        }
+
+        // then run the faces on only the undecided ones, packed together
+        if (undecidedBits != 0)
+        {
+            unsigned int numCompacted = CompactPositions(positionX, positionY, wordStart,
+                undecidedBits, compactX, compactY);
+            unsigned long long compactBits = 0;
+            OutOfBoundsHalfPlanesSSE2(compactX, compactY, numCompacted, faceCenters, 
+                faceNormals, numFaces, &compactBits);
+            bits |= ExpandBits(compactBits, undecidedBits);
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Lane permutations for the AVX2 bounded half-plane kernel, indexed by an 8-lane mask.  AVX2
+    has no compress or expand instructions, but it can rearrange lanes by a vector of indices 
+    (VPERMPS), so these are the indices.  "_compact[mask]" moves the lanes whose bits are set 
+    to the front, in order, and "_expand[mask]" moves them back.  "_numSet[mask]" is the 
+    number of bits set.
+
+    Built once when the program starts.  That's 2x 8KB, which stays in the cache while the 
+    kernel runs.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct LaneCompactionTables
+{
+    LaneCompactionTables();
+    int _compact[256][8];
+    int _expand[256][8];
+    unsigned char _numSet[256];
+};
+
+LaneCompactionTables::LaneCompactionTables()
+{
+    for (unsigned int mask = 0; mask < 256; mask++)
+    {
+        unsigned int numSet = 0;
+        for (unsigned int lane = 0; lane < 8; lane++)
+        {
+            _compact[mask][lane] = 0;
+
+            // lanes that aren't set are masked off afterwards, so where they come from 
+            // doesn't matter
+            _expand[mask][lane] = numSet;
+            if ((mask >> lane) & 1)
+            {
+                _compact[mask][numSet] = lane;
+                numSet++;
+            }
+        }
+        _numSet[mask] = (unsigned char)numSet;
+    }
+}
+
+static const LaneCompactionTables gLaneCompactionTables;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The AVX2 kernels: 8 particles per instruction.  The lane mask for integration needs AVX2's
+    256bit integer compare.
+
+    Note: The upper halves of the YMM registers are cleared before returning so that any SSE
+    code that runs afterwards doesn't pay the AVX-SSE transition penalty.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+PARTICLE_KERNEL_TARGET("avx2")
+static void IntegrateAVX2(float *positionX, float *positionY, const float *velocityX,
+    const float *velocityY, const unsigned long long *activeBits, const unsigned int count,
+    const float deltaTimeSec)
+{
+    const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256 deltaTime = _mm256_set1_ps(deltaTimeSec);
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned long long bits = activeBits[wordIndex];
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned int bitIndex = 0;
+        for (; bitIndex + 8 <= numInWord; bitIndex += 8)
+        {
+            __m256i eightBits = _mm256_set1_epi32((int)((bits >> bitIndex) & 0xFF));
+            __m256i isActive = _mm256_cmpeq_epi32(_mm256_and_si256(eightBits, laneBits), laneBits);
+            __m256 stepSec = _mm256_and_ps(_mm256_castsi256_ps(isActive), deltaTime);
+
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m256 posX = _mm256_loadu_ps(positionX + particleIndex);
+            __m256 posY = _mm256_loadu_ps(positionY + particleIndex);
+            posX = _mm256_add_ps(posX, _mm256_mul_ps(_mm256_loadu_ps(velocityX + particleIndex), stepSec));
+            posY = _mm256_add_ps(posY, _mm256_mul_ps(_mm256_loadu_ps(velocityY + particleIndex), stepSec));
+            _mm256_storeu_ps(positionX + particleIndex, posX);
+            _mm256_storeu_ps(positionY + particleIndex, posY);
+        }
+        for (; bitIndex < numInWord; bitIndex++)
+        {
+            float stepSec = deltaTimeSec * (float)((bits >> bitIndex) & 1);
+            IntegrateOne(positionX, positionY, velocityX, velocityY, wordStart + bitIndex, stepSec);
+        }
+    }
+    _mm256_zeroupper();
+}
+
+PARTICLE_KERNEL_TARGET("avx2")
+static void OutOfBoundsCircleAVX2(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 &center, const float radiusSqr,
+    unsigned long long *outOfBoundsBits)
+{
+    const __m256 centerX = _mm256_set1_ps(center.x);
+    const __m256 centerY = _mm256_set1_ps(center.y);
+    const __m256 radiusSqrV = _mm256_set1_ps(radiusSqr);
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        unsigned int bitIndex = 0;
+        for (; bitIndex + 8 <= numInWord; bitIndex += 8)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(positionX + particleIndex), centerX);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(positionY + particleIndex), centerY);
+            __m256 distSqr = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            unsigned int laneMask = (unsigned int)_mm256_movemask_ps(
+                _mm256_cmp_ps(distSqr, radiusSqrV, _CMP_GT_OQ));
+            bits |= (unsigned long long)laneMask << bitIndex;
+        }
+        for (; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bits |= (unsigned long long)OutOfBoundsCircleOne(positionX[particleIndex],
+                positionY[particleIndex], center, radiusSqr) << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+    _mm256_zeroupper();
+}
+
+PARTICLE_KERNEL_TARGET("avx2")
+static void OutOfBoundsHalfPlanesAVX2(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, unsigned long long *outOfBoundsBits)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        unsigned int bitIndex = 0;
+        for (; bitIndex + 8 <= numInWord; bitIndex += 8)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m256 posX = _mm256_loadu_ps(positionX + particleIndex);
+            __m256 posY = _mm256_loadu_ps(positionY + particleIndex);
+            __m256 outside = _mm256_setzero_ps();
+            for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+            {
+                __m256 dx = _mm256_sub_ps(posX, _mm256_set1_ps(faceCenters[faceIndex].x));
+                __m256 dy = _mm256_sub_ps(posY, _mm256_set1_ps(faceCenters[faceIndex].y));
+                __m256 dot = _mm256_add_ps(_mm256_mul_ps(dx, _mm256_set1_ps(faceNormals[faceIndex].x)),
+                    _mm256_mul_ps(dy, _mm256_set1_ps(faceNormals[faceIndex].y)));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(dot, zero, _CMP_GT_OQ));
+            }
+            bits |= (unsigned long long)(unsigned int)_mm256_movemask_ps(outside) << bitIndex;
+        }
+        for (; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int particleIndex = wordStart + bitIndex;
+            bits |= (unsigned long long)OutOfBoundsHalfPlanesOne(positionX[particleIndex],
+                positionY[particleIndex], faceCenters, faceNormals, numFaces) << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+    _mm256_zeroupper();
+}
+
+PARTICLE_KERNEL_TARGET("avx2")
+static void OutOfBoundsHalfPlanesBoundedAVX2(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, const ParticlePolygonBounds &bounds,
+    unsigned long long *outOfBoundsBits)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 centerX = _mm256_set1_ps(bounds._center.x);
+    const __m256 centerY = _mm256_set1_ps(bounds._center.y);
+    const __m256 innerRadiusSqr = _mm256_set1_ps(bounds._innerRadiusSqr);
+    const __m256 outerRadiusSqr = _mm256_set1_ps(bounds._outerRadiusSqr);
+
+    // every group of 8 stores a full vector, so these have room for one past the end
+    float compactX[BOUNDED_BLOCK_SIZE + 8];
+    float compactY[BOUNDED_BLOCK_SIZE + 8];
+    float compactOutside[BOUNDED_BLOCK_SIZE + 8];
+    unsigned int groupUndecided[BOUNDED_BLOCK_SIZE / 8];
+    unsigned int groupOffsets[BOUNDED_BLOCK_SIZE / 8];
+
+    for (unsigned int blockStart = 0; blockStart < count; blockStart += BOUNDED_BLOCK_SIZE)
+    {
+        unsigned int numInBlock = count - blockStart;
+        numInBlock = (numInBlock < BOUNDED_BLOCK_SIZE) ? numInBlock : BOUNDED_BLOCK_SIZE;
+        unsigned int numGroups = numInBlock / 8;
+        unsigned long long *blockBits = outOfBoundsBits + (blockStart / 64);
+        for (unsigned int wordIndex = 0; wordIndex < (numInBlock + 63) / 64; wordIndex++)
+        {
+            blockBits[wordIndex] = 0;
+        }
+
+        // sort each group of 8 into "outside", "inside", and "undecided" with the circles, 
+        // and pack the undecided ones' positions together as it goes
+        unsigned int numCompacted = 0;
+        for (unsigned int groupIndex = 0; groupIndex < numGroups; groupIndex++)
+        {
+            unsigned int bitIndex = groupIndex * 8;
+            unsigned int particleIndex = blockStart + bitIndex;
+            __m256 posX = _mm256_loadu_ps(positionX + particleIndex);
+            __m256 posY = _mm256_loadu_ps(positionY + particleIndex);
+            __m256 dx = _mm256_sub_ps(posX, centerX);
+            __m256 dy = _mm256_sub_ps(posY, centerY);
+            __m256 distSqr = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            unsigned int outside = (unsigned int)_mm256_movemask_ps(
+                _mm256_cmp_ps(distSqr, outerRadiusSqr, _CMP_GT_OQ));
+            unsigned int inside = (unsigned int)_mm256_movemask_ps(
+                _mm256_cmp_ps(distSqr, innerRadiusSqr, _CMP_LT_OQ));
+            unsigned int undecided = ~(outside | inside) & 0xFF;
+            blockBits[bitIndex / 64] |= (unsigned long long)outside << (bitIndex % 64);
+
+            __m256i compactIndices = _mm256_loadu_si256(
+                (const __m256i *)gLaneCompactionTables._compact[undecided]);
+            _mm256_storeu_ps(compactX + numCompacted, _mm256_permutevar8x32_ps(posX, compactIndices));
+            _mm256_storeu_ps(compactY + numCompacted, _mm256_permutevar8x32_ps(posY, compactIndices));
+            groupUndecided[groupIndex] = undecided;
+            groupOffsets[groupIndex] = numCompacted;
+            numCompacted += gLaneCompactionTables._numSet[undecided];
+        }
+
+        // leftovers at the end of the last block
+        for (unsigned int bitIndex = numGroups * 8; bitIndex < numInBlock; bitIndex++)
+        {
+            unsigned int particleIndex = blockStart + bitIndex;
+            bool undecided = false;
+            bool outside = OutOfBoundsCirclesOne(positionX[particleIndex],
+                positionY[particleIndex], bounds, &undecided);
+            if (undecided)
+            {
+                outside = OutOfBoundsHalfPlanesOne(positionX[particleIndex],
+                    positionY[particleIndex], faceCenters, faceNormals, numFaces);
+            }
+            blockBits[bitIndex / 64] |= (unsigned long long)outside << (bitIndex % 64);
+        }
+
+        // the last vector of undecided particles may run past "numCompacted" into lanes that 
+        // no group wrote, so fill them with something; their results are never expanded
+        for (unsigned int compactIndex = numCompacted; (compactIndex % 8) != 0; compactIndex++)
+        {
+            compactX[compactIndex] = 0.0f;
+            compactY[compactIndex] = 0.0f;
+        }
+
+        // the faces, on full vectors of undecided particles only
+        for (unsigned int compactIndex = 0; compactIndex < numCompacted; compactIndex += 8)
+        {
+            __m256 posX = _mm256_loadu_ps(compactX + compactIndex);
+            __m256 posY = _mm256_loadu_ps(compactY + compactIndex);
+            __m256 outside = _mm256_setzero_ps();
+            for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+            {
+                __m256 dx = _mm256_sub_ps(posX, _mm256_set1_ps(faceCenters[faceIndex].x));
+                __m256 dy = _mm256_sub_ps(posY, _mm256_set1_ps(faceCenters[faceIndex].y));
+                __m256 dot = _mm256_add_ps(_mm256_mul_ps(dx, _mm256_set1_ps(faceNormals[faceIndex].x)),
+                    _mm256_mul_ps(dy, _mm256_set1_ps(faceNormals[faceIndex].y)));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(dot, zero, _CMP_GT_OQ));
+            }
+            _mm256_storeu_ps(compactOutside + compactIndex, outside);
+        }
+
+        // and put the results back where those particles came from
+        for (unsigned int groupIndex = 0; groupIndex < numGroups; groupIndex++)
+        {
+            unsigned int undecided = groupUndecided[groupIndex];
+            if (undecided == 0)
+            {
+                continue;
+            }
+
+            __m256i expandIndices = _mm256_loadu_si256(
+                (const __m256i *)gLaneCompactionTables._expand[undecided]);
+            __m256 outside = _mm256_permutevar8x32_ps(
+                _mm256_loadu_ps(compactOutside + groupOffsets[groupIndex]), expandIndices);
+            unsigned int outsideBits = (unsigned int)_mm256_movemask_ps(outside) & undecided;
+            unsigned int bitIndex = groupIndex * 8;
+            blockBits[bitIndex / 64] |= (unsigned long long)outsideBits << (bitIndex % 64);
+        }
+    }
+    _mm256_zeroupper();
+}
+
+#endif  // PARTICLE_KERNELS_X86
+
+#ifdef PARTICLE_KERNELS_AVX512
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The AVX-512 kernels: 16 particles per instruction.  AVX-512 has real mask registers, so the
+    active bits go straight into the instructions, compares produce bits directly, and the
+    leftover particles at the end of a word are handled with masked loads and stores instead
+    of a scalar loop.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+PARTICLE_KERNEL_TARGET("avx512f")
+static void IntegrateAVX512(float *positionX, float *positionY, const float *velocityX,
+    const float *velocityY, const unsigned long long *activeBits, const unsigned int count,
+    const float deltaTimeSec)
+{
+    const __m512 deltaTime = _mm512_set1_ps(deltaTimeSec);
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned long long bits = activeBits[wordIndex];
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex += 16)
+        {
+            unsigned int numInGroup = numInWord - bitIndex;
+            __mmask16 inRange = (numInGroup >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << numInGroup) - 1);
+            __mmask16 isActive = (__mmask16)(bits >> bitIndex) & inRange;
+            __m512 stepSec = _mm512_maskz_mov_ps(isActive, deltaTime);
+
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m512 posX = _mm512_maskz_loadu_ps(inRange, positionX + particleIndex);
+            __m512 posY = _mm512_maskz_loadu_ps(inRange, positionY + particleIndex);
+            __m512 velX = _mm512_maskz_loadu_ps(inRange, velocityX + particleIndex);
+            __m512 velY = _mm512_maskz_loadu_ps(inRange, velocityY + particleIndex);
+            posX = _mm512_add_ps(posX, _mm512_mul_ps(velX, stepSec));
+            posY = _mm512_add_ps(posY, _mm512_mul_ps(velY, stepSec));
+            _mm512_mask_storeu_ps(positionX + particleIndex, inRange, posX);
+            _mm512_mask_storeu_ps(positionY + particleIndex, inRange, posY);
+        }
+    }
+    _mm256_zeroupper();
+}
+
+PARTICLE_KERNEL_TARGET("avx512f")
+static void OutOfBoundsCircleAVX512(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 &center, const float radiusSqr,
+    unsigned long long *outOfBoundsBits)
+{
+    const __m512 centerX = _mm512_set1_ps(center.x);
+    const __m512 centerY = _mm512_set1_ps(center.y);
+    const __m512 radiusSqrV = _mm512_set1_ps(radiusSqr);
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex += 16)
+        {
+            unsigned int numInGroup = numInWord - bitIndex;
+            __mmask16 inRange = (numInGroup >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << numInGroup) - 1);
+
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m512 dx = _mm512_sub_ps(_mm512_maskz_loadu_ps(inRange, positionX + particleIndex), centerX);
+            __m512 dy = _mm512_sub_ps(_mm512_maskz_loadu_ps(inRange, positionY + particleIndex), centerY);
+            __m512 distSqr = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+            __mmask16 outside = _mm512_mask_cmp_ps_mask(inRange, distSqr, radiusSqrV, _CMP_GT_OQ);
+            bits |= (unsigned long long)outside << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+    _mm256_zeroupper();
+}
+
+PARTICLE_KERNEL_TARGET("avx512f")
+static void OutOfBoundsHalfPlanesAVX512(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, unsigned long long *outOfBoundsBits)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    unsigned int numWords = (count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = NumParticlesInWord(wordIndex, count);
+        unsigned long long bits = 0;
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex += 16)
+        {
+            unsigned int numInGroup = numInWord - bitIndex;
+            __mmask16 inRange = (numInGroup >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << numInGroup) - 1);
+
+            unsigned int particleIndex = wordStart + bitIndex;
+            __m512 posX = _mm512_maskz_loadu_ps(inRange, positionX + particleIndex);
+            __m512 posY = _mm512_maskz_loadu_ps(inRange, positionY + particleIndex);
+            __mmask16 outside = 0;
+            for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+            {
+                __m512 dx = _mm512_sub_ps(posX, _mm512_set1_ps(faceCenters[faceIndex].x));
+                __m512 dy = _mm512_sub_ps(posY, _mm512_set1_ps(faceCenters[faceIndex].y));
+                __m512 dot = _mm512_add_ps(_mm512_mul_ps(dx, _mm512_set1_ps(faceNormals[faceIndex].x)),
+                    _mm512_mul_ps(dy, _mm512_set1_ps(faceNormals[faceIndex].y)));
+                outside = (__mmask16)(outside | _mm512_mask_cmp_ps_mask(inRange, dot, zero, _CMP_GT_OQ));
+            }
+            bits |= (unsigned long long)outside << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+    _mm256_zeroupper();
+}
+
+// AVX-512 has compress and expand instructions, so the undecided particles are packed 
+// together and their results put back without a lookup table
+PARTICLE_KERNEL_TARGET("avx512f")
+static void OutOfBoundsHalfPlanesBoundedAVX512(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, const ParticlePolygonBounds &bounds,
+    unsigned long long *outOfBoundsBits)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 centerX = _mm512_set1_ps(bounds._center.x);
+    const __m512 centerY = _mm512_set1_ps(bounds._center.y);
+    const __m512 innerRadiusSqr = _mm512_set1_ps(bounds._innerRadiusSqr);
+    const __m512 outerRadiusSqr = _mm512_set1_ps(bounds._outerRadiusSqr);
+
+    // each group stores a full vector (compressing straight to memory is much slower on some 
+    // CPUs), so these have room for one past the end
+    float compactX[BOUNDED_BLOCK_SIZE + 16];
+    float compactY[BOUNDED_BLOCK_SIZE + 16];
+    __mmask16 compactOutside[(BOUNDED_BLOCK_SIZE / 16) + 1];
+    __mmask16 groupUndecided[BOUNDED_BLOCK_SIZE / 16];
+    unsigned int groupOffsets[BOUNDED_BLOCK_SIZE / 16];
+
+    for (unsigned int blockStart = 0; blockStart < count; blockStart += BOUNDED_BLOCK_SIZE)
+    {
+        unsigned int numInBlock = count - blockStart;
+        numInBlock = (numInBlock < BOUNDED_BLOCK_SIZE) ? numInBlock : BOUNDED_BLOCK_SIZE;
+        unsigned int numGroups = (numInBlock + 15) / 16;
+        unsigned long long *blockBits = outOfBoundsBits + (blockStart / 64);
+        for (unsigned int wordIndex = 0; wordIndex < (numInBlock + 63) / 64; wordIndex++)
+        {
+            blockBits[wordIndex] = 0;
+        }
+
+        // sort each group of 16 into "outside", "inside", and "undecided" with the circles, 
+        // and pack the undecided ones' positions together as it goes
+        unsigned int numCompacted = 0;
+        for (unsigned int groupIndex = 0; groupIndex < numGroups; groupIndex++)
+        {
+            unsigned int bitIndex = groupIndex * 16;
+            unsigned int numInGroup = numInBlock - bitIndex;
+            __mmask16 inRange = (numInGroup >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << numInGroup) - 1);
+
+            unsigned int particleIndex = blockStart + bitIndex;
+            __m512 posX = _mm512_maskz_loadu_ps(inRange, positionX + particleIndex);
+            __m512 posY = _mm512_maskz_loadu_ps(inRange, positionY + particleIndex);
+            __m512 dx = _mm512_sub_ps(posX, centerX);
+            __m512 dy = _mm512_sub_ps(posY, centerY);
+            __m512 distSqr = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+            __mmask16 outside = _mm512_mask_cmp_ps_mask(inRange, distSqr, outerRadiusSqr, _CMP_GT_OQ);
+            __mmask16 inside = _mm512_mask_cmp_ps_mask(inRange, distSqr, innerRadiusSqr, _CMP_LT_OQ);
+            __mmask16 undecided = (__mmask16)(inRange & ~(outside | inside));
+            blockBits[bitIndex / 64] |= (unsigned long long)outside << (bitIndex % 64);
+
+            _mm512_storeu_ps(compactX + numCompacted, _mm512_maskz_compress_ps(undecided, posX));
+            _mm512_storeu_ps(compactY + numCompacted, _mm512_maskz_compress_ps(undecided, posY));
+            groupUndecided[groupIndex] = undecided;
+            groupOffsets[groupIndex] = numCompacted;
+            numCompacted += PopCount64(undecided);
+        }
+
+        // the last vector of undecided particles may run past "numCompacted" into lanes that 
+        // no group wrote, so fill them with something; their results are never expanded
+        for (unsigned int compactIndex = numCompacted; (compactIndex % 16) != 0; compactIndex++)
+        {
+            compactX[compactIndex] = 0.0f;
+            compactY[compactIndex] = 0.0f;
+        }
+
+        // the faces, on full vectors of undecided particles only
+        for (unsigned int compactIndex = 0; compactIndex < numCompacted; compactIndex += 16)
+        {
+            __m512 posX = _mm512_loadu_ps(compactX + compactIndex);
+            __m512 posY = _mm512_loadu_ps(compactY + compactIndex);
+            __mmask16 outside = 0;
+            for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+            {
+                __m512 dx = _mm512_sub_ps(posX, _mm512_set1_ps(faceCenters[faceIndex].x));
+                __m512 dy = _mm512_sub_ps(posY, _mm512_set1_ps(faceCenters[faceIndex].y));
+                __m512 dot = _mm512_add_ps(_mm512_mul_ps(dx, _mm512_set1_ps(faceNormals[faceIndex].x)),
+                    _mm512_mul_ps(dy, _mm512_set1_ps(faceNormals[faceIndex].y)));
+                outside = (__mmask16)(outside | _mm512_cmp_ps_mask(dot, zero, _CMP_GT_OQ));
+            }
+            compactOutside[compactIndex / 16] = outside;
+        }
+        compactOutside[(numCompacted + 15) / 16] = 0;
+
+        // and put the results back where those particles came from
+        for (unsigned int groupIndex = 0; groupIndex < numGroups; groupIndex++)
+        {
+            __mmask16 undecided = groupUndecided[groupIndex];
+            if (undecided == 0)
+            {
+                continue;
+            }
+
+            // this group's results are the next few compacted bits, which may straddle two 
+            // of the compacted vectors
+            unsigned int offset = groupOffsets[groupIndex];
+            unsigned int straddle = ((unsigned int)compactOutside[offset / 16] | 
+                ((unsigned int)compactOutside[(offset / 16) + 1] << 16)) >> (offset % 16);
+            __m512i results = _mm512_maskz_set1_epi32((__mmask16)straddle, -1);
+            __m512i outside = _mm512_maskz_expand_epi32(undecided, results);
+            unsigned int bitIndex = groupIndex * 16;
+            blockBits[bitIndex / 64] |= 
+                (unsigned long long)_mm512_test_epi32_mask(outside, outside) << (bitIndex % 64);
+        }
+    }
+    _mm256_zeroupper();
+}
+
+#endif  // PARTICLE_KERNELS_AVX512
+
+// one table per variant, in enum order; variants that this build can't compile fall back to
+// the best one that it can, but ParticleKernelVariantSupported(...) will never pick them
+static const ParticleKernels gKernelTables[PARTICLE_KERNEL_NUM_VARIANTS] =
+{
+    { PARTICLE_KERNEL_SCALAR, IntegrateScalar, OutOfBoundsCircleScalar, OutOfBoundsHalfPlanesScalar,
+        OutOfBoundsHalfPlanesBoundedScalar, 5 },
+#ifdef PARTICLE_KERNELS_X86
+    { PARTICLE_KERNEL_SSE2, IntegrateSSE2, OutOfBoundsCircleSSE2, OutOfBoundsHalfPlanesSSE2,
+        OutOfBoundsHalfPlanesBoundedSSE2, 5 },
+    { PARTICLE_KERNEL_AVX2, IntegrateAVX2, OutOfBoundsCircleAVX2, OutOfBoundsHalfPlanesAVX2,
+        OutOfBoundsHalfPlanesBoundedAVX2, 9 },
+#else
+    { PARTICLE_KERNEL_SCALAR, IntegrateScalar, OutOfBoundsCircleScalar, OutOfBoundsHalfPlanesScalar,
+        OutOfBoundsHalfPlanesBoundedScalar, 5 },
+    { PARTICLE_KERNEL_SCALAR, IntegrateScalar, OutOfBoundsCircleScalar, OutOfBoundsHalfPlanesScalar,
+        OutOfBoundsHalfPlanesBoundedScalar, 5 },
+#endif
+#ifdef PARTICLE_KERNELS_AVX512
+    { PARTICLE_KERNEL_AVX512, IntegrateAVX512, OutOfBoundsCircleAVX512, OutOfBoundsHalfPlanesAVX512,
+        OutOfBoundsHalfPlanesBoundedAVX512, 9 },
+#elif defined(PARTICLE_KERNELS_X86)
+    { PARTICLE_KERNEL_AVX2, IntegrateAVX2, OutOfBoundsCircleAVX2, OutOfBoundsHalfPlanesAVX2,
+        OutOfBoundsHalfPlanesBoundedAVX2, 9 },
+#else
+    { PARTICLE_KERNEL_SCALAR, IntegrateScalar, OutOfBoundsCircleScalar, OutOfBoundsHalfPlanesScalar,
+        OutOfBoundsHalfPlanesBoundedScalar, 5 },
+#endif
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    For reporting which variant is in use.
+Parameters:
+    variant     Self-explanatory.
+Returns:
+    A short, human-readable name.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+const char *ParticleKernelVariantName(const ParticleKernelVariant variant)
+{
+    switch (variant)
+    {
+    case PARTICLE_KERNEL_SSE2:
+        return "SSE2";
+    case PARTICLE_KERNEL_AVX2:
+        return "AVX2";
+    case PARTICLE_KERNEL_AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Asks the CPU which instruction sets it has.  AVX and AVX-512 also need the OS to save the
+    wider registers on a context switch, which XGETBV reports, or else the instructions fault
+    even though CPUID says that they exist.
+
+    This is the same for every call, but it is cheap and only runs when a variant is chosen.
+Parameters: None
+Returns:
+    The widest variant that will run on this machine and that this build has.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleKernelVariant BestSupportedParticleKernelVariant()
+{
+#ifdef PARTICLE_KERNELS_X86
+    unsigned int maxLeaf = 0;
+    unsigned int leaf1Ecx = 0;
+    unsigned int leaf1Edx = 0;
+    unsigned int leaf7Ebx = 0;
+    unsigned long long enabledStateBits = 0;
+#ifdef _MSC_VER
+    int registers[4] = { 0 };
+    __cpuid(registers, 0);
+    maxLeaf = (unsigned int)registers[0];
+    __cpuid(registers, 1);
+    leaf1Ecx = (unsigned int)registers[2];
+    leaf1Edx = (unsigned int)registers[3];
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(registers, 7, 0);
+        leaf7Ebx = (unsigned int)registers[1];
+    }
+    bool osSavesState = ((leaf1Ecx >> 27) & 1) != 0;    // OSXSAVE
+    if (osSavesState)
+    {
+        enabledStateBits = _xgetbv(0);
+    }
+#else
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    maxLeaf = __get_cpuid_max(0, 0);
+    if (maxLeaf >= 1)
+    {
+        __cpuid(1, eax, ebx, ecx, edx);
+        leaf1Ecx = ecx;
+        leaf1Edx = edx;
+    }
+    if (maxLeaf >= 7)
+    {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        leaf7Ebx = ebx;
+    }
+    bool osSavesState = ((leaf1Ecx >> 27) & 1) != 0;    // OSXSAVE
+    if (osSavesState)
+    {
+        unsigned int low = 0;
+        unsigned int high = 0;
+        __asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+        enabledStateBits = ((unsigned long long)high << 32) | low;
+    }
+#endif
+
+    bool hasSSE2 = ((leaf1Edx >> 26) & 1) != 0;
+    bool hasAVX = ((leaf1Ecx >> 28) & 1) != 0;
+    bool hasAVX2 = ((leaf7Ebx >> 5) & 1) != 0;
+    bool hasAVX512F = ((leaf7Ebx >> 16) & 1) != 0;
+
+    // XMM and YMM state (bits 1 and 2), plus the opmask and ZMM state (bits 5-7) for AVX-512
+    bool osSavesYmm = (enabledStateBits & 0x06) == 0x06;
+    bool osSavesZmm = (enabledStateBits & 0xE6) == 0xE6;
+
+#ifdef PARTICLE_KERNELS_AVX512
+    if (hasAVX && hasAVX2 && hasAVX512F && osSavesZmm)
+    {
+        return PARTICLE_KERNEL_AVX512;
+    }
+#else
+    (void)hasAVX512F;
+    (void)osSavesZmm;
+#endif
+    if (hasAVX && hasAVX2 && osSavesYmm)
+    {
+        return PARTICLE_KERNEL_AVX2;
+    }
+    if (hasSSE2)
+    {
+        return PARTICLE_KERNEL_SSE2;
+    }
+#endif
+    return PARTICLE_KERNEL_SCALAR;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Every CPU that supports a variant also supports the narrower ones.
+Parameters:
+    variant     Self-explanatory.
+Returns:
+    True if the variant will run on this machine, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleKernelVariantSupported(const ParticleKernelVariant variant)
+{
+    static const ParticleKernelVariant bestVariant = BestSupportedParticleKernelVariant();
+    return variant >= PARTICLE_KERNEL_SCALAR && variant <= bestVariant;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The variant that GetParticleKernels() returns.  It starts out as the best one that is
+    supported and only changes if someone forces it.
+Parameters: None
+Returns:
+    A reference to the one copy.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static ParticleKernelVariant &CurrentVariant()
+{
+    static ParticleKernelVariant currentVariant = BestSupportedParticleKernelVariant();
+    return currentVariant;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes every user of GetParticleKernels() use a particular variant from now on.  This is for
+    comparing variants on one machine.  Don't call this while another thread is updating
+    particles.
+Parameters:
+    variant     Self-explanatory.
+Returns:
+    True if the variant is supported and is now in use, otherwise false and nothing changes.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ForceParticleKernelVariant(const ParticleKernelVariant variant)
+{
+    if (!ParticleKernelVariantSupported(variant))
+    {
+        return false;
+    }
+
+    CurrentVariant() = variant;
+    return true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The kernels that the particle updater should use: the best supported variant unless one
+    was forced.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+const ParticleKernels &GetParticleKernels()
+{
+    return gKernelTables[CurrentVariant()];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A specific variant's kernels, regardless of which one is in use.  Check
+    ParticleKernelVariantSupported(...) first, because calling an unsupported variant's kernels
+    will crash with an illegal instruction.
+Parameters:
+    variant     Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+const ParticleKernels &GetParticleKernels(const ParticleKernelVariant variant)
+{
+    return gKernelTables[variant];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Works out the inner and outer circles of a convex polygon for the bounded half-plane 
+    kernels.  The center is the average of the face centers, which is inside any convex 
+    polygon.  The inner radius is the distance to the nearest face and the outer radius is the 
+    distance to the farthest corner.
+
+    The corners are not stored anywhere, so they are recovered from the faces.  This relies on 
+    each face normal being its corner->corner vector rotated -90 degrees and not normalized, 
+    which is how ParticleRegionPolygon and ParticleRegionPolygonFixed<...> make them (and a 
+    transform rotates both the same way).
+Parameters:
+    faceCenters     Self-explanatory.
+    faceNormals     See description.
+    numFaces        Self-explanatory.
+Returns:
+    A filled-out ParticlePolygonBounds.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticlePolygonBounds CalculatePolygonBounds(const glm::vec2 *faceCenters,
+    const glm::vec2 *faceNormals, const unsigned int numFaces)
+{
+    // relative and absolute padding; window space is about 2 units across, so float rounding 
+    // in the face test is several orders of magnitude smaller than either
+    static const float RADIUS_PADDING_SCALE = 0.001f;
+    static const float RADIUS_PADDING_ABSOLUTE = 0.00001f;
+
+    glm::vec2 center(0.0f, 0.0f);
+    for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+    {
+        center += faceCenters[faceIndex];
+    }
+    center /= (float)numFaces;
+
+    float innerRadius = -1.0f;
+    float outerRadius = 0.0f;
+    for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+    {
+        glm::vec2 normal = faceNormals[faceIndex];
+        float normalLength = sqrtf((normal.x * normal.x) + (normal.y * normal.y));
+        if (normalLength == 0.0f)
+        {
+            // a face with no length can't put anything out of bounds
+            continue;
+        }
+
+        glm::vec2 toFace = faceCenters[faceIndex] - center;
+        float faceDistance = ((toFace.x * normal.x) + (toFace.y * normal.y)) / normalLength;
+        if (innerRadius < 0.0f || faceDistance < innerRadius)
+        {
+            innerRadius = faceDistance;
+        }
+
+        // undo the -90 degree rotation to get half of the corner->corner vector
+        glm::vec2 halfEdge = glm::vec2(-(normal.y), normal.x) * 0.5f;
+        glm::vec2 toCorner1 = toFace - halfEdge;
+        glm::vec2 toCorner2 = toFace + halfEdge;
+        float corner1Distance = sqrtf((toCorner1.x * toCorner1.x) + (toCorner1.y * toCorner1.y));
+        float corner2Distance = sqrtf((toCorner2.x * toCorner2.x) + (toCorner2.y * toCorner2.y));
+        outerRadius = (corner1Distance > outerRadius) ? corner1Distance : outerRadius;
+        outerRadius = (corner2Distance > outerRadius) ? corner2Distance : outerRadius;
+    }
+
+    // a negative inner radius (not convex, or no faces) accepts nothing
+    innerRadius = (innerRadius * (1.0f - RADIUS_PADDING_SCALE)) - RADIUS_PADDING_ABSOLUTE;
+    innerRadius = (innerRadius > 0.0f) ? innerRadius : 0.0f;
+    outerRadius = (outerRadius * (1.0f + RADIUS_PADDING_SCALE)) + RADIUS_PADDING_ABSOLUTE;
+
+    ParticlePolygonBounds bounds;
+    bounds._center = center;
+    bounds._innerRadiusSqr = innerRadius * innerRadius;
+    bounds._outerRadiusSqr = outerRadius * outerRadius;
+    return bounds;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "glm/vec2.hpp"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The instruction set variants of the particle kernels.  Higher values need newer CPUs.  The
+    best one that this CPU (and OS) supports is chosen from CPUID the first time that the
+    kernels are used, so one executable runs the widest kernels that each machine has.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+enum ParticleKernelVariant
+{
+    PARTICLE_KERNEL_SCALAR = 0,
+    PARTICLE_KERNEL_SSE2,       // 4 particles at a time
+    PARTICLE_KERNEL_AVX2,       // 8 particles at a time
+    PARTICLE_KERNEL_AVX512,     // 16 particles at a time
+    PARTICLE_KERNEL_NUM_VARIANTS,
+};
+
+// moves the particles whose bits are set in "activeBits" (bit N of word M is particle
+// (M * 64) + N); the others are left where they are
+typedef void(*ParticleIntegrateKernel)(float *positionX, float *positionY,
+    const float *velocityX, const float *velocityY, const unsigned long long *activeBits,
+    const unsigned int count, const float deltaTimeSec);
+
+// sets bit N of word M in "outOfBoundsBits" if particle (M * 64) + N is farther than the
+// radius from the center; every word that covers "count" is overwritten
+typedef void(*ParticleCircleKernel)(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 &center, const float radiusSqr,
+    unsigned long long *outOfBoundsBits);
+
+// same, but the particle is out of bounds if it is in front of any of the faces (see
+// ParticleRegionPolygon)
+typedef void(*ParticleHalfPlaneKernel)(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, unsigned long long *outOfBoundsBits);
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A circle inside a convex polygon and a circle around it.  Particles inside the inner one
+    are inside the polygon and particles outside the outer one are not, so only the particles
+    in between need to be tested against every face.
+
+    Both radii are padded a little (the inner one smaller, the outer one larger) so that float
+    rounding can never make this shortcut disagree with the faces themselves.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticlePolygonBounds
+{
+    glm::vec2 _center;
+    float _innerRadiusSqr;
+    float _outerRadiusSqr;
+};
+
+// same result as ParticleHalfPlaneKernel, but the particles that the bounds decide skip the
+// faces
+typedef void(*ParticleBoundedHalfPlaneKernel)(const float *positionX, const float *positionY,
+    const unsigned int count, const glm::vec2 *faceCenters, const glm::vec2 *faceNormals,
+    const unsigned int numFaces, const ParticlePolygonBounds &bounds,
+    unsigned long long *outOfBoundsBits);
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    One variant's set of kernels for "structure of arrays" particle data.
+
+    Every variant does the same floating point operations in the same order (in particular,
+    none of them use fused multiply-add), so they all give bit-for-bit the same results and
+    switching variants doesn't change the simulation.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleKernels
+{
+    ParticleKernelVariant _variant;
+    ParticleIntegrateKernel _integrate;
+    ParticleCircleKernel _outOfBoundsCircle;
+    ParticleHalfPlaneKernel _outOfBoundsHalfPlanes;
+    ParticleBoundedHalfPlaneKernel _outOfBoundsHalfPlanesBounded;
+
+    // the bounded half-plane kernel only pays for itself from this many faces on; the wider 
+    // the variant, the cheaper each face already is (see BenchmarkPolygonEarlyOut(...))
+    unsigned int _boundedMinFaces;
+};
+
+const char *ParticleKernelVariantName(const ParticleKernelVariant variant);
+ParticleKernelVariant BestSupportedParticleKernelVariant();
+bool ParticleKernelVariantSupported(const ParticleKernelVariant variant);
+bool ForceParticleKernelVariant(const ParticleKernelVariant variant);
+const ParticleKernels &GetParticleKernels();
+const ParticleKernels &GetParticleKernels(const ParticleKernelVariant variant);
+ParticlePolygonBounds CalculatePolygonBounds(const glm::vec2 *faceCenters,
+    const glm::vec2 *faceNormals, const unsigned int numFaces);
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs whichever of the two half-plane kernels is faster for this many faces.  For the 
+    polygon regions' OutOfBoundsBatch(...).
+Parameters:
+    kernels     Usually GetParticleKernels().
+    (the rest)  See ParticleBoundedHalfPlaneKernel.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline void OutOfBoundsConvexPolygon(const ParticleKernels &kernels, const float *positionX, 
+    const float *positionY, const unsigned int count, const glm::vec2 *faceCenters, 
+    const glm::vec2 *faceNormals, const unsigned int numFaces, 
+    const ParticlePolygonBounds &bounds, unsigned long long *outOfBoundsBits)
+{
+    if (numFaces >= kernels._boundedMinFaces)
+    {
+        kernels._outOfBoundsHalfPlanesBounded(positionX, positionY, count, faceCenters, 
+            faceNormals, numFaces, bounds, outOfBoundsBits);
+    }
+    else
+    {
+        kernels._outOfBoundsHalfPlanes(positionX, positionY, count, faceCenters, faceNormals, 
+            numFaces, outOfBoundsBits);
+    }
+}
@@ -0,0 +1,190 @@
+#include "ParticleMemory.h"
+
+#include <new>      // for std::bad_alloc
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <stdint.h> // for uintptr_t
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    For reporting which policy was applied.
+Parameters:
+    policy  Self-explanatory.
+Returns:
+    A short, human-readable name.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+const char *ParticleMemoryPolicyName(const ParticleMemoryPolicy policy)
+{
+    switch (policy)
+    {
+    case PARTICLE_MEMORY_TRANSPARENT_HUGE_PAGES:
+        return "transparent huge pages";
+    case PARTICLE_MEMORY_EXPLICIT_HUGE_PAGES:
+        return "explicit huge pages";
+    default:
+        return "default pages";
+    }
+}
+
+#ifdef _WIN32
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gets page-granular, zero-filled memory straight from the OS with the requested policy, or
+    the best one that could be applied.
+
+    Windows version: Large pages need the "Lock pages in memory" privilege and a size that is
+    a multiple of the large page size.  There are no transparent huge pages on Windows.
+Parameters:
+    numBytes        Should be a multiple of PARTICLE_MEMORY_HUGE_PAGE_BYTES.
+    requestedPolicy Self-explanatory.
+    pAppliedPolicy  Receives the policy that was actually used.
+Returns:
+    A pointer to the memory.  Free it with FreeParticleMemory(...).
+Exception:  Throws std::bad_alloc if not even default pages could be allocated.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void *AllocateParticleMemory(const size_t numBytes, const ParticleMemoryPolicy requestedPolicy,
+    ParticleMemoryPolicy *pAppliedPolicy)
+{
+    void *pMemory = 0;
+    if (requestedPolicy == PARTICLE_MEMORY_EXPLICIT_HUGE_PAGES)
+    {
+        SIZE_T largePageBytes = GetLargePageMinimum();
+        if (largePageBytes != 0 && (numBytes % largePageBytes) == 0)
+        {
+            pMemory = VirtualAlloc(0, numBytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                PAGE_READWRITE);
+            if (pMemory != 0)
+            {
+                *pAppliedPolicy = PARTICLE_MEMORY_EXPLICIT_HUGE_PAGES;
+                return pMemory;
+            }
+        }
+    }
+
+    // reserve and commit, but the pages aren't placed until they are first written to
+    pMemory = VirtualAlloc(0, numBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (pMemory == 0)
+    {
+        throw std::bad_alloc();
+    }
+    *pAppliedPolicy = PARTICLE_MEMORY_DEFAULT_PAGES;
+    return pMemory;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives memory from AllocateParticleMemory(...) back to the OS.
+Parameters:
+    pMemory     Self-explanatory.
+    numBytes    Not needed on Windows, but the Linux version does.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FreeParticleMemory(void *pMemory, const size_t)
+{
+    if (pMemory != 0)
+    {
+        VirtualFree(pMemory, 0, MEM_RELEASE);
+    }
+}
+
+#else
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gets page-granular, zero-filled memory straight from the OS with the requested policy, or
+    the best one that could be applied.
+
+    Linux version: Explicit huge pages come from the pool reserved in
+    /proc/sys/vm/nr_hugepages and fail if it is empty.  Transparent huge pages only apply to
+    2MB-aligned ranges, so the mapping is over-allocated and trimmed to start on a 2MB
+    boundary before madvise(...) is asked for them.
+Parameters:
+    numBytes        Should be a multiple of PARTICLE_MEMORY_HUGE_PAGE_BYTES.
+    requestedPolicy Self-explanatory.
+    pAppliedPolicy  Receives the policy that was actually used.
+Returns:
+    A pointer to the memory.  Free it with FreeParticleMemory(...).
+Exception:  Throws std::bad_alloc if not even default pages could be allocated.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void *AllocateParticleMemory(const size_t numBytes, const ParticleMemoryPolicy requestedPolicy,
+    ParticleMemoryPolicy *pAppliedPolicy)
+{
+    void *pMemory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (requestedPolicy == PARTICLE_MEMORY_EXPLICIT_HUGE_PAGES &&
+        (numBytes % PARTICLE_MEMORY_HUGE_PAGE_BYTES) == 0)
+    {
+        pMemory = mmap(0, numBytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (pMemory != MAP_FAILED)
+        {
+            *pAppliedPolicy = PARTICLE_MEMORY_EXPLICIT_HUGE_PAGES;
+            return pMemory;
+        }
+    }
+#endif
+
+    // over-allocate by one huge page so that there is a 2MB boundary to start on, then give
+    // back the unused head and tail
+    size_t mappedBytes = numBytes + PARTICLE_MEMORY_HUGE_PAGE_BYTES;
+    pMemory = mmap(0, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pMemory == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    uintptr_t mappedStart = (uintptr_t)pMemory;
+    uintptr_t alignedStart = (mappedStart + PARTICLE_MEMORY_HUGE_PAGE_BYTES - 1) &
+        ~(uintptr_t)(PARTICLE_MEMORY_HUGE_PAGE_BYTES - 1);
+    size_t headBytes = alignedStart - mappedStart;
+    size_t tailBytes = mappedBytes - headBytes - numBytes;
+    if (headBytes > 0)
+    {
+        munmap(pMemory, headBytes);
+    }
+    if (tailBytes > 0)
+    {
+        munmap((void *)(alignedStart + numBytes), tailBytes);
+    }
+    pMemory = (void *)alignedStart;
+
+    *pAppliedPolicy = PARTICLE_MEMORY_DEFAULT_PAGES;
+#ifdef MADV_HUGEPAGE
+    if (requestedPolicy >= PARTICLE_MEMORY_TRANSPARENT_HUGE_PAGES &&
+        madvise(pMemory, numBytes, MADV_HUGEPAGE) == 0)
+    {
+        *pAppliedPolicy = PARTICLE_MEMORY_TRANSPARENT_HUGE_PAGES;
+    }
+#endif
+    return pMemory;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives memory from AllocateParticleMemory(...) back to the OS.
+Parameters:
+    pMemory     Self-explanatory.
+    numBytes    Must be the same as when it was allocated.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void FreeParticleMemory(void *pMemory, const size_t numBytes)
+{
+    if (pMemory != 0)
+    {
+        munmap(pMemory, numBytes);
+    }
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>  // for size_t
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    How the memory for large particle buffers (the ParticlePool segments) is requested from the
+    operating system.  Higher values are "bigger" pages.  If a policy can't be applied, the next
+    lower one is tried, so the applied policy can be lower than the requested one.
+
+    - Default pages: 4KB pages.
+    - Transparent huge pages: 4KB pages that the OS is asked to back with 2MB pages when it can
+    (Linux madvise(MADV_HUGEPAGE)).  Windows has no such thing, so there it falls back to
+    default pages.
+    - Explicit huge pages: memory that is allocated as huge pages up front (Linux MAP_HUGETLB,
+    which needs pages reserved in /proc/sys/vm/nr_hugepages; Windows MEM_LARGE_PAGES, which
+    needs the "Lock pages in memory" privilege).
+
+    Memory from any of these is zero-filled by the OS.  Except for Windows large pages, which
+    are committed when they are allocated, a page is not placed on a NUMA node until something
+    first writes to it.  See ParticlePool::SetMemoryPolicy(...) for why that matters.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+enum ParticleMemoryPolicy
+{
+    PARTICLE_MEMORY_DEFAULT_PAGES = 0,
+    PARTICLE_MEMORY_TRANSPARENT_HUGE_PAGES,
+    PARTICLE_MEMORY_EXPLICIT_HUGE_PAGES,
+};
+
+// allocations should be a multiple of this for huge pages to be possible
+static const size_t PARTICLE_MEMORY_HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+
+const char *ParticleMemoryPolicyName(const ParticleMemoryPolicy policy);
+void *AllocateParticleMemory(const size_t numBytes, const ParticleMemoryPolicy requestedPolicy,
+    ParticleMemoryPolicy *pAppliedPolicy);
+void FreeParticleMemory(void *pMemory, const size_t numBytes);
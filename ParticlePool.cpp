@@ -0,0 +1,300 @@
+#include "ParticlePool.h"
+
+#include <new>  // for placement new
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticlePool::ParticlePool() :
+    _numParticles(0),
+    _requestedPolicy(PARTICLE_MEMORY_DEFAULT_PAGES),
+    _deferFirstTouch(false),
+    _numTouched(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives all the segments back to the OS.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticlePool::~ParticlePool()
+{
+    Resize(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets how segments that are allocated from now on get their memory.  Segments that already 
+    exist are not reallocated.
+
+    If first touch is deferred, then new segments are not written to when they are allocated, 
+    so the OS doesn't place their pages on a NUMA node until something writes to them.  On a 
+    multi-socket machine, the thread that will update a chunk of particles should call 
+    FirstTouch(...) on that chunk before anything else uses it so that the chunk's pages end up 
+    on that thread's node (ParticleUpdater::UpdateParallel(...) does this with the scheduler's 
+    workers).  If first touch is not deferred, then the thread that calls Resize(...) touches 
+    everything, which puts all the pages on its node.
+Parameters:
+    policy          See ParticleMemoryPolicy.
+    deferFirstTouch See description.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticlePool::SetMemoryPolicy(const ParticleMemoryPolicy policy, const bool deferFirstTouch)
+{
+    _requestedPolicy = policy;
+    _deferFirstTouch = deferFirstTouch;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the policy that was asked for.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleMemoryPolicy ParticlePool::RequestedMemoryPolicy() const
+{
+    return _requestedPolicy;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Reports the policy that was actually applied.  If the segments ended up with different 
+    policies (for example, the explicit huge page reserve ran out partway through growing), 
+    then this is the lowest one.
+Parameters: None
+Returns:
+    The lowest policy of all the segments, or the requested policy if there are no segments.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleMemoryPolicy ParticlePool::AppliedMemoryPolicy() const
+{
+    if (_segmentPolicies.empty())
+    {
+        return _requestedPolicy;
+    }
+
+    ParticleMemoryPolicy lowestPolicy = _segmentPolicies[0];
+    for (size_t segmentIndex = 1; segmentIndex < _segmentPolicies.size(); segmentIndex++)
+    {
+        if (_segmentPolicies[segmentIndex] < lowestPolicy)
+        {
+            lowestPolicy = _segmentPolicies[segmentIndex];
+        }
+    }
+    return lowestPolicy;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter.
+Parameters: None
+Returns:
+    True if new segments are left untouched (see SetMemoryPolicy(...)).
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticlePool::DefersFirstTouch() const
+{
+    return _deferFirstTouch;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Constructs a range of particles (all 0s) so that their pages are placed on the NUMA node of 
+    the calling thread.  The segments are raw memory from the OS, so this is also what makes 
+    them particles.  This is for particles that have never been emitted (they are already 0), 
+    so it doesn't change their values, but don't call it on live particles.
+
+    Different threads may touch different ranges at the same time.  Call FinishFirstTouch() 
+    when they're all done.
+Parameters:
+    startIndex      Self-explanatory.
+    numParticles    Clamped to the end of the pool.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticlePool::FirstTouch(const unsigned int startIndex, const unsigned int numParticles)
+{
+    unsigned int endIndex = startIndex + numParticles;
+    if (endIndex > _numParticles)
+    {
+        endIndex = _numParticles;
+    }
+
+    for (unsigned int particleIndex = startIndex; particleIndex < endIndex; particleIndex++)
+    {
+        new (&(*this)[particleIndex]) Particle();
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for where the particles that haven't been through FirstTouch(...) start.
+    Nothing may use the particles from here to Size() until they are touched.
+Parameters: None
+Returns:
+    See description.  Equal to Size() if every particle has been touched.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticlePool::FirstUntouchedIndex() const
+{
+    return _numTouched;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Records that every particle from FirstUntouchedIndex() to Size() has been through 
+    FirstTouch(...).  Call it after all the threads that were touching particles are done.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticlePool::FinishFirstTouch()
+{
+    _numTouched = _numParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates segments at the end until there is room for the requested number of particles,
+    or frees segments at the end that are no longer needed.  The particles in segments that
+    are kept are untouched.  New particles are all 0s, and unless first touch is deferred, they 
+    are constructed here (see SetMemoryPolicy(...) and FirstTouch(...)).
+Parameters:
+    numParticles    The new size.  The last segment may be partially used.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticlePool::Resize(const unsigned int numParticles)
+{
+    unsigned int numSegments = (numParticles + PARTICLES_PER_SEGMENT - 1) / PARTICLES_PER_SEGMENT;
+    unsigned int oldNumSegments = _segments.size();
+    if (numSegments < oldNumSegments)
+    {
+        for (unsigned int segmentIndex = numSegments; segmentIndex < oldNumSegments; segmentIndex++)
+        {
+            FreeParticleMemory(_segments[segmentIndex], SEGMENT_SIZE_BYTES);
+        }
+        _segments.resize(numSegments);
+        _segmentPolicies.resize(numSegments);
+    }
+    else
+    {
+        _segments.reserve(numSegments);
+        _segmentPolicies.reserve(numSegments);
+        for (unsigned int segmentIndex = oldNumSegments; segmentIndex < numSegments; segmentIndex++)
+        {
+            // the OS hands out zero-filled pages, but they aren't particles until FirstTouch(...)
+            ParticleMemoryPolicy appliedPolicy = PARTICLE_MEMORY_DEFAULT_PAGES;
+            void *pMemory = AllocateParticleMemory(SEGMENT_SIZE_BYTES, _requestedPolicy, 
+                &appliedPolicy);
+            _segments.push_back(static_cast<Particle *>(pMemory));
+            _segmentPolicies.push_back(appliedPolicy);
+        }
+    }
+
+    _numParticles = numParticles;
+    if (_numTouched > numParticles)
+    {
+        _numTouched = numParticles;
+    }
+
+    if (!_deferFirstTouch && _numTouched < numParticles)
+    {
+        FirstTouch(_numTouched, numParticles - _numTouched);
+        FinishFirstTouch();
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticlePool::Size() const
+{
+    return _numParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The number of particles that fit in the allocated segments.  This is what the OpenGL
+    buffer is sized to so that it only needs to be reallocated when the number of segments
+    changes.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticlePool::Capacity() const
+{
+    return _segments.size() * PARTICLES_PER_SEGMENT;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of allocated segments.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticlePool::NumSegments() const
+{
+    return _segments.size();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives access to a segment's particles as an array, such as for glBufferSubData(...).
+Parameters:
+    segmentIndex    On the range [0, NumSegments()).
+Returns:
+    A pointer to the segment's first particle.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+Particle *ParticlePool::SegmentData(const unsigned int segmentIndex)
+{
+    return _segments[segmentIndex];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The const version of SegmentData(...).
+Parameters:
+    segmentIndex    On the range [0, NumSegments()).
+Returns:
+    A const pointer to the segment's first particle.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+const Particle *ParticlePool::SegmentData(const unsigned int segmentIndex) const
+{
+    return _segments[segmentIndex];
+}
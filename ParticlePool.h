@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Particle.h"
+#include "ParticleMemory.h"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A growable collection of particles that is stored as a list of fixed-size segments instead
+    of one contiguous array.
+
+    Resizing only allocates or frees whole segments at the end of the list.  Existing segments
+    are never reallocated or moved, so growing does not copy the particles and pointers or
+    references to particles stay valid (unless that particle's segment is freed by shrinking).
+    The list only holds pointers, so when the list itself grows, only the pointers are moved.
+
+    The segment size is a power of 2 so that indexing is a shift and a mask, and it is a
+    multiple of 64 so that a segment never splits a chunk of the ParticleActiveMask.  It is
+    also exactly one 2MB huge page, because the segments are allocated straight from the OS
+    according to a ParticleMemoryPolicy (see SetMemoryPolicy(...)).
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticlePool
+{
+public:
+    // 131072 particles * 16 bytes = 2MB per segment
+    static const unsigned int PARTICLES_PER_SEGMENT_SHIFT = 17;
+    static const unsigned int PARTICLES_PER_SEGMENT = 1 << PARTICLES_PER_SEGMENT_SHIFT;
+    static const unsigned int SEGMENT_SIZE_BYTES = PARTICLES_PER_SEGMENT * sizeof(Particle);
+
+    ParticlePool();
+    ~ParticlePool();
+    ParticlePool(const ParticlePool &) = delete;
+    ParticlePool &operator=(const ParticlePool &) = delete;
+
+    void SetMemoryPolicy(const ParticleMemoryPolicy policy, const bool deferFirstTouch);
+    ParticleMemoryPolicy RequestedMemoryPolicy() const;
+    ParticleMemoryPolicy AppliedMemoryPolicy() const;
+    bool DefersFirstTouch() const;
+    void FirstTouch(const unsigned int startIndex, const unsigned int numParticles);
+    unsigned int FirstUntouchedIndex() const;
+    void FinishFirstTouch();
+
+    void Resize(const unsigned int numParticles);
+    unsigned int Size() const;
+    unsigned int Capacity() const;
+
+    unsigned int NumSegments() const;
+    Particle *SegmentData(const unsigned int segmentIndex);
+    const Particle *SegmentData(const unsigned int segmentIndex) const;
+
+    Particle &operator[](const unsigned int particleIndex);
+    const Particle &operator[](const unsigned int particleIndex) const;
+
+private:
+    unsigned int _numParticles;
+    std::vector<Particle *> _segments;
+
+    // what was asked for when new segments are allocated, and what each segment actually got
+    ParticleMemoryPolicy _requestedPolicy;
+    std::vector<ParticleMemoryPolicy> _segmentPolicies;
+    bool _deferFirstTouch;
+
+    // particles on [0, _numTouched) have been constructed by FirstTouch(...)
+    unsigned int _numTouched;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Finds a particle by its index across all the segments.
+
+    The indexing operators are defined here in the header so that they can be inlined into
+    the particle updater's loops.
+Parameters:
+    particleIndex   Must be less than Size().
+Returns:
+    A reference to the particle.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline Particle &ParticlePool::operator[](const unsigned int particleIndex)
+{
+    return _segments[particleIndex >> PARTICLES_PER_SEGMENT_SHIFT]
+        [particleIndex & (PARTICLES_PER_SEGMENT - 1)];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The const version of the indexing operator.
+Parameters:
+    particleIndex   Must be less than Size().
+Returns:
+    A const reference to the particle.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline const Particle &ParticlePool::operator[](const unsigned int particleIndex) const
+{
+    return _segments[particleIndex >> PARTICLES_PER_SEGMENT_SHIFT]
+        [particleIndex & (PARTICLES_PER_SEGMENT - 1)];
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Particle.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A run of particle positions for IParticleRegion::OutOfBoundsBatch(...).  It doesn't own
+    anything.  It can describe both "structure of arrays" storage, where the X and Y arrays are
+    contiguous (stride 1), and "array of structures" storage, where the X and Y are members of
+    each Particle (stride = sizeof(Particle) / sizeof(float)).
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticlePositionSpan
+{
+    const float *_positionX;
+    const float *_positionY;
+    unsigned int _strideFloats;     // distance from one particle's X to the next particle's X
+    unsigned int _count;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes a span over a run of Particle structures.
+Parameters:
+    pParticles  The first particle in the run.
+    count       Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline ParticlePositionSpan MakePositionSpan(const Particle *pParticles, const unsigned int count)
+{
+    ParticlePositionSpan span;
+    span._positionX = &pParticles->_position.x;
+    span._positionY = &pParticles->_position.y;
+    span._strideFloats = sizeof(Particle) / sizeof(float);
+    span._count = count;
+    return span;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes a span over separate X and Y arrays.
+Parameters:
+    positionX   The first particle's X.
+    positionY   The first particle's Y.
+    count       Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline ParticlePositionSpan MakePositionSpan(const float *positionX, const float *positionY,
+    const unsigned int count)
+{
+    ParticlePositionSpan span;
+    span._positionX = positionX;
+    span._positionY = positionY;
+    span._strideFloats = 1;
+    span._count = count;
+    return span;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Copies up to 64 positions, starting at "firstIndex", into contiguous X and Y arrays.  The
+    region kernels (see ParticleKernels) only take contiguous arrays, so regions use this to
+    feed them strided spans one 64-particle word at a time.
+Parameters:
+    span        Self-explanatory.
+    firstIndex  Should be a multiple of 64 so that the word lines up with the span's bits.
+    positionX   Must fit 64 floats.
+    positionY   Same.
+Returns:
+    The number of positions copied.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+inline unsigned int GatherPositions(const ParticlePositionSpan &span, const unsigned int firstIndex,
+    float *positionX, float *positionY)
+{
+    unsigned int count = span._count - firstIndex;
+    if (count > 64)
+    {
+        count = 64;
+    }
+
+    const float *sourceX = span._positionX + (firstIndex * span._strideFloats);
+    const float *sourceY = span._positionY + (firstIndex * span._strideFloats);
+    for (unsigned int index = 0; index < count; index++)
+    {
+        positionX[index] = sourceX[index * span._strideFloats];
+        positionY[index] = sourceY[index * span._strideFloats];
+    }
+    return count;
+}
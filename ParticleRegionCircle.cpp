@@ -1,6 +1,10 @@
 #include "ParticleRegionCircle.h"
 
-#include "glm/detail/func_geometric.hpp"    // glm::dot
+#include "ParticleFixedPoint.h"
+#include "ParticleKernels.h"
+
+#include <float.h>     // for FLT_MAX
+#include <math.h>      // for sqrtf(...)
 
 /*-----------------------------------------------------------------------------------------------
 Description:
@@ -19,30 +23,76 @@ ParticleRegionCircle::ParticleRegionCircle(const glm::vec2 &center, const float
     _currentCenter = _originalCenter;
 
     _radiusSqr = radius * radius;
+
+    float radiusFixed = radius * FIXED_POINT_POSITION_ONE;
+    _radiusSqrFixed = (long long)(radiusFixed * radiusFixed);
+    UpdateFixedPoint();
 }
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Checks if the provided particle has gone outside the circle.
+    The batch version of OutOfBounds(...).  Contiguous spans go straight to this CPU's circle 
+    kernel (see ParticleKernels).  Strided spans are gathered into contiguous arrays one 
+    64-particle word at a time first.
 Parameters:
-    p   A const reference to a Particle object.
+    positions       Self-explanatory.
+    outOfBoundsBits Must fit (positions._count + 63) / 64 words.  Every one is overwritten.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionCircle::OutOfBoundsBatch(const ParticlePositionSpan &positions, 
+    unsigned long long *outOfBoundsBits) const
+{
+    const ParticleKernels &kernels = GetParticleKernels();
+    if (positions._strideFloats == 1)
+    {
+        kernels._outOfBoundsCircle(positions._positionX, positions._positionY, positions._count, 
+            _currentCenter, _radiusSqr, outOfBoundsBits);
+        return;
+    }
+
+    float gatheredX[64];
+    float gatheredY[64];
+    for (unsigned int firstIndex = 0; firstIndex < positions._count; firstIndex += 64)
+    {
+        unsigned int numGathered = GatherPositions(positions, firstIndex, gatheredX, gatheredY);
+        kernels._outOfBoundsCircle(gatheredX, gatheredY, numGathered, _currentCenter, 
+            _radiusSqr, &outOfBoundsBits[firstIndex / 64]);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calculates how long a particle at the provided position, moving at the provided velocity, 
+    has until it goes outside the circle.  That is the larger root of 
+    |position + (velocity * t) - center|^2 = radius^2.
+Parameters:
+    position    A particle's position in window space.
+    velocity    The particle's velocity in window space per second.
 Returns:    
-    True if the particle's position is outside the circle's boundaries, otherwise false.
+    The time in seconds.  0 if the particle is already outside.  FLT_MAX if it isn't moving.
 Exception:  Safe
-Creator:    John Cox (7-2-2016)
+Creator:    agent (10-17-2026)
 -----------------------------------------------------------------------------------------------*/
-bool ParticleRegionCircle::OutOfBounds(const Particle &p) const
+float ParticleRegionCircle::ExitTime(const glm::vec2 &position, const glm::vec2 &velocity) const
 {
-    glm::vec2 centerToParticle = p._position - _currentCenter;
-    float distSqr = glm::dot(centerToParticle, centerToParticle);
-    if (distSqr > _radiusSqr)
+    glm::vec2 centerToParticle = position - _currentCenter;
+    float c = glm::dot(centerToParticle, centerToParticle) - _radiusSqr;
+    if (c > 0.0f)
     {
-        return true;
+        return 0.0f;
     }
-    else
+
+    float a = glm::dot(velocity, velocity);
+    if (a == 0.0f)
     {
-        return false;
+        return FLT_MAX;
     }
+
+    // the particle is inside, so c <= 0 and the discriminant can't be negative
+    float halfB = glm::dot(centerToParticle, velocity);
+    return (-halfB + sqrtf((halfB * halfB) - (a * c))) / a;
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -57,4 +107,40 @@ Creator:    John Cox (8-26-2016)
 void ParticleRegionCircle::SetTransform(const glm::mat4 &m)
 {
     _currentCenter = glm::vec2(m * glm::vec4(_originalCenter, 0.0f, 1.0f));
+    UpdateFixedPoint();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The integer version of OutOfBounds(...).
+Parameters:
+    positionX   A particle's X position in ParticleFixedPoint units.
+    positionY   Same for Y.
+Returns:    
+    True if the particle's position is outside the circle's boundaries, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleRegionCircle::OutOfBoundsFixedPoint(const int positionX, const int positionY) const
+{
+    long long centerToParticleX = positionX - _currentCenterFixedX;
+    long long centerToParticleY = positionY - _currentCenterFixedY;
+    long long distSqr = (centerToParticleX * centerToParticleX) + 
+        (centerToParticleY * centerToParticleY);
+    return distSqr > _radiusSqrFixed;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Converts the current center to ParticleFixedPoint units.  Called whenever the center 
+    changes.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionCircle::UpdateFixedPoint()
+{
+    _currentCenterFixedX = ToFixedPoint(_currentCenter.x, FIXED_POINT_POSITION_ONE);
+    _currentCenterFixedY = ToFixedPoint(_currentCenter.y, FIXED_POINT_POSITION_ONE);
 }
@@ -1,7 +1,11 @@
 #include "ParticleRegionPolygon.h"
 
+#include "ParticleFixedPoint.h"
+
 #include "glm/detail/func_geometric.hpp"    // for dot and normalize
 
+#include <float.h>     // for FLT_MAX
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Encapsulates the rotating of a 2D vector by -90 degrees (+90 degrees not used in this demo).
@@ -84,30 +88,88 @@ ParticleRegionPolygon::ParticleRegionPolygon(const std::vector<glm::vec2> &corne
         _originalFaceNormals[cornerIndex] = faceNormal;
         _currentFaceNormals[cornerIndex] = faceNormal;
     }
+
+    _currentBounds = CalculatePolygonBounds(_currentFaceCenterPoints, _currentFaceNormals, 
+        _numFaces);
+    UpdateFixedPointFaces();
 }
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Checks if the provided particle has gone outside of the polygonal boundaries.
+    The batch version of OutOfBounds(...).  Contiguous spans go straight to this CPU's 
+    half-plane kernel (see ParticleKernels).  If there are enough faces for it to pay off, 
+    that is the bounded kernel, which only tests the faces for particles between the polygon's 
+    inner and outer circles.  Strided spans are gathered into contiguous arrays one 
+    64-particle word at a time first.
 Parameters:
-    p   A const reference to a particle object.
-Returns:
-    True if the particle has outside of the region's boundaries, otherwise false.
+    positions       Self-explanatory.
+    outOfBoundsBits Must fit (positions._count + 63) / 64 words.  Every one is overwritten.
+Returns:    None
 Exception:  Safe
-Creator:    John Cox (7-2-2016)
+Creator:    agent (10-17-2026)
 -----------------------------------------------------------------------------------------------*/
-bool ParticleRegionPolygon::OutOfBounds(const Particle &p) const
+void ParticleRegionPolygon::OutOfBoundsBatch(const ParticlePositionSpan &positions, 
+    unsigned long long *outOfBoundsBits) const
 {
-    bool outsidePolygon = false;
+    const ParticleKernels &kernels = GetParticleKernels();
+    if (positions._strideFloats == 1)
+    {
+        OutOfBoundsConvexPolygon(kernels, positions._positionX, positions._positionY, 
+            positions._count, _currentFaceCenterPoints, _currentFaceNormals, _numFaces, 
+            _currentBounds, outOfBoundsBits);
+        return;
+    }
+
+    float gatheredX[64];
+    float gatheredY[64];
+    for (unsigned int firstIndex = 0; firstIndex < positions._count; firstIndex += 64)
+    {
+        unsigned int numGathered = GatherPositions(positions, firstIndex, gatheredX, gatheredY);
+        OutOfBoundsConvexPolygon(kernels, gatheredX, gatheredY, numGathered, 
+            _currentFaceCenterPoints, _currentFaceNormals, _numFaces, _currentBounds,
+            &outOfBoundsBits[firstIndex / 64]);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calculates how long a particle at the provided position, moving at the provided velocity, 
+    has until it goes outside the polygon.  The polygon is convex, so that is the soonest time 
+    that the particle crosses any face that it is moving toward.
+Parameters:
+    position    A particle's position in window space.
+    velocity    The particle's velocity in window space per second.
+Returns:    
+    The time in seconds.  0 if the particle is already outside.  FLT_MAX if it isn't moving.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+float ParticleRegionPolygon::ExitTime(const glm::vec2 &position, const glm::vec2 &velocity) const
+{
+    float exitTimeSec = FLT_MAX;
     for (size_t faceIndex = 0; faceIndex < _numFaces; faceIndex++)
     {
-        // if any of these checks are true, then this flag will be true as well
-        glm::vec2 v1 = p._position - _currentFaceCenterPoints[faceIndex];
-        glm::vec2 v2 = _currentFaceNormals[faceIndex];
-        outsidePolygon |= (glm::dot(v1, v2) > 0);
+        // the distance in front of the face and the speed toward it, both scaled by the 
+        // normal's length, which cancels out
+        float inFront = glm::dot(position - _currentFaceCenterPoints[faceIndex], 
+            _currentFaceNormals[faceIndex]);
+        if (inFront > 0.0f)
+        {
+            return 0.0f;
+        }
+
+        float towardFace = glm::dot(velocity, _currentFaceNormals[faceIndex]);
+        if (towardFace > 0.0f)
+        {
+            float faceTimeSec = -inFront / towardFace;
+            if (faceTimeSec < exitTimeSec)
+            {
+                exitTimeSec = faceTimeSec;
+            }
+        }
     }
 
-    return outsidePolygon;
+    return exitTimeSec;
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -140,4 +202,59 @@ void ParticleRegionPolygon::SetTransform(const glm::mat4 &m)
 
         // do NOT transform the normals, which must always be relative to the surface
     }
-}
\ No newline at end of file
+
+    _currentBounds = CalculatePolygonBounds(_currentFaceCenterPoints, _currentFaceNormals, 
+        _numFaces);
+    UpdateFixedPointFaces();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The integer version of OutOfBounds(...).
+Parameters:
+    positionX   A particle's X position in ParticleFixedPoint units.
+    positionY   Same for Y.
+Returns:
+    True if the particle has outside of the region's boundaries, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleRegionPolygon::OutOfBoundsFixedPoint(const int positionX, const int positionY) const
+{
+    bool outsidePolygon = false;
+    for (size_t faceIndex = 0; faceIndex < _numFaces; faceIndex++)
+    {
+        // Note: The positions and centers are shorts and the normals have a length of 16384, 
+        // so |dot| <= 65535 * 16384 * sqrt(2), which is about 1.52e9 and fits in an int.
+        int v1X = positionX - _currentFaceCenterFixedX[faceIndex];
+        int v1Y = positionY - _currentFaceCenterFixedY[faceIndex];
+        int dot = (v1X * _currentFaceNormalFixedX[faceIndex]) + 
+            (v1Y * _currentFaceNormalFixedY[faceIndex]);
+        outsidePolygon |= (dot > 0);
+    }
+
+    return outsidePolygon;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Converts the current face center points and normals to ParticleFixedPoint units.  Called 
+    whenever the faces change.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygon::UpdateFixedPointFaces()
+{
+    for (size_t faceIndex = 0; faceIndex < _numFaces; faceIndex++)
+    {
+        glm::vec2 center = _currentFaceCenterPoints[faceIndex];
+        _currentFaceCenterFixedX[faceIndex] = ToFixedPoint(center.x, FIXED_POINT_POSITION_ONE);
+        _currentFaceCenterFixedY[faceIndex] = ToFixedPoint(center.y, FIXED_POINT_POSITION_ONE);
+
+        glm::vec2 normal = glm::normalize(_currentFaceNormals[faceIndex]);
+        _currentFaceNormalFixedX[faceIndex] = (int)(normal.x * 16384.0f);
+        _currentFaceNormalFixedY[faceIndex] = (int)(normal.y * 16384.0f);
+    }
+}
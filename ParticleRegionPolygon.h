@@ -1,8 +1,9 @@
 #pragma once
 
 #include "IParticleRegion.h"
+#include "ParticleKernels.h"
 #include "glm/vec2.hpp"
-#include "Particle.h"
+#include "glm/detail/func_geometric.hpp"    // glm::dot
 #include <vector>
 
 
@@ -13,13 +14,21 @@ const unsigned int MAX_POLYGON_FACES = 10;
 Description:
     This object defines a polygonal region within which particles are considered active and the
     logic to determine when a particle goes outside of its boundaries.
+
+    Like ParticleRegionCircle, it is "final" and OutOfBounds(...) is defined in this header so 
+    that it can be inlined.  ParticleRegionPolygonFixed<...> is the same thing with the number 
+    of faces fixed at compile time.
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
-class ParticleRegionPolygon : public IParticleRegion
+class ParticleRegionPolygon final : public IParticleRegion
 {
 public:
     ParticleRegionPolygon(const std::vector<glm::vec2> &corners);
-    virtual bool OutOfBounds(const Particle &p) const;
+    virtual bool OutOfBounds(const glm::vec2 &position) const;
+    virtual bool OutOfBoundsFixedPoint(const int positionX, const int positionY) const;
+    virtual void OutOfBoundsBatch(const ParticlePositionSpan &positions, 
+        unsigned long long *outOfBoundsBits) const;
+    virtual float ExitTime(const glm::vec2 &position, const glm::vec2 &velocity) const;
     virtual void SetTransform(const glm::mat4 &m);
 
 private:
@@ -35,4 +44,41 @@ private:
     glm::vec2 _originalFaceNormals[MAX_POLYGON_FACES];
     glm::vec2 _currentFaceCenterPoints[MAX_POLYGON_FACES];
     glm::vec2 _currentFaceNormals[MAX_POLYGON_FACES];
-};
\ No newline at end of file
+
+    // lets OutOfBoundsBatch(...) skip the faces for most particles; updated with the faces
+    ParticlePolygonBounds _currentBounds;
+
+    // the current faces in ParticleFixedPoint units
+    // Note: Only the sign of the dot product matters, so the normals are scaled to a length of 
+    // 16384 instead of 1.  That keeps the dot product of a 17-bit offset and a normal inside an 
+    // int (at most about 1.52e9; see OutOfBoundsFixedPoint(...)).
+    void UpdateFixedPointFaces();
+    int _currentFaceCenterFixedX[MAX_POLYGON_FACES];
+    int _currentFaceCenterFixedY[MAX_POLYGON_FACES];
+    int _currentFaceNormalFixedX[MAX_POLYGON_FACES];
+    int _currentFaceNormalFixedY[MAX_POLYGON_FACES];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks if the provided particle position has gone outside of the polygonal boundaries.
+Parameters:
+    position    A particle's position in window space.
+Returns:
+    True if the particle has outside of the region's boundaries, otherwise false.
+Exception:  Safe
+Creator:    John Cox (7-2-2016)
+-----------------------------------------------------------------------------------------------*/
+inline bool ParticleRegionPolygon::OutOfBounds(const glm::vec2 &position) const
+{
+    bool outsidePolygon = false;
+    for (size_t faceIndex = 0; faceIndex < _numFaces; faceIndex++)
+    {
+        // if any of these checks are true, then this flag will be true as well
+        glm::vec2 v1 = position - _currentFaceCenterPoints[faceIndex];
+        glm::vec2 v2 = _currentFaceNormals[faceIndex];
+        outsidePolygon |= (glm::dot(v1, v2) > 0);
+    }
+
+    return outsidePolygon;
+}
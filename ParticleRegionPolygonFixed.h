@@ -0,0 +1,264 @@
+#pragma once
+
+#include "IParticleRegion.h"
+#include "ParticleFixedPoint.h"
+#include "ParticleKernels.h"
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+#include "glm/detail/func_geometric.hpp"    // for dot and normalize
+#include <float.h>     // for FLT_MAX
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The same region as ParticleRegionPolygon, but the number of faces is a template argument
+    instead of a member.  The face loop in OutOfBounds(...) then has a constant trip count, so
+    the compiler unrolls it and keeps the faces in registers, and there is no loop at all
+    once it is inlined into a caller that knows the region's type (see ParticleUpdaterT).
+
+    Use this for scenes whose polygon is known when the program is written.  The corners are
+    taken as an array (instead of a std::vector) so that the wrong number of corners is a
+    compile error.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+class ParticleRegionPolygonFixed final : public IParticleRegion
+{
+public:
+    ParticleRegionPolygonFixed(const glm::vec2 (&corners)[NUM_FACES]);
+    virtual bool OutOfBounds(const glm::vec2 &position) const;
+    virtual bool OutOfBoundsFixedPoint(const int positionX, const int positionY) const;
+    virtual void OutOfBoundsBatch(const ParticlePositionSpan &positions,
+        unsigned long long *outOfBoundsBits) const;
+    virtual float ExitTime(const glm::vec2 &position, const glm::vec2 &velocity) const;
+    virtual void SetTransform(const glm::mat4 &m);
+
+private:
+    void UpdateFixedPointFaces();
+
+    // see ParticleRegionPolygon for what these are
+    glm::vec2 _originalFaceCenterPoints[NUM_FACES];
+    glm::vec2 _originalFaceNormals[NUM_FACES];
+    glm::vec2 _currentFaceCenterPoints[NUM_FACES];
+    glm::vec2 _currentFaceNormals[NUM_FACES];
+    int _currentFaceCenterFixedX[NUM_FACES];
+    int _currentFaceCenterFixedY[NUM_FACES];
+    int _currentFaceNormalFixedX[NUM_FACES];
+    int _currentFaceNormalFixedY[NUM_FACES];
+    ParticlePolygonBounds _currentBounds;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calculates the face centers and outward normals the same way that ParticleRegionPolygon
+    does.
+Parameters:
+    corners     A counterclockwise array of 2D points in window space (XY on range[-1,+1]).
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+ParticleRegionPolygonFixed<NUM_FACES>::ParticleRegionPolygonFixed(
+    const glm::vec2 (&corners)[NUM_FACES])
+{
+    static_assert(NUM_FACES >= 3, "a polygon needs at least 3 faces");
+
+    for (unsigned int cornerIndex = 0; cornerIndex < NUM_FACES; cornerIndex++)
+    {
+        glm::vec2 corner1 = corners[cornerIndex];
+        glm::vec2 corner2 = corners[(cornerIndex + 1) % NUM_FACES];
+
+        // counterclockwise corners, so rotate each corner->corner vector -90 degrees to get an
+        // outward normal
+        glm::vec2 cornerToCorner = corner2 - corner1;
+        _originalFaceCenterPoints[cornerIndex] = (corner1 + corner2) * 0.5f;
+        _originalFaceNormals[cornerIndex] = glm::vec2(cornerToCorner.y, -(cornerToCorner.x));
+        _currentFaceCenterPoints[cornerIndex] = _originalFaceCenterPoints[cornerIndex];
+        _currentFaceNormals[cornerIndex] = _originalFaceNormals[cornerIndex];
+    }
+
+    _currentBounds = CalculatePolygonBounds(_currentFaceCenterPoints, _currentFaceNormals,
+        NUM_FACES);
+    UpdateFixedPointFaces();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks if the provided particle position has gone outside of the polygonal boundaries.
+    Same math as ParticleRegionPolygon::OutOfBounds(...), so the two always agree.
+Parameters:
+    position    A particle's position in window space.
+Returns:
+    True if the particle has outside of the region's boundaries, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+inline bool ParticleRegionPolygonFixed<NUM_FACES>::OutOfBounds(const glm::vec2 &position) const
+{
+    bool outsidePolygon = false;
+    for (unsigned int faceIndex = 0; faceIndex < NUM_FACES; faceIndex++)
+    {
+        glm::vec2 v1 = position - _currentFaceCenterPoints[faceIndex];
+        glm::vec2 v2 = _currentFaceNormals[faceIndex];
+        outsidePolygon |= (glm::dot(v1, v2) > 0);
+    }
+
+    return outsidePolygon;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The integer version of OutOfBounds(...).
+Parameters:
+    positionX   A particle's X position in ParticleFixedPoint units.
+    positionY   Same for Y.
+Returns:
+    True if the particle has outside of the region's boundaries, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+bool ParticleRegionPolygonFixed<NUM_FACES>::OutOfBoundsFixedPoint(const int positionX,
+    const int positionY) const
+{
+    bool outsidePolygon = false;
+    for (unsigned int faceIndex = 0; faceIndex < NUM_FACES; faceIndex++)
+    {
+        int v1X = positionX - _currentFaceCenterFixedX[faceIndex];
+        int v1Y = positionY - _currentFaceCenterFixedY[faceIndex];
+        int dot = (v1X * _currentFaceNormalFixedX[faceIndex]) +
+            (v1Y * _currentFaceNormalFixedY[faceIndex]);
+        outsidePolygon |= (dot > 0);
+    }
+
+    return outsidePolygon;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The batch version of OutOfBounds(...).  Goes to the same half-plane kernels as
+    ParticleRegionPolygon::OutOfBoundsBatch(...).
+
+    Note: A version of this with the face loop unrolled in the header (like OutOfBounds(...))
+    was tried, but the compiler can only vectorize it for the instruction set that the program 
+    is built for, and the kernel for this CPU was faster.
+Parameters:
+    positions       Self-explanatory.
+    outOfBoundsBits Must fit (positions._count + 63) / 64 words.  Every one is overwritten.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+void ParticleRegionPolygonFixed<NUM_FACES>::OutOfBoundsBatch(
+    const ParticlePositionSpan &positions, unsigned long long *outOfBoundsBits) const
+{
+    const ParticleKernels &kernels = GetParticleKernels();
+    if (positions._strideFloats == 1)
+    {
+        OutOfBoundsConvexPolygon(kernels, positions._positionX, positions._positionY,
+            positions._count, _currentFaceCenterPoints, _currentFaceNormals, NUM_FACES,
+            _currentBounds, outOfBoundsBits);
+        return;
+    }
+
+    float gatheredX[64];
+    float gatheredY[64];
+    for (unsigned int firstIndex = 0; firstIndex < positions._count; firstIndex += 64)
+    {
+        unsigned int numGathered = GatherPositions(positions, firstIndex, gatheredX, gatheredY);
+        OutOfBoundsConvexPolygon(kernels, gatheredX, gatheredY, numGathered,
+            _currentFaceCenterPoints, _currentFaceNormals, NUM_FACES, _currentBounds,
+            &outOfBoundsBits[firstIndex / 64]);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as ParticleRegionPolygon::ExitTime(...).
+Parameters:
+    position    A particle's position in window space.
+    velocity    The particle's velocity in window space per second.
+Returns:
+    The time in seconds.  0 if the particle is already outside.  FLT_MAX if it isn't moving.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+float ParticleRegionPolygonFixed<NUM_FACES>::ExitTime(const glm::vec2 &position,
+    const glm::vec2 &velocity) const
+{
+    float exitTimeSec = FLT_MAX;
+    for (unsigned int faceIndex = 0; faceIndex < NUM_FACES; faceIndex++)
+    {
+        float inFront = glm::dot(position - _currentFaceCenterPoints[faceIndex],
+            _currentFaceNormals[faceIndex]);
+        if (inFront > 0.0f)
+        {
+            return 0.0f;
+        }
+
+        float towardFace = glm::dot(velocity, _currentFaceNormals[faceIndex]);
+        if (towardFace > 0.0f)
+        {
+            float faceTimeSec = -inFront / towardFace;
+            if (faceTimeSec < exitTimeSec)
+            {
+                exitTimeSec = faceTimeSec;
+            }
+        }
+    }
+
+    return exitTimeSec;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Applies the transform to each face center point and face normal.  Center points are rotated
+    and translated, while normals are only rotated.
+Parameters:
+    m       A 4x4 transform matrix.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+void ParticleRegionPolygonFixed<NUM_FACES>::SetTransform(const glm::mat4 &m)
+{
+    for (unsigned int faceIndex = 0; faceIndex < NUM_FACES; faceIndex++)
+    {
+        _currentFaceCenterPoints[faceIndex] =
+            glm::vec2(m * glm::vec4(_originalFaceCenterPoints[faceIndex], 0.0f, 1.0f));
+        _currentFaceNormals[faceIndex] =
+            glm::vec2(m * glm::vec4(_originalFaceNormals[faceIndex], 0.0f, 0.0f));
+    }
+
+    _currentBounds = CalculatePolygonBounds(_currentFaceCenterPoints, _currentFaceNormals,
+        NUM_FACES);
+    UpdateFixedPointFaces();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Converts the current face center points and normals to ParticleFixedPoint units (see
+    ParticleRegionPolygon::UpdateFixedPointFaces()).
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int NUM_FACES>
+void ParticleRegionPolygonFixed<NUM_FACES>::UpdateFixedPointFaces()
+{
+    for (unsigned int faceIndex = 0; faceIndex < NUM_FACES; faceIndex++)
+    {
+        glm::vec2 center = _currentFaceCenterPoints[faceIndex];
+        _currentFaceCenterFixedX[faceIndex] = ToFixedPoint(center.x, FIXED_POINT_POSITION_ONE);
+        _currentFaceCenterFixedY[faceIndex] = ToFixedPoint(center.y, FIXED_POINT_POSITION_ONE);
+
+        glm::vec2 normal = glm::normalize(_currentFaceNormals[faceIndex]);
+        _currentFaceNormalFixedX[faceIndex] = (int)(normal.x * 16384.0f);
+        _currentFaceNormalFixedY[faceIndex] = (int)(normal.y * 16384.0f);
+    }
+}
@@ -0,0 +1,633 @@
+#include "ParticleRegionPolygonGrid.h"
+
+#include "ParticleFixedPoint.h"
+
+#include <algorithm>    // for std::sort
+#include <float.h>      // for FLT_MAX
+#include <math.h>       // for sqrtf(...), ceilf(...), and floorf(...)
+
+// the grid has about this many cells per edge, so an average boundary cell has only a few
+// edges in it
+static const float GRID_CELLS_PER_EDGE = 4.0f;
+static const unsigned int GRID_MIN_CELLS_PER_SIDE = 4;
+static const unsigned int GRID_MAX_CELLS_PER_SIDE = 1024;
+
+// cell states; a boundary cell also says whether its reference point is inside
+static const unsigned char CELL_OUTSIDE = 0;
+static const unsigned char CELL_INSIDE = 1;
+static const unsigned char CELL_BOUNDARY_REFERENCE_OUTSIDE = 2;
+static const unsigned char CELL_BOUNDARY_REFERENCE_INSIDE = 3;
+
+// where in a cell (as a fraction of its size) the reference point is
+// Note: Not the exact center, so that walls traced on a regular spacing don't run right
+// through it.
+static const float REFERENCE_POINT_FRACTION_X = 0.5f + 0.0123f;
+static const float REFERENCE_POINT_FRACTION_Y = 0.5f - 0.0071f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The 2D cross product (the Z of the 3D one).  Positive if "b" is counterclockwise from "a".
+Parameters:
+    a   Self-explanatory.
+    b   Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline float Cross(const glm::vec2 &a, const glm::vec2 &b)
+{
+    return (a.x * b.y) - (a.y * b.x);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks whether segment p-q crosses segment a-b.  An endpoint that is exactly on the other
+    segment's line counts as being on its negative side, so when p-q passes through a corner
+    that two edges share, the two edges count as one crossing if the polygon's boundary goes
+    across p-q there and as zero or two if it only touches it.
+Parameters:
+    p   One end of the first segment.
+    q   The other end.
+    a   One end of the second segment.
+    b   The other end.
+Returns:
+    True if they cross, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline bool SegmentsCross(const glm::vec2 &p, const glm::vec2 &q, const glm::vec2 &a,
+    const glm::vec2 &b)
+{
+    glm::vec2 pq = q - p;
+    if ((Cross(pq, a - p) > 0.0f) == (Cross(pq, b - p) > 0.0f))
+    {
+        return false;
+    }
+
+    glm::vec2 ab = b - a;
+    return (Cross(ab, p - a) > 0.0f) != (Cross(ab, q - a) > 0.0f);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks whether a segment touches an axis-aligned box.  Only used while building the grid,
+    where the box is padded a little so that edges that graze a cell are counted in it.
+Parameters:
+    a       One end of the segment.
+    b       The other end.
+    boxMin  The box's lower-left corner.
+    boxMax  The box's upper-right corner.
+Returns:
+    True if they touch, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static bool SegmentTouchesBox(const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &boxMin,
+    const glm::vec2 &boxMax)
+{
+    // the segment's bounding box must overlap the box...
+    if (std::max(a.x, b.x) < boxMin.x || std::min(a.x, b.x) > boxMax.x ||
+        std::max(a.y, b.y) < boxMin.y || std::min(a.y, b.y) > boxMax.y)
+    {
+        return false;
+    }
+
+    // ...and the box's corners must not all be on one side of the segment's line
+    glm::vec2 ab = b - a;
+    float side1 = Cross(ab, glm::vec2(boxMin.x, boxMin.y) - a);
+    float side2 = Cross(ab, glm::vec2(boxMax.x, boxMin.y) - a);
+    float side3 = Cross(ab, glm::vec2(boxMax.x, boxMax.y) - a);
+    float side4 = Cross(ab, glm::vec2(boxMin.x, boxMax.y) - a);
+    bool allAbove = side1 > 0.0f && side2 > 0.0f && side3 > 0.0f && side4 > 0.0f;
+    bool allBelow = side1 < 0.0f && side2 < 0.0f && side3 < 0.0f && side4 < 0.0f;
+    return !allAbove && !allBelow;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Finds the time at which a ray hits a segment.
+Parameters:
+    position    The ray's start.
+    velocity    The ray's direction, per second.
+    a           One end of the segment.
+    b           The other end.
+Returns:
+    The time in seconds, or FLT_MAX if the ray misses or is parallel to the segment.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static float RayHitTime(const glm::vec2 &position, const glm::vec2 &velocity,
+    const glm::vec2 &a, const glm::vec2 &b)
+{
+    glm::vec2 ab = b - a;
+    float denominator = Cross(velocity, ab);
+    if (denominator == 0.0f)
+    {
+        return FLT_MAX;
+    }
+
+    glm::vec2 toA = a - position;
+    float timeSec = Cross(toA, ab) / denominator;
+    float alongSegment = Cross(toA, velocity) / denominator;
+    if (timeSec < 0.0f || alongSegment < 0.0f || alongSegment > 1.0f)
+    {
+        return FLT_MAX;
+    }
+    return timeSec;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Copies the corners and builds the grid.  The transform starts as the identity.
+Parameters:
+    corners     A closed loop of 2D points in window space (XY on range[-1,+1]), clockwise or
+                counterclockwise.  The edges must not cross each other.  There is no limit on
+                the number.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleRegionPolygonGrid::ParticleRegionPolygonGrid(const std::vector<glm::vec2> &corners) :
+    _corners(corners),
+    _numCellsX(0),
+    _numCellsY(0),
+    _numBoundaryCells(0),
+    _inverseRow0(1.0f, 0.0f),
+    _inverseRow1(0.0f, 1.0f),
+    _translation(0.0f, 0.0f)
+{
+    BuildGrid();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks if the provided particle position is outside of the polygon.
+Parameters:
+    position    A particle's position in window space.
+Returns:
+    True if the particle is outside of the region's boundaries, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleRegionPolygonGrid::OutOfBounds(const glm::vec2 &position) const
+{
+    return OutOfBoundsLocal(ToLocal(position));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The integer version of OutOfBounds(...).
+
+    Unlike the other regions, this converts to float and does the float check.  A fixed-point
+    copy of the grid and of every edge would be a lot of memory for a check that, in an
+    inside or outside cell, is only one lookup anyway.
+Parameters:
+    positionX   A particle's X position in ParticleFixedPoint units.
+    positionY   Same for Y.
+Returns:
+    True if the particle is outside of the region's boundaries, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleRegionPolygonGrid::OutOfBoundsFixedPoint(const int positionX,
+    const int positionY) const
+{
+    glm::vec2 position(positionX / FIXED_POINT_POSITION_ONE,
+        positionY / FIXED_POINT_POSITION_ONE);
+    return OutOfBoundsLocal(ToLocal(position));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The batch version of OutOfBounds(...).  There is no kernel for this region because each
+    particle looks up its own cell, so this is a plain loop (but still one virtual call per
+    batch).
+Parameters:
+    positions       Self-explanatory.
+    outOfBoundsBits Must fit (positions._count + 63) / 64 words.  Every one is overwritten.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygonGrid::OutOfBoundsBatch(const ParticlePositionSpan &positions,
+    unsigned long long *outOfBoundsBits) const
+{
+    unsigned int numWords = (positions._count + 63) / 64;
+    for (unsigned int wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        unsigned int wordStart = wordIndex * 64;
+        unsigned int numInWord = positions._count - wordStart;
+        numInWord = (numInWord < 64) ? numInWord : 64;
+
+        unsigned long long bits = 0;
+        for (unsigned int bitIndex = 0; bitIndex < numInWord; bitIndex++)
+        {
+            unsigned int floatIndex = (wordStart + bitIndex) * positions._strideFloats;
+            glm::vec2 position(positions._positionX[floatIndex], positions._positionY[floatIndex]);
+            bits |= (unsigned long long)OutOfBoundsLocal(ToLocal(position)) << bitIndex;
+        }
+        outOfBoundsBits[wordIndex] = bits;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calculates how long a particle at the provided position, moving at the provided velocity,
+    has until it goes outside the polygon.  The polygon may be concave, so this is the first
+    edge that the particle's path hits.
+
+    The path is walked through the grid one cell at a time (the usual 2D DDA), and only the
+    boundary cells' edges are tested.  It stops at the first cell that contains a hit.
+
+    A transform doesn't change when the particle crosses an edge, so this is done in the
+    polygon's space.
+Parameters:
+    position    A particle's position in window space.
+    velocity    The particle's velocity in window space per second.
+Returns:
+    The time in seconds.  0 if the particle is already outside.  FLT_MAX if it isn't moving.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+float ParticleRegionPolygonGrid::ExitTime(const glm::vec2 &position,
+    const glm::vec2 &velocity) const
+{
+    glm::vec2 localPosition = ToLocal(position);
+    if (OutOfBoundsLocal(localPosition))
+    {
+        return 0.0f;
+    }
+
+    // velocity is a direction, so it doesn't get the translation
+    glm::vec2 localVelocity(
+        (_inverseRow0.x * velocity.x) + (_inverseRow0.y * velocity.y),
+        (_inverseRow1.x * velocity.x) + (_inverseRow1.y * velocity.y));
+    if (localVelocity.x == 0.0f && localVelocity.y == 0.0f)
+    {
+        return FLT_MAX;
+    }
+
+    // inside the polygon, so inside the grid
+    glm::vec2 gridPosition = (localPosition - _gridMin) * _inverseCellSize;
+    int cellX = (int)gridPosition.x;
+    int cellY = (int)gridPosition.y;
+    cellX = (cellX < (int)_numCellsX) ? cellX : (int)_numCellsX - 1;
+    cellY = (cellY < (int)_numCellsY) ? cellY : (int)_numCellsY - 1;
+
+    // the times at which the path crosses the next vertical and horizontal cell borders, and
+    // the time that it takes to cross a whole cell in each direction
+    int stepX = (localVelocity.x > 0.0f) ? 1 : -1;
+    int stepY = (localVelocity.y > 0.0f) ? 1 : -1;
+    float nextBorderX = _gridMin.x + (_cellSize.x * (cellX + ((stepX > 0) ? 1 : 0)));
+    float nextBorderY = _gridMin.y + (_cellSize.y * (cellY + ((stepY > 0) ? 1 : 0)));
+    float nextCrossingX = (localVelocity.x != 0.0f) ?
+        (nextBorderX - localPosition.x) / localVelocity.x : FLT_MAX;
+    float nextCrossingY = (localVelocity.y != 0.0f) ?
+        (nextBorderY - localPosition.y) / localVelocity.y : FLT_MAX;
+    float crossingTimeX = (localVelocity.x != 0.0f) ?
+        _cellSize.x / fabsf(localVelocity.x) : FLT_MAX;
+    float crossingTimeY = (localVelocity.y != 0.0f) ?
+        _cellSize.y / fabsf(localVelocity.y) : FLT_MAX;
+
+    // a hit beyond the current cell might not be the first one, so keep the earliest and
+    // only stop once the path has gotten to it
+    float exitTimeSec = FLT_MAX;
+    while (true)
+    {
+        unsigned int cellIndex = (cellY * _numCellsX) + cellX;
+        for (unsigned int edgeListIndex = _cellEdgeStarts[cellIndex];
+            edgeListIndex < _cellEdgeStarts[cellIndex + 1]; edgeListIndex++)
+        {
+            unsigned int edgeIndex = _cellEdges[edgeListIndex];
+            unsigned int nextCornerIndex = (edgeIndex + 1 == _corners.size()) ? 0 : edgeIndex + 1;
+            float hitTimeSec = RayHitTime(localPosition, localVelocity, _corners[edgeIndex],
+                _corners[nextCornerIndex]);
+            exitTimeSec = (hitTimeSec < exitTimeSec) ? hitTimeSec : exitTimeSec;
+        }
+
+        float cellExitTimeSec = (nextCrossingX < nextCrossingY) ? nextCrossingX : nextCrossingY;
+        if (exitTimeSec <= cellExitTimeSec)
+        {
+            return exitTimeSec;
+        }
+
+        if (nextCrossingX < nextCrossingY)
+        {
+            cellX += stepX;
+            nextCrossingX += crossingTimeX;
+        }
+        else
+        {
+            cellY += stepY;
+            nextCrossingY += crossingTimeY;
+        }
+
+        if (cellX < 0 || cellX >= (int)_numCellsX || cellY < 0 || cellY >= (int)_numCellsY)
+        {
+            // only float rounding at a corner gets here; the grid is bigger than the polygon
+            return (exitTimeSec < cellExitTimeSec) ? exitTimeSec : cellExitTimeSec;
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Keeps the inverse of the transform's 2D part so that positions can be taken into the
+    polygon's space.  The grid itself doesn't change.
+Parameters:
+    m       A 4x4 transform matrix.  Must be invertible in X and Y.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygonGrid::SetTransform(const glm::mat4 &m)
+{
+    // glm is column-major: m[column][row]
+    float a = m[0][0];
+    float b = m[1][0];
+    float c = m[0][1];
+    float d = m[1][1];
+    float inverseDeterminant = 1.0f / ((a * d) - (b * c));
+    _inverseRow0 = glm::vec2(d, -b) * inverseDeterminant;
+    _inverseRow1 = glm::vec2(-c, a) * inverseDeterminant;
+    _translation = glm::vec2(m[3][0], m[3][1]);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the grid's width in cells.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleRegionPolygonGrid::NumCellsX() const
+{
+    return _numCellsX;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the grid's height in cells.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleRegionPolygonGrid::NumCellsY() const
+{
+    return _numCellsY;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of cells that at least one edge goes through.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleRegionPolygonGrid::NumBoundaryCells() const
+{
+    return _numBoundaryCells;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sizes the grid to the corners' bounding box, files each edge in every cell that it
+    touches, and then decides whether each cell's reference point is inside with one
+    scanline per row of cells.  That is O(edges * rows + cells) instead of a full
+    point-in-polygon test per cell.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygonGrid::BuildGrid()
+{
+    unsigned int numEdges = _corners.size();
+    if (numEdges < 3)
+    {
+        // not a polygon; one outside cell, so everything is out of bounds
+        _gridMin = glm::vec2(0.0f, 0.0f);
+        _cellSize = glm::vec2(1.0f, 1.0f);
+        _inverseCellSize = glm::vec2(1.0f, 1.0f);
+        _numCellsX = 1;
+        _numCellsY = 1;
+        _cellStates.assign(1, CELL_OUTSIDE);
+        _cellEdgeStarts.assign(2, 0);
+        _cellEdges.clear();
+        _numBoundaryCells = 0;
+        return;
+    }
+
+    // the bounding box, padded so that no corner is on the grid's border
+    glm::vec2 boxMin = _corners[0];
+    glm::vec2 boxMax = _corners[0];
+    for (unsigned int cornerIndex = 1; cornerIndex < numEdges; cornerIndex++)
+    {
+        boxMin.x = std::min(boxMin.x, _corners[cornerIndex].x);
+        boxMin.y = std::min(boxMin.y, _corners[cornerIndex].y);
+        boxMax.x = std::max(boxMax.x, _corners[cornerIndex].x);
+        boxMax.y = std::max(boxMax.y, _corners[cornerIndex].y);
+    }
+    glm::vec2 padding = ((boxMax - boxMin) * 0.01f) + glm::vec2(0.0001f, 0.0001f);
+    boxMin -= padding;
+    boxMax += padding;
+    glm::vec2 boxSize = boxMax - boxMin;
+
+    // roughly square cells
+    float targetNumCells = GRID_CELLS_PER_EDGE * numEdges;
+    float targetCellSize = sqrtf((boxSize.x * boxSize.y) / targetNumCells);
+    _numCellsX = (unsigned int)ceilf(boxSize.x / targetCellSize);
+    _numCellsY = (unsigned int)ceilf(boxSize.y / targetCellSize);
+    _numCellsX = std::min(std::max(_numCellsX, GRID_MIN_CELLS_PER_SIDE), GRID_MAX_CELLS_PER_SIDE);
+    _numCellsY = std::min(std::max(_numCellsY, GRID_MIN_CELLS_PER_SIDE), GRID_MAX_CELLS_PER_SIDE);
+    _gridMin = boxMin;
+    _cellSize = glm::vec2(boxSize.x / _numCellsX, boxSize.y / _numCellsY);
+    _inverseCellSize = glm::vec2(1.0f / _cellSize.x, 1.0f / _cellSize.y);
+    unsigned int numCells = _numCellsX * _numCellsY;
+
+    // every (cell, edge) pair where the edge touches the cell, then a counting sort by cell
+    // Note: The cells are padded by a small fraction of their size so that an edge that only
+    // grazes a cell (or float rounding says misses it) is still filed there.  Extra edges in a
+    // cell only cost time.  A missing one would give wrong answers.
+    glm::vec2 cellPadding = _cellSize * 0.001f;
+    std::vector<unsigned int> pairCells;
+    std::vector<unsigned int> pairEdges;
+    for (unsigned int edgeIndex = 0; edgeIndex < numEdges; edgeIndex++)
+    {
+        glm::vec2 a = _corners[edgeIndex];
+        glm::vec2 b = _corners[(edgeIndex + 1 == numEdges) ? 0 : edgeIndex + 1];
+        glm::vec2 edgeMin = (glm::vec2(std::min(a.x, b.x), std::min(a.y, b.y)) - cellPadding - _gridMin) * _inverseCellSize;
+        glm::vec2 edgeMax = (glm::vec2(std::max(a.x, b.x), std::max(a.y, b.y)) + cellPadding - _gridMin) * _inverseCellSize;
+        unsigned int firstX = (unsigned int)std::max(0.0f, floorf(edgeMin.x));
+        unsigned int firstY = (unsigned int)std::max(0.0f, floorf(edgeMin.y));
+        unsigned int lastX = std::min((unsigned int)floorf(edgeMax.x), _numCellsX - 1);
+        unsigned int lastY = std::min((unsigned int)floorf(edgeMax.y), _numCellsY - 1);
+        for (unsigned int cellY = firstY; cellY <= lastY; cellY++)
+        {
+            for (unsigned int cellX = firstX; cellX <= lastX; cellX++)
+            {
+                glm::vec2 cellMin = _gridMin + (_cellSize * glm::vec2((float)cellX, (float)cellY));
+                if (SegmentTouchesBox(a, b, cellMin - cellPadding, cellMin + _cellSize + cellPadding))
+                {
+                    pairCells.push_back((cellY * _numCellsX) + cellX);
+                    pairEdges.push_back(edgeIndex);
+                }
+            }
+        }
+    }
+
+    _cellEdgeStarts.assign(numCells + 1, 0);
+    for (unsigned int pairIndex = 0; pairIndex < pairCells.size(); pairIndex++)
+    {
+        _cellEdgeStarts[pairCells[pairIndex] + 1]++;
+    }
+    for (unsigned int cellIndex = 0; cellIndex < numCells; cellIndex++)
+    {
+        _cellEdgeStarts[cellIndex + 1] += _cellEdgeStarts[cellIndex];
+    }
+    _cellEdges.resize(pairEdges.size());
+    std::vector<unsigned int> fillPositions(_cellEdgeStarts.begin(), _cellEdgeStarts.end() - 1);
+    for (unsigned int pairIndex = 0; pairIndex < pairCells.size(); pairIndex++)
+    {
+        _cellEdges[fillPositions[pairCells[pairIndex]]++] = pairEdges[pairIndex];
+    }
+
+    // one horizontal line through each row's reference points; a point is inside if an odd
+    // number of edges cross the line to its left (the usual even-odd rule)
+    _cellStates.assign(numCells, CELL_OUTSIDE);
+    _numBoundaryCells = 0;
+    std::vector<float> crossingsX;
+    for (unsigned int cellY = 0; cellY < _numCellsY; cellY++)
+    {
+        float lineY = CellReferencePoint(0, cellY).y;
+        crossingsX.clear();
+        for (unsigned int edgeIndex = 0; edgeIndex < numEdges; edgeIndex++)
+        {
+            glm::vec2 a = _corners[edgeIndex];
+            glm::vec2 b = _corners[(edgeIndex + 1 == numEdges) ? 0 : edgeIndex + 1];
+            if ((a.y > lineY) != (b.y > lineY))
+            {
+                crossingsX.push_back(a.x + ((lineY - a.y) * (b.x - a.x) / (b.y - a.y)));
+            }
+        }
+        std::sort(crossingsX.begin(), crossingsX.end());
+
+        unsigned int numCrossingsToTheLeft = 0;
+        for (unsigned int cellX = 0; cellX < _numCellsX; cellX++)
+        {
+            float pointX = CellReferencePoint(cellX, cellY).x;
+            while (numCrossingsToTheLeft < crossingsX.size() &&
+                crossingsX[numCrossingsToTheLeft] < pointX)
+            {
+                numCrossingsToTheLeft++;
+            }
+            bool inside = (numCrossingsToTheLeft % 2) == 1;
+
+            unsigned int cellIndex = (cellY * _numCellsX) + cellX;
+            if (_cellEdgeStarts[cellIndex + 1] > _cellEdgeStarts[cellIndex])
+            {
+                _cellStates[cellIndex] = inside ?
+                    CELL_BOUNDARY_REFERENCE_INSIDE : CELL_BOUNDARY_REFERENCE_OUTSIDE;
+                _numBoundaryCells++;
+            }
+            else
+            {
+                _cellStates[cellIndex] = inside ? CELL_INSIDE : CELL_OUTSIDE;
+            }
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The point in a cell whose inside-ness the cell remembers.
+Parameters:
+    cellX   Self-explanatory.
+    cellY   Self-explanatory.
+Returns:
+    The point, in the polygon's space.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+glm::vec2 ParticleRegionPolygonGrid::CellReferencePoint(const unsigned int cellX,
+    const unsigned int cellY) const
+{
+    return _gridMin + glm::vec2(
+        _cellSize.x * (cellX + REFERENCE_POINT_FRACTION_X),
+        _cellSize.y * (cellY + REFERENCE_POINT_FRACTION_Y));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The check itself, in the polygon's space.  Outside the grid is outside the polygon.  An
+    inside or outside cell is the answer.  In a boundary cell, the line from the position to
+    the cell's reference point stays in the cell, so only the cell's edges can cross it, and
+    each one that does flips the reference point's answer.
+Parameters:
+    localPosition   A particle's position in the polygon's space.
+Returns:
+    True if the particle is outside of the polygon, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleRegionPolygonGrid::OutOfBoundsLocal(const glm::vec2 &localPosition) const
+{
+    glm::vec2 gridPosition = (localPosition - _gridMin) * _inverseCellSize;
+
+    // written so that NaN is out of bounds too
+    if (!(gridPosition.x >= 0.0f && gridPosition.x < (float)_numCellsX &&
+        gridPosition.y >= 0.0f && gridPosition.y < (float)_numCellsY))
+    {
+        return true;
+    }
+
+    unsigned int cellX = (unsigned int)gridPosition.x;
+    unsigned int cellY = (unsigned int)gridPosition.y;
+    unsigned int cellIndex = (cellY * _numCellsX) + cellX;
+    unsigned char state = _cellStates[cellIndex];
+    if (state == CELL_INSIDE)
+    {
+        return false;
+    }
+    else if (state == CELL_OUTSIDE)
+    {
+        return true;
+    }
+
+    glm::vec2 referencePoint = CellReferencePoint(cellX, cellY);
+    bool inside = (state == CELL_BOUNDARY_REFERENCE_INSIDE);
+    for (unsigned int edgeListIndex = _cellEdgeStarts[cellIndex];
+        edgeListIndex < _cellEdgeStarts[cellIndex + 1]; edgeListIndex++)
+    {
+        unsigned int edgeIndex = _cellEdges[edgeListIndex];
+        unsigned int nextCornerIndex = (edgeIndex + 1 == _corners.size()) ? 0 : edgeIndex + 1;
+        inside ^= SegmentsCross(localPosition, referencePoint, _corners[edgeIndex],
+            _corners[nextCornerIndex]);
+    }
+    return !inside;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes a window space position into the polygon's space (see SetTransform(...)).
+Parameters:
+    position    Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+glm::vec2 ParticleRegionPolygonGrid::ToLocal(const glm::vec2 &position) const
+{
+    glm::vec2 offset = position - _translation;
+    return glm::vec2(
+        (_inverseRow0.x * offset.x) + (_inverseRow0.y * offset.y),
+        (_inverseRow1.x * offset.x) + (_inverseRow1.y * offset.y));
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "IParticleRegion.h"
+#include "glm/vec2.hpp"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A polygonal region for shapes that ParticleRegionPolygon can't do: concave polygons and
+    polygons with more than MAX_POLYGON_FACES edges (like regions traced from floor plans).
+    Any simple polygon works, in either winding order.  Inside is decided by the even-odd rule.
+
+    A uniform grid is laid over the polygon's bounding box when it is made.  Each cell is
+    fully inside, fully outside, or "boundary" (at least one edge goes through it).  Boundary
+    cells keep a list of their edges and whether a reference point in the cell is inside.  A
+    position in an inside or outside cell is answered with one lookup.  A position in a
+    boundary cell is answered by counting the cell's edges that cross the line from the
+    position to the reference point, so the cost depends on how many edges are in that cell
+    instead of how many are in the polygon.
+
+    The grid is built in the polygon's own space and never rebuilt.  SetTransform(...) keeps
+    the inverse transform instead, and positions are taken into the polygon's space to be
+    checked.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleRegionPolygonGrid final : public IParticleRegion
+{
+public:
+    ParticleRegionPolygonGrid(const std::vector<glm::vec2> &corners);
+    virtual bool OutOfBounds(const glm::vec2 &position) const;
+    virtual bool OutOfBoundsFixedPoint(const int positionX, const int positionY) const;
+    virtual void OutOfBoundsBatch(const ParticlePositionSpan &positions,
+        unsigned long long *outOfBoundsBits) const;
+    virtual float ExitTime(const glm::vec2 &position, const glm::vec2 &velocity) const;
+    virtual void SetTransform(const glm::mat4 &m);
+
+    unsigned int NumCellsX() const;
+    unsigned int NumCellsY() const;
+    unsigned int NumBoundaryCells() const;
+
+private:
+    void BuildGrid();
+    glm::vec2 CellReferencePoint(const unsigned int cellX, const unsigned int cellY) const;
+    bool OutOfBoundsLocal(const glm::vec2 &localPosition) const;
+    glm::vec2 ToLocal(const glm::vec2 &position) const;
+
+    // the polygon, in its own space; edge N goes from corner N to corner N + 1 (wrapping)
+    std::vector<glm::vec2> _corners;
+
+    // the grid covers the polygon's bounding box (plus a little) in _numCellsX * _numCellsY
+    // cells, row by row
+    glm::vec2 _gridMin;
+    glm::vec2 _cellSize;
+    glm::vec2 _inverseCellSize;
+    unsigned int _numCellsX;
+    unsigned int _numCellsY;
+    std::vector<unsigned char> _cellStates;
+
+    // boundary cell N's edges are _cellEdges[_cellEdgeStarts[N]] up to (not including)
+    // _cellEdges[_cellEdgeStarts[N + 1]]; other cells have none
+    std::vector<unsigned int> _cellEdgeStarts;
+    std::vector<unsigned int> _cellEdges;
+    unsigned int _numBoundaryCells;
+
+    // window space -> polygon space is local = (rows) * (position - _translation)
+    glm::vec2 _inverseRow0;
+    glm::vec2 _inverseRow1;
+    glm::vec2 _translation;
+};
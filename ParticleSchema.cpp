@@ -0,0 +1,141 @@
+#include "ParticleSchema.h"
+
+#include "glload/include/glload/gl_4_4.h"
+
+// must match the layout locations in shaderParticle.vert
+static const unsigned int SHADER_LOCATION_POSITION_X = 0;
+static const unsigned int SHADER_LOCATION_POSITION_Y = 1;
+static const unsigned int SHADER_LOCATION_VELOCITY = 2;
+static const unsigned int SHADER_LOCATION_COLOR = 3;
+static const unsigned int SHADER_LOCATION_SIZE = 4;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Position is split into two single-float attributes, same as ParticleStorage, so that the
+    "structure of arrays" storages can share the shader.
+
+    The vertex array object and array buffer must already be bound.
+Parameters:
+    strideBytes     The size of the particle record.
+    offsetBytes     Where the position is in the particle record.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleAttributePosition::EnableVertexAttributes(const unsigned int strideBytes,
+    const unsigned int offsetBytes)
+{
+    unsigned int bufferStartOffset = offsetBytes;
+    glEnableVertexAttribArray(SHADER_LOCATION_POSITION_X);
+    glVertexAttribPointer(SHADER_LOCATION_POSITION_X, 1, GL_FLOAT, GL_FALSE, strideBytes, (void *)bufferStartOffset);
+
+    bufferStartOffset += sizeof(float);
+    glEnableVertexAttribArray(SHADER_LOCATION_POSITION_Y);
+    glVertexAttribPointer(SHADER_LOCATION_POSITION_Y, 1, GL_FLOAT, GL_FALSE, strideBytes, (void *)bufferStartOffset);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Velocity is a vec2.
+
+    The vertex array object and array buffer must already be bound.
+Parameters:
+    strideBytes     The size of the particle record.
+    offsetBytes     Where the velocity is in the particle record.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleAttributeVelocity::EnableVertexAttributes(const unsigned int strideBytes,
+    const unsigned int offsetBytes)
+{
+    unsigned int bufferStartOffset = offsetBytes;
+    glEnableVertexAttribArray(SHADER_LOCATION_VELOCITY);
+    glVertexAttribPointer(SHADER_LOCATION_VELOCITY, 2, GL_FLOAT, GL_FALSE, strideBytes, (void *)bufferStartOffset);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A small palette so that particles from different emitters can be told apart.  Emitters past
+    the end of the palette wrap around.
+Parameters:
+    emitterIndex    The emitter's index in the ParticleUpdater.
+Returns:
+    An RGBA color.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleAttributeColor::ValueType ParticleAttributeColor::DefaultValue(
+    const unsigned int emitterIndex)
+{
+    static const glm::vec4 emitterColors[] =
+    {
+        glm::vec4(1.0f, 0.5f, 0.0f, 1.0f),  // orange
+        glm::vec4(0.0f, 0.75f, 1.0f, 1.0f), // sky blue
+        glm::vec4(0.5f, 1.0f, 0.0f, 1.0f),  // lime
+        glm::vec4(1.0f, 0.0f, 0.5f, 1.0f),  // pink
+        glm::vec4(1.0f, 1.0f, 0.0f, 1.0f),  // yellow
+    };
+    unsigned int numColors = sizeof(emitterColors) / sizeof(emitterColors[0]);
+    return emitterColors[emitterIndex % numColors];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Color is a vec4.
+
+    The vertex array object and array buffer must already be bound.
+Parameters:
+    strideBytes     The size of the particle record.
+    offsetBytes     Where the color is in the particle record.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleAttributeColor::EnableVertexAttributes(const unsigned int strideBytes,
+    const unsigned int offsetBytes)
+{
+    unsigned int bufferStartOffset = offsetBytes;
+    glEnableVertexAttribArray(SHADER_LOCATION_COLOR);
+    glVertexAttribPointer(SHADER_LOCATION_COLOR, 4, GL_FLOAT, GL_FALSE, strideBytes, (void *)bufferStartOffset);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Size is a single float.
+
+    The vertex array object and array buffer must already be bound.
+Parameters:
+    strideBytes     The size of the particle record.
+    offsetBytes     Where the size is in the particle record.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleAttributeSize::EnableVertexAttributes(const unsigned int strideBytes,
+    const unsigned int offsetBytes)
+{
+    unsigned int bufferStartOffset = offsetBytes;
+    glEnableVertexAttribArray(SHADER_LOCATION_SIZE);
+    glVertexAttribPointer(SHADER_LOCATION_SIZE, 1, GL_FLOAT, GL_FALSE, strideBytes, (void *)bufferStartOffset);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets the "generic" vertex attribute values that the particle shader reads for any optional
+    attribute that a storage doesn't send: white particles that are 1 pixel across, which is
+    what every storage drew before the schema existed.
+
+    These are context state, not vertex array object state, but a draw with a vertex array 
+    object that sends those attributes as arrays (like the schema storage's) leaves them 
+    undefined afterwards.  So call this before every draw that relies on them, not just once.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void SetDefaultParticleVertexAttributes()
+{
+    glVertexAttrib4f(SHADER_LOCATION_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
+    glVertexAttrib1f(SHADER_LOCATION_SIZE, 1.0f);
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "Particle.h"
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+#include <type_traits>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The attributes that a particle system can declare in its ParticleSchema<...>.
+
+    Each attribute is a tag structure that says:
+    - what type its per-particle value is (ValueType),
+    - what a newly emitted particle gets (DefaultValue(...)), and
+    - how to describe it to the particle shader (EnableVertexAttributes(...), defined in the
+    .cpp so that this header doesn't need OpenGL).  Attributes that the shader doesn't read
+    don't enable anything, but they are still in the record and are still uploaded.
+
+    Shader locations are fixed per attribute (see shaderParticle.vert) so that any schema can
+    use the same shader.  Attributes that a schema leaves out are not sent, and the shader reads
+    the "generic" value for that location instead (see Init() in main.cpp).
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+
+// shader locations 0 (X) and 1 (Y); required by every schema because the region needs it
+struct ParticleAttributePosition
+{
+    typedef glm::vec2 ValueType;
+    static ValueType DefaultValue(const unsigned int) { return ValueType(); }
+    static void EnableVertexAttributes(const unsigned int strideBytes,
+        const unsigned int offsetBytes);
+};
+
+// shader location 2; also what moves the position
+struct ParticleAttributeVelocity
+{
+    typedef glm::vec2 ValueType;
+    static ValueType DefaultValue(const unsigned int) { return ValueType(); }
+    static void EnableVertexAttributes(const unsigned int strideBytes,
+        const unsigned int offsetBytes);
+};
+
+// seconds since emission; not sent to the shader
+struct ParticleAttributeAge
+{
+    typedef float ValueType;
+    static ValueType DefaultValue(const unsigned int) { return 0.0f; }
+    static void EnableVertexAttributes(const unsigned int, const unsigned int) {}
+};
+
+// shader location 3; each emitter gets its own color
+struct ParticleAttributeColor
+{
+    typedef glm::vec4 ValueType;
+    static ValueType DefaultValue(const unsigned int emitterIndex);
+    static void EnableVertexAttributes(const unsigned int strideBytes,
+        const unsigned int offsetBytes);
+};
+
+// shader location 4; point size in pixels
+struct ParticleAttributeSize
+{
+    typedef float ValueType;
+    static ValueType DefaultValue(const unsigned int) { return 2.0f; }
+    static void EnableVertexAttributes(const unsigned int strideBytes,
+        const unsigned int offsetBytes);
+};
+
+// index of the emitter in the ParticleUpdater; not sent to the shader
+struct ParticleAttributeEmitterId
+{
+    typedef unsigned int ValueType;
+    static ValueType DefaultValue(const unsigned int emitterIndex) { return emitterIndex; }
+    static void EnableVertexAttributes(const unsigned int, const unsigned int) {}
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Holds one attribute's value in a particle record.  A record inherits one of these for each
+    attribute in its schema, so an attribute that isn't declared doesn't take any space.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename ATTRIBUTE>
+struct ParticleAttributeField
+{
+    typename ATTRIBUTE::ValueType _value;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gets an attribute's value out of a record.  Only compiles if the record's schema declared
+    the attribute.
+Parameters:
+    record      A ParticleSchema<...>::Record.
+Returns:
+    A reference to the attribute's value.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename ATTRIBUTE, typename RECORD>
+inline typename ATTRIBUTE::ValueType &GetAttribute(RECORD &record)
+{
+    return static_cast<ParticleAttributeField<ATTRIBUTE> &>(record)._value;
+}
+
+template<typename ATTRIBUTE, typename RECORD>
+inline const typename ATTRIBUTE::ValueType &GetAttribute(const RECORD &record)
+{
+    return static_cast<const ParticleAttributeField<ATTRIBUTE> &>(record)._value;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Compile-time "is this attribute in this list" check.  The list is walked recursively
+    because VS2015 doesn't have fold expressions.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename ATTRIBUTE, typename... ATTRIBUTES>
+struct ParticleAttributeListContains;
+
+template<typename ATTRIBUTE>
+struct ParticleAttributeListContains<ATTRIBUTE> : std::false_type
+{
+};
+
+template<typename ATTRIBUTE, typename FIRST, typename... REST>
+struct ParticleAttributeListContains<ATTRIBUTE, FIRST, REST...> : std::integral_constant<bool,
+    std::is_same<ATTRIBUTE, FIRST>::value ||
+    ParticleAttributeListContains<ATTRIBUTE, REST...>::value>
+{
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does something to every attribute of a record, one attribute at a time, recursively (same
+    reason as above).  The schema uses this for the things that every attribute takes part in:
+    resetting to defaults and describing the vertex attributes.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename... ATTRIBUTES>
+struct ParticleAttributeList;
+
+template<>
+struct ParticleAttributeList<>
+{
+    template<typename RECORD>
+    static void Reset(RECORD &, const unsigned int) {}
+
+    template<typename RECORD>
+    static void EnableVertexAttributes(const RECORD &) {}
+};
+
+template<typename FIRST, typename... REST>
+struct ParticleAttributeList<FIRST, REST...>
+{
+    template<typename RECORD>
+    static void Reset(RECORD &record, const unsigned int emitterIndex)
+    {
+        GetAttribute<FIRST>(record) = FIRST::DefaultValue(emitterIndex);
+        ParticleAttributeList<REST...>::Reset(record, emitterIndex);
+    }
+
+    // the record isn't "standard layout" (several base classes have members), so offsetof(...)
+    // can't be used; measure the offset on an actual record instead
+    template<typename RECORD>
+    static void EnableVertexAttributes(const RECORD &record)
+    {
+        const char *pRecordStart = reinterpret_cast<const char *>(&record);
+        const char *pValueStart = reinterpret_cast<const char *>(&GetAttribute<FIRST>(record));
+        FIRST::EnableVertexAttributes(sizeof(RECORD), (unsigned int)(pValueStart - pRecordStart));
+        ParticleAttributeList<REST...>::EnableVertexAttributes(record);
+    }
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Declares which attributes a particle system carries, and generates from that declaration:
+    - the per-particle record (only the declared attributes take up bytes),
+    - the per-frame kernel (Integrate(...); only the declared attributes cost cycles),
+    - emission (Emit(...)), and
+    - the vertex attribute setup for ParticleSchemaStorage<...>::Init(...).
+
+    Example:
+        typedef ParticleSchema<ParticleAttributePosition, ParticleAttributeVelocity,
+            ParticleAttributeColor> ColoredParticleSchema;
+
+    The per-frame work of each attribute is picked at compile time with std::true_type and
+    std::false_type overloads (VS2015 doesn't have "if constexpr"), so the "false" versions
+    compile to nothing.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename... ATTRIBUTES>
+struct ParticleSchema
+{
+    // one base class (with one member) per declared attribute
+    struct Record : public ParticleAttributeField<ATTRIBUTES>...
+    {
+    };
+
+    template<typename ATTRIBUTE>
+    struct Has : ParticleAttributeListContains<ATTRIBUTE, ATTRIBUTES...>
+    {
+    };
+
+    static_assert(Has<ParticleAttributePosition>::value,
+        "particle regions need every schema to have a position");
+
+    static void Integrate(Record &record, const float deltaTimeSec)
+    {
+        Move(record, deltaTimeSec, typename Has<ParticleAttributeVelocity>::type());
+        Age(record, deltaTimeSec, typename Has<ParticleAttributeAge>::type());
+    }
+
+    static void Emit(Record &record, const Particle &emitted, const unsigned int emitterIndex)
+    {
+        ParticleAttributeList<ATTRIBUTES...>::Reset(record, emitterIndex);
+        GetAttribute<ParticleAttributePosition>(record) = emitted._position;
+        SetVelocity(record, emitted._velocity, typename Has<ParticleAttributeVelocity>::type());
+    }
+
+    static void EnableVertexAttributes()
+    {
+        Record record;
+        ParticleAttributeList<ATTRIBUTES...>::EnableVertexAttributes(record);
+    }
+
+private:
+    static void Move(Record &record, const float deltaTimeSec, std::true_type)
+    {
+        glm::vec2 &position = GetAttribute<ParticleAttributePosition>(record);
+        position = position + (GetAttribute<ParticleAttributeVelocity>(record) * deltaTimeSec);
+    }
+    static void Move(Record &, const float, std::false_type) {}
+
+    static void Age(Record &record, const float deltaTimeSec, std::true_type)
+    {
+        GetAttribute<ParticleAttributeAge>(record) += deltaTimeSec;
+    }
+    static void Age(Record &, const float, std::false_type) {}
+
+    static void SetVelocity(Record &record, const glm::vec2 &velocity, std::true_type)
+    {
+        GetAttribute<ParticleAttributeVelocity>(record) = velocity;
+    }
+    static void SetVelocity(Record &, const glm::vec2 &, std::false_type) {}
+};
+
+// see the .cpp; call once after the particle shader is loaded
+void SetDefaultParticleVertexAttributes();
@@ -0,0 +1,48 @@
+#include "ParticleSchemaStorage.h"
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates a vertex buffer and vertex array object and leaves both bound (and the program in 
+    use) so that the schema can describe its vertex attributes.  Must be followed by 
+    EndParticleVertexSetup().
+Parameters:
+    programId       Program binding is required for vertex attributes.
+    bufferSizeBytes Space is allocated now, and data is sent at render time.
+    pVaoId          Receives the new vertex array object's ID.
+    pArrayBufferId  Receives the new buffer's ID.
+    pDrawStyle      Receives GL_POINTS.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BeginParticleVertexSetup(unsigned int programId, unsigned int bufferSizeBytes,
+    unsigned int *pVaoId, unsigned int *pArrayBufferId, unsigned int *pDrawStyle)
+{
+    *pDrawStyle = GL_POINTS;
+
+    // MUST bind the program beforehand or else the VAO generation and binding will blow up
+    glUseProgram(programId);
+
+    glGenVertexArrays(1, pVaoId);
+    glGenBuffers(1, pArrayBufferId);
+    glBindVertexArray(*pVaoId);
+    glBindBuffer(GL_ARRAY_BUFFER, *pArrayBufferId);
+    glBufferData(GL_ARRAY_BUFFER, bufferSizeBytes, 0, GL_DYNAMIC_DRAW);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Unbinds everything that BeginParticleVertexSetup(...) bound.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void EndParticleVertexSetup()
+{
+    glBindVertexArray(0);   // unbind this BEFORE the array
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);    // always last
+}
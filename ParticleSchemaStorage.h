@@ -0,0 +1,129 @@
+#pragma once
+
+#include "ParticleSchema.h"
+#include "ParticleActiveMask.h"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The OpenGL half of ParticleSchemaStorage<...>::Init(...), which doesn't depend on the
+    schema, so it is defined in ParticleSchemaStorage.cpp and this header doesn't need OpenGL.
+    The schema's vertex attributes are described between the two calls.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void BeginParticleVertexSetup(unsigned int programId, unsigned int bufferSizeBytes,
+    unsigned int *pVaoId, unsigned int *pArrayBufferId, unsigned int *pDrawStyle);
+void EndParticleVertexSetup();
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    An "array of structures" particle storage whose structure is generated from a
+    ParticleSchema<...>.  Otherwise the same as ParticleStorage: an "active" mask, a "free
+    index" stack, and one interleaved OpenGL buffer that is uploaded all at once.
+
+    The whole class is in the header because it is a template over every schema that anyone
+    declares.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename SCHEMA>
+struct ParticleSchemaStorage
+{
+public:
+    typedef SCHEMA Schema;
+    typedef typename SCHEMA::Record Record;
+
+    ParticleSchemaStorage();
+    void Init(unsigned int programId, unsigned int numParticles);
+    void InitParticles(unsigned int numParticles);
+    unsigned int Size() const;
+
+    // see ParticleStorage for why these are primitive types
+    unsigned int _vaoId;
+    unsigned int _arrayBufferId;
+    unsigned int _drawStyle;    // GL_POINTS
+    unsigned int _sizeBytes;
+
+    std::vector<Record> _allParticles;
+
+    // same story as ParticleStorage
+    ParticleActiveMask _activeMask;
+    std::vector<unsigned int> _freeIndices;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename SCHEMA>
+ParticleSchemaStorage<SCHEMA>::ParticleSchemaStorage() :
+    _vaoId(0),
+    _arrayBufferId(0),
+    _drawStyle(0),
+    _sizeBytes(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the particle records, generates a vertex buffer and vertex array object for them,
+    and lets the schema describe its attributes.
+Parameters:
+    programId       Program binding is required for vertex attributes.
+    numParticles    New memory is allocated to fit this number of particles.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename SCHEMA>
+void ParticleSchemaStorage<SCHEMA>::Init(unsigned int programId, unsigned int numParticles)
+{
+    InitParticles(numParticles);
+    BeginParticleVertexSetup(programId, _sizeBytes, &_vaoId, &_arrayBufferId, &_drawStyle);
+    SCHEMA::EnableVertexAttributes();
+    EndParticleVertexSetup();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the particle records, the "active" mask, and the "free index" stack without
+    touching OpenGL.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename SCHEMA>
+void ParticleSchemaStorage<SCHEMA>::InitParticles(unsigned int numParticles)
+{
+    _allParticles.assign(numParticles, Record());
+    _sizeBytes = sizeof(Record) * numParticles;
+    _activeMask.Init(numParticles);
+
+    // lowest index on top
+    _freeIndices.clear();
+    _freeIndices.reserve(numParticles);
+    for (unsigned int particleIndex = numParticles; particleIndex > 0; particleIndex--)
+    {
+        _freeIndices.push_back(particleIndex - 1);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename SCHEMA>
+unsigned int ParticleSchemaStorage<SCHEMA>::Size() const
+{
+    return _allParticles.size();
+}
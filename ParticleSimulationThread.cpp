@@ -0,0 +1,227 @@
+#include "ParticleSimulationThread.h"
+
+#include "ParticleUpdater.h"
+#include "RandomToast.h"
+
+#include <algorithm>
+#include <chrono>
+
+// if the simulation is more than this many steps behind real time, it stops trying to catch up
+static const unsigned int MAX_STEPS_BEHIND = 5;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.  Nothing runs until Init(...)
+    and Start().
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleSimulationThread::ParticleSimulationThread() :
+    _pUpdater(0),
+    _stepSec(0.01f),
+    _stepIndex(0),
+    _quit(false)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Stops the thread.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleSimulationThread::~ParticleSimulationThread()
+{
+    Stop();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Stops the thread if it's running, then starts the simulation over with every particle
+    inactive and nothing published.  All three frames are allocated here so that publishing
+    never allocates.
+Parameters:
+    pUpdater        Has the region and emitters.  Must outlive the thread.
+    numParticles    Self-explanatory.
+    stepSec         The simulated time per step, which is also the real time between steps.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleSimulationThread::Init(const ParticleUpdater *pUpdater,
+    const unsigned int numParticles, const float stepSec)
+{
+    Stop();
+
+    _pUpdater = pUpdater;
+    _stepSec = stepSec;
+    _storage.InitParticles(numParticles);
+    _stepIndex = 0;
+
+    _frames.Reset();
+    for (unsigned int bufferIndex = 0; bufferIndex < 3; bufferIndex++)
+    {
+        ParticleFrame &frame = _frames.Buffer(bufferIndex);
+        frame._particles.assign(numParticles, Particle());
+        frame._numActiveParticles = 0;
+        frame._stepIndex = 0;
+        frame._stepSec = 0.0;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Starts the thread, which carries on from wherever the simulation was.  Does nothing if it's
+    already running or Init(...) wasn't called.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleSimulationThread::Start()
+{
+    if (_thread.joinable() || _pUpdater == 0)
+    {
+        return;
+    }
+
+    _quit.store(false);
+    _thread = std::thread(&ParticleSimulationThread::SimulationLoop, this);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Tells the thread to quit and waits for it, which takes at most one step.  The simulation
+    and the latest frame are kept for Start().
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleSimulationThread::Stop()
+{
+    if (!_thread.joinable())
+    {
+        return;
+    }
+
+    _quit.store(true);
+    _thread.join();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for whether the thread was started and not stopped.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleSimulationThread::Running() const
+{
+    return _thread.joinable();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gets the newest step that the simulation thread finished, without waiting for it.  The
+    frame stays valid and unchanged until the next call.  Compare its step index with the last
+    one that was uploaded to skip uploading the same step twice.
+
+    Must only be called from one thread (the render thread).
+Parameters: None
+Returns:
+    See description.  Its step index is 0 if nothing has been published yet.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+const ParticleFrame &ParticleSimulationThread::LatestFrame()
+{
+    _frames.Update();
+    return _frames.ReadBuffer();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The thread's life: step, publish, and sleep until the next step is due, until Stop().
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleSimulationThread::SimulationLoop()
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration stepDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(_stepSec));
+
+    // any seed will do as long as it isn't the same as the other threads'
+    Clock::time_point nextStepTime = Clock::now();
+    SeedRandomForThisThread((unsigned long long)nextStepTime.time_since_epoch().count());
+
+    // Note: Not a Stopwatch, because Stopwatch::Init() sets the timer frequency that every 
+    // other thread's stopwatches read.
+    while (!_quit.load())
+    {
+        Clock::time_point stepStartTime = Clock::now();
+        unsigned int numParticles = _storage._allParticles.Size();
+        unsigned int numActiveParticles =
+            _pUpdater->Update(_storage, 0, numParticles, _stepSec);
+        numActiveParticles += _pUpdater->Emit(_storage);
+        double stepSec = std::chrono::duration<double>(Clock::now() - stepStartTime).count();
+        PublishStep(numActiveParticles, stepSec);
+
+        nextStepTime += stepDuration;
+        Clock::time_point now = Clock::now();
+        if (now > nextStepTime + (stepDuration * MAX_STEPS_BEHIND))
+        {
+            nextStepTime = now;
+        }
+        std::this_thread::sleep_until(nextStepTime);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Copies the particles into the triple buffer's write buffer and publishes it.
+Parameters:
+    numActiveParticles  Self-explanatory.
+    stepSec             How long the step took.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleSimulationThread::PublishStep(const unsigned int numActiveParticles,
+    const double stepSec)
+{
+    ParticleFrame &frame = _frames.WriteBuffer();
+    const ParticlePool &particles = _storage._allParticles;
+
+    // the pool is in segments, but the frame is one array
+    unsigned int numRemaining = particles.Size();
+    Particle *pDestination = frame._particles.data();
+    for (unsigned int segmentIndex = 0; numRemaining > 0; segmentIndex++)
+    {
+        unsigned int numInSegment = numRemaining;
+        if (numInSegment > ParticlePool::PARTICLES_PER_SEGMENT)
+        {
+            numInSegment = ParticlePool::PARTICLES_PER_SEGMENT;
+        }
+
+        const Particle *pSource = particles.SegmentData(segmentIndex);
+        std::copy(pSource, pSource + numInSegment, pDestination);
+        pDestination += numInSegment;
+        numRemaining -= numInSegment;
+    }
+
+    _stepIndex++;
+    frame._numActiveParticles = numActiveParticles;
+    frame._stepIndex = _stepIndex;
+    frame._stepSec = stepSec;
+    _frames.Publish();
+}
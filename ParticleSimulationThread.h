@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Particle.h"
+#include "ParticleStorage.h"
+#include "TripleBuffer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class ParticleUpdater;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    One finished step of a ParticleSimulationThread, ready to upload.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleFrame
+{
+    // every particle, in one array so that it goes up in one glBufferSubData(...)
+    std::vector<Particle> _particles;
+    unsigned int _numActiveParticles;
+
+    // 0 until the first step is published; after that, 1 and up
+    unsigned long long _stepIndex;
+
+    // how long the update and emit took, not counting the copy into this frame
+    double _stepSec;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs ParticleUpdater::Update(...) and Emit(...) on its own thread at a fixed step, so that
+    a slow step doesn't hold up the frame that is being drawn, and a slow draw doesn't hold up
+    the simulation.
+
+    The thread has its own particle storage (without an OpenGL buffer).  After each step, it
+    copies the particles into the write buffer of a TripleBuffer and publishes it.  The render
+    thread calls LatestFrame() to get the newest finished step without waiting, and uploads it
+    only if it's one that hasn't been drawn yet.  The simulation and the drawing overlap, and
+    each runs at its own rate: the simulation tries to keep up with real time at one step per
+    step length, and the frame rate is whatever the render thread manages.
+
+    If the simulation falls more than a few steps behind (like after the debugger stopped it),
+    it gives up on catching up instead of running flat out.
+
+    The updater's regions and emitters are used on this thread while it runs, so stop it before
+    changing them (or the particle kernels) and before deleting them.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleSimulationThread
+{
+public:
+    ParticleSimulationThread();
+    ~ParticleSimulationThread();
+    void Init(const ParticleUpdater *pUpdater, const unsigned int numParticles,
+        const float stepSec);
+    void Start();
+    void Stop();
+    bool Running() const;
+
+    // render thread only
+    const ParticleFrame &LatestFrame();
+
+private:
+    // not copyable; the thread has a pointer to this
+    ParticleSimulationThread(const ParticleSimulationThread &);
+    ParticleSimulationThread &operator=(const ParticleSimulationThread &);
+
+    void SimulationLoop();
+    void PublishStep(const unsigned int numActiveParticles, const double stepSec);
+
+    const ParticleUpdater *_pUpdater;
+    float _stepSec;
+
+    // only touched by the simulation thread while it runs
+    ParticleStorage _storage;
+    unsigned long long _stepIndex;
+
+    TripleBuffer<ParticleFrame> _frames;
+    std::thread _thread;
+    std::atomic<bool> _quit;
+};
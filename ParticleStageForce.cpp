@@ -0,0 +1,55 @@
+#include "ParticleStageForce.h"
+
+#include "ParticleStorageSoA.h"
+#include "BitOperations.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple assignment.
+Parameters:
+    acceleration    In window space per second per second.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleStageForce::ParticleStageForce(const glm::vec2 &acceleration) :
+    _acceleration(acceleration)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Adds the acceleration to the velocity of the tile's active particles.  Like the integration
+    kernels, inactive particles in an occupied chunk get the acceleration multiplied by 0 
+    instead of being skipped, so the loop is branch-free.
+Parameters:
+    pStorage        The particles.
+    tileStart       See IParticleStage.
+    tileEnd         See IParticleStage.
+    deltaTimeSec    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStageForce::Run(ParticleStorageSoA *pStorage, const unsigned int tileStart, 
+    const unsigned int tileEnd, const float deltaTimeSec) const
+{
+    float *velX = pStorage->_velocityX.data();
+    float *velY = pStorage->_velocityY.data();
+    glm::vec2 deltaVelocity = _acceleration * deltaTimeSec;
+    const ParticleActiveMask &activeMask = pStorage->_activeMask;
+    unsigned int endChunk = (tileEnd + 63) / 64;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(tileStart / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+        unsigned int numInChunk = (tileEnd < chunkStart + 64) ? (tileEnd - chunkStart) : 64;
+        for (unsigned int bitIndex = 0; bitIndex < numInChunk; bitIndex++)
+        {
+            float scale = (float)((activeBits >> bitIndex) & 1);
+            velX[chunkStart + bitIndex] += deltaVelocity.x * scale;
+            velY[chunkStart + bitIndex] += deltaVelocity.y * scale;
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "IParticleStage.h"
+#include "glm/vec2.hpp"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A constant acceleration (like gravity or wind) applied to the velocity of every active 
+    particle.  Meant to run before integration (PARTICLE_STAGE_BEFORE_INTEGRATE).
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleStageForce final : public IParticleStage
+{
+public:
+    ParticleStageForce(const glm::vec2 &acceleration);
+    virtual void Run(ParticleStorageSoA *pStorage, const unsigned int tileStart, 
+        const unsigned int tileEnd, const float deltaTimeSec) const;
+
+private:
+    glm::vec2 _acceleration;
+};
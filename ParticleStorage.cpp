@@ -2,6 +2,10 @@
 
 #include "glload/include/glload/gl_4_4.h"
 
+// at the demo's 100 updates per second, this covers about 10 seconds before entries have to 
+// wait for the next trip around the wheel
+static const unsigned int EXPIRY_WHEEL_SLOTS = 1024;
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Ensures that the object starts object with initialized values.
@@ -14,7 +18,8 @@ ParticleStorage::ParticleStorage() :
     _vaoId(0),
     _arrayBufferId(0),
     _drawStyle(0),
-    _sizeBytes(0)
+    _sizeBytes(0),
+    _numActiveParticles(0)
 {
 }
 
@@ -32,8 +37,7 @@ Creator:    John Cox (7-4-2016)
 void ParticleStorage::Init(unsigned int programId, unsigned int numParticles)
 {
     // take care of the easy stuff first
-    _allParticles.resize(numParticles);
-    _sizeBytes = sizeof(Particle) * numParticles;
+    InitParticles(numParticles);
     _drawStyle = GL_POINTS;
 
     // MUST bind the program beforehand or else the VAO generation and binding will blow up
@@ -48,46 +52,175 @@ void ParticleStorage::Init(unsigned int programId, unsigned int numParticles)
     glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
 
     // just allocate space now, and send updated data at render time
-    GLuint bufferSizeBytes = sizeof(Particle);
-    bufferSizeBytes *= numParticles;
-    glBufferData(GL_ARRAY_BUFFER, bufferSizeBytes, 0, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, _sizeBytes, 0, GL_DYNAMIC_DRAW);
 
-    // position appears first in structure and so is attribute 0 
-    // velocity appears second and is attribute 1
-    // "is active" flag is third and is attribute 2
+    // position X appears first in structure and so is attribute 0 
+    // position Y appears second and is attribute 1
+    // velocity appears third and is attribute 2
+    // Note: The position is split into two single-float attributes so that the same shader can 
+    // be used by ParticleStorageSoA, which keeps X and Y in separate arrays.
     unsigned int vertexArrayIndex = 0; 
     unsigned int bufferStartOffset = 0;
 
     unsigned int bytesPerStep = sizeof(Particle);
 
-    // position
+    // position X
     GLenum itemType = GL_FLOAT;
-    unsigned int numItems = sizeof(Particle::_position) / sizeof(float);
+    unsigned int numItems = 1;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, numItems, itemType, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
+
+    // position Y
+    bufferStartOffset += sizeof(float);
+    vertexArrayIndex++;
     glEnableVertexAttribArray(vertexArrayIndex);
     glVertexAttribPointer(vertexArrayIndex, numItems, itemType, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
 
     // velocity
     itemType = GL_FLOAT;
     numItems = sizeof(Particle::_velocity) / sizeof(float);
-    bufferStartOffset += sizeof(Particle::_position);
+    bufferStartOffset = sizeof(Particle::_position);
     vertexArrayIndex++;
     glEnableVertexAttribArray(vertexArrayIndex);
     glVertexAttribPointer(vertexArrayIndex, numItems, itemType, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
 
-    // ignoring the "is active" flag by not telling OpenGL that there is an item here 
-    // Note: Does this waste bytes? Yes, but it would be more work to pluck out the position and 
-    // velocity and make those contiguous in another data structure than it would be to simply 
-    // ignore the "is active" flag.
-    //// "is active" flag
-    //itemType = GL_INT;
-    //numItems = sizeof(Particle::_isActive) / sizeof(int);
-    //bufferStartOffset += sizeof(Particle::_velocity);
-    //vertexArrayIndex++;
-    //glEnableVertexAttribArray(vertexArrayIndex);
-    //glVertexAttribPointer(vertexArrayIndex, numItems, itemType, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
-
     // cleanup
     glBindVertexArray(0);   // unbind this BEFORE the array
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glUseProgram(0);    // always last
 }
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the particles, the "active" mask, and the "free index" stack without touching 
+    OpenGL.  Init(...) calls this, and the benchmarks call it directly.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorage::InitParticles(unsigned int numParticles)
+{
+    // free all the old segments so that every particle starts at 0
+    _allParticles.Resize(0);
+    _allParticles.Resize(numParticles);
+    _sizeBytes = sizeof(Particle) * _allParticles.Capacity();
+    _numActiveParticles = 0;
+    _activeMask.Init(numParticles);
+    _expiryWheel.Init(EXPIRY_WHEEL_SLOTS);
+
+    // all particles start inactive, so all of them are free
+    // Note: Push them in reverse order so that the lowest indices are emitted first.
+    _freeIndices.clear();
+    _freeIndices.reserve(numParticles);
+    for (unsigned int particleIndex = numParticles; particleIndex > 0; particleIndex--)
+    {
+        _freeIndices.push_back(particleIndex - 1);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Grows or shrinks the storage at runtime without disturbing the particles that are kept.
+    - The pool allocates or frees whole segments at the end; kept particles don't move.
+    - The "active" mask keeps the bits of the kept particles.
+    - New particles are inactive, so their indices go on the "free index" stack.  They go 
+    underneath the existing free indices so that the lower ones are still emitted first.
+    - The free indices of particles that were cut off are dropped.  Active particles that were 
+    cut off are simply gone.
+    - The compacted active count is clamped to the new size.
+    - Scheduled expiries of particles that were cut off are dropped.
+    - If the OpenGL buffer exists (that is, Init(...) was called) and the number of segments 
+    changed, then the buffer is reallocated to fit them.  All the particles are uploaded every 
+    frame, so the old buffer contents are not copied.
+Parameters:
+    numParticles    The new size.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorage::Resize(unsigned int numParticles)
+{
+    unsigned int oldNumParticles = _allParticles.Size();
+    _allParticles.Resize(numParticles);
+    _activeMask.Resize(numParticles);
+    _expiryWheel.DropParticlesFrom(numParticles);
+    if (_numActiveParticles > numParticles)
+    {
+        _numActiveParticles = numParticles;
+    }
+
+    if (numParticles < oldNumParticles)
+    {
+        unsigned int numKept = 0;
+        for (size_t freeIndex = 0; freeIndex < _freeIndices.size(); freeIndex++)
+        {
+            if (_freeIndices[freeIndex] < numParticles)
+            {
+                _freeIndices[numKept] = _freeIndices[freeIndex];
+                numKept++;
+            }
+        }
+        _freeIndices.resize(numKept);
+    }
+    else if (numParticles > oldNumParticles)
+    {
+        // bottom of the stack is the front of the vector, and the highest new index goes on the 
+        // bottom
+        unsigned int numNewParticles = numParticles - oldNumParticles;
+        _freeIndices.reserve(numParticles);
+        _freeIndices.insert(_freeIndices.begin(), numNewParticles, 0);
+        for (unsigned int newIndex = 0; newIndex < numNewParticles; newIndex++)
+        {
+            _freeIndices[newIndex] = numParticles - 1 - newIndex;
+        }
+    }
+
+    unsigned int bufferSizeBytes = sizeof(Particle) * _allParticles.Capacity();
+    if (_arrayBufferId != 0 && bufferSizeBytes != _sizeBytes)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+        glBufferData(GL_ARRAY_BUFFER, bufferSizeBytes, 0, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    _sizeBytes = bufferSizeBytes;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sends the first N particles to the OpenGL buffer with one glBufferSubData(...) per pool 
+    segment.  The segments are laid out back to back in the buffer, so the buffer looks the same 
+    as if the particles were in one array, and a single draw call can draw them all.
+
+    Binds the array buffer and leaves it bound.
+Parameters:
+    numParticles    The size of the storage for the sparse updates, or the number of active 
+                    particles for the compacted update.  Clamped to the size of the storage.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorage::Upload(unsigned int numParticles) const
+{
+    unsigned int numRemaining = numParticles;
+    if (numRemaining > _allParticles.Size())
+    {
+        numRemaining = _allParticles.Size();
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+    unsigned int segmentSizeBytes = sizeof(Particle) * ParticlePool::PARTICLES_PER_SEGMENT;
+    for (unsigned int segmentIndex = 0; numRemaining > 0; segmentIndex++)
+    {
+        unsigned int numInSegment = numRemaining;
+        if (numInSegment > ParticlePool::PARTICLES_PER_SEGMENT)
+        {
+            numInSegment = ParticlePool::PARTICLES_PER_SEGMENT;
+        }
+
+        glBufferSubData(GL_ARRAY_BUFFER, segmentIndex * segmentSizeBytes, 
+            numInSegment * sizeof(Particle), _allParticles.SegmentData(segmentIndex));
+        numRemaining -= numInSegment;
+    }
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Particle.h"
+#include "ParticlePool.h"
+#include "ParticleActiveMask.h"
+#include "ParticleTimingWheel.h"
 #include <vector>
 
 /*-----------------------------------------------------------------------------------------------
@@ -19,6 +22,9 @@ struct ParticleStorage
 public:
     ParticleStorage();
     void Init(unsigned int programId, unsigned int numParticles);
+    void InitParticles(unsigned int numParticles);
+    void Resize(unsigned int numParticles);
+    void Upload(unsigned int numParticles) const;
 
     // save on the large header inclusion of OpenGL and write out these primitive types instead 
     // of using the OpenGL typedefs
@@ -27,7 +33,28 @@ public:
     unsigned int _vaoId;
     unsigned int _arrayBufferId;
     unsigned int _drawStyle;    // GL_TRIANGLES, GL_LINES, etc.
-    unsigned int _sizeBytes;    // useful for glBufferSubData(...)
-    std::vector<Particle> _allParticles;
+    unsigned int _sizeBytes;    // size of the buffer, which fits every segment of the pool
+
+    // segmented so that Resize(...) never moves existing particles (see ParticlePool)
+    ParticlePool _allParticles;
+
+    // one "is active" bit per particle; not used by ParticleUpdater::UpdateCompacted(...)
+    ParticleActiveMask _activeMask;
+
+    // a stack of the indices of all inactive particles
+    // Note: ParticleUpdater::Update(...) pushes the index of each particle that goes out of 
+    // bounds, and ParticleUpdater::Emit(...) pops them, so emission is O(1) per particle and 
+    // doesn't have to find inactive particles by scanning for them.  Space is reserved for 
+    // every particle during Init(...) and Resize(...), so pushing never allocates.
+    std::vector<unsigned int> _freeIndices;
+
+    // only used by ParticleUpdater::UpdateCompacted(...), which keeps all the active particles 
+    // packed into [0, _numActiveParticles) so that only those need to be updated, uploaded, and 
+    // drawn
+    unsigned int _numActiveParticles;
+
+    // only used by ParticleUpdater::UpdateScheduled(...), which files every particle under the 
+    // frame on which it will leave the region instead of checking it every frame
+    ParticleTimingWheel _expiryWheel;
 };
 
@@ -0,0 +1,204 @@
+#include "ParticleStorageAoSoA.h"
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+ParticleStorageAoSoA<BLOCK_SIZE>::ParticleStorageAoSoA() :
+    _vaoId(0),
+    _arrayBufferId(0),
+    _drawStyle(0),
+    _sizeBytes(0),
+    _numParticles(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the particle blocks and generates a vertex buffer and vertex array object for
+    them.
+
+    The vertex attributes use the separate "format" and "binding" calls (OpenGL 4.3) instead of
+    glVertexAttribPointer(...) so that drawing can move the buffer binding's start offset
+    without respecifying the attributes.  Each "vertex" is a whole block, position X is at the
+    start of the binding, and position Y is BLOCK_SIZE floats after it.
+Parameters:
+    programId       Program binding is required for vertex attributes.
+    numParticles    New memory is allocated to fit this number of particles.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+void ParticleStorageAoSoA<BLOCK_SIZE>::Init(unsigned int programId, unsigned int numParticles)
+{
+    InitParticles(numParticles);
+    _drawStyle = GL_POINTS;
+
+    // MUST bind the program beforehand or else the VAO generation and binding will blow up
+    glUseProgram(programId);
+
+    glGenVertexArrays(1, &_vaoId);
+    glGenBuffers(1, &_arrayBufferId);
+    glBindVertexArray(_vaoId);
+    glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+
+    // just allocate space now, and send updated data at render time
+    glBufferData(GL_ARRAY_BUFFER, _sizeBytes, 0, GL_DYNAMIC_DRAW);
+
+    // both position attributes read from vertex buffer binding 0
+    unsigned int bindingIndex = 0;
+
+    // position X
+    unsigned int vertexArrayIndex = 0;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribFormat(vertexArrayIndex, 1, GL_FLOAT, GL_FALSE, 0);
+    glVertexAttribBinding(vertexArrayIndex, bindingIndex);
+
+    // position Y
+    vertexArrayIndex++;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribFormat(vertexArrayIndex, 1, GL_FLOAT, GL_FALSE, sizeof(Block::_positionX));
+    glVertexAttribBinding(vertexArrayIndex, bindingIndex);
+
+    // velocity is not sent to the shader
+
+    // start on lane 0; Display() moves this for each lane
+    glBindVertexBuffer(bindingIndex, _arrayBufferId, 0, sizeof(Block));
+
+    // cleanup
+    glBindVertexArray(0);   // unbind this BEFORE the array
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);    // always last
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the particle blocks, the "active" mask, and the "free index" stack without
+    touching OpenGL.  Init(...) calls this, and the benchmarks call it directly.
+
+    If the number of particles is not a multiple of the block size, then the last block has a
+    few unused lanes at the end.  They are never activated and are never drawn.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+void ParticleStorageAoSoA<BLOCK_SIZE>::InitParticles(unsigned int numParticles)
+{
+    _numParticles = numParticles;
+
+    // round up, and value-initialize so that everything starts at 0
+    unsigned int numBlocks = (numParticles + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    _blocks.assign(numBlocks, Block());
+    _sizeBytes = sizeof(Block) * numBlocks;
+
+    _activeMask.Init(numParticles);
+
+    // all particles start inactive, so all of them are free (lowest index on top)
+    _freeIndices.clear();
+    _freeIndices.reserve(numParticles);
+    for (unsigned int particleIndex = numParticles; particleIndex > 0; particleIndex--)
+    {
+        _freeIndices.push_back(particleIndex - 1);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles (not the number of blocks).
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+unsigned int ParticleStorageAoSoA<BLOCK_SIZE>::Size() const
+{
+    return _numParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Every block has a particle in lane 0, but if the last block is partial, then it doesn't
+    have particles in the last few lanes.  This tells the draw call how many vertices to draw
+    for a lane so that the unused lanes are not drawn.
+Parameters:
+    laneIndex   On the range [0, BLOCK_SIZE).
+Returns:
+    The number of blocks that have a particle in the given lane.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+unsigned int ParticleStorageAoSoA<BLOCK_SIZE>::NumParticlesInLane(
+    const unsigned int laneIndex) const
+{
+    if (laneIndex >= _numParticles)
+    {
+        return 0;
+    }
+
+    // particles laneIndex, laneIndex + BLOCK_SIZE, laneIndex + 2 * BLOCK_SIZE, ...
+    return (_numParticles - laneIndex + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Scatters a Particle structure's members into the particle's block.  The emitters work with
+    Particle structures, so this is how emitted particles get into the storage.
+Parameters:
+    particleIndex   Self-explanatory.
+    p               The new position and velocity.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+void ParticleStorageAoSoA<BLOCK_SIZE>::SetParticle(const unsigned int particleIndex,
+    const Particle &p)
+{
+    Block &block = _blocks[particleIndex / BLOCK_SIZE];
+    unsigned int laneIndex = particleIndex % BLOCK_SIZE;
+    block._positionX[laneIndex] = p._position.x;
+    block._positionY[laneIndex] = p._position.y;
+    block._velocityX[laneIndex] = p._velocity.x;
+    block._velocityY[laneIndex] = p._velocity.y;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gathers a particle's members from its block into a Particle structure.
+Parameters:
+    particleIndex   Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+Particle ParticleStorageAoSoA<BLOCK_SIZE>::GetParticle(const unsigned int particleIndex) const
+{
+    const Block &block = _blocks[particleIndex / BLOCK_SIZE];
+    unsigned int laneIndex = particleIndex % BLOCK_SIZE;
+    Particle p;
+    p._position.x = block._positionX[laneIndex];
+    p._position.y = block._positionY[laneIndex];
+    p._velocity.x = block._velocityX[laneIndex];
+    p._velocity.y = block._velocityY[laneIndex];
+    return p;
+}
+
+// the only block sizes that anyone should want: one AVX register or one AVX-512 register
+template struct ParticleStorageAoSoA<8>;
+template struct ParticleStorageAoSoA<16>;
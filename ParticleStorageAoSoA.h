@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Particle.h"
+#include "AlignedAllocator.h"
+#include "ParticleActiveMask.h"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A small "structure of arrays" for a fixed number of particles: all of the block's X
+    positions, then all of the Y positions, then the X velocities, then the Y velocities.
+
+    With 8 particles per block, each array is 32 bytes (one AVX register), and the whole block
+    is 128 bytes (two cache lines), so all the members of a particle are on at most two cache
+    lines.  With 16 particles per block, each array is one AVX-512 register and the block is
+    four cache lines.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+struct ParticleBlock
+{
+    float _positionX[BLOCK_SIZE];
+    float _positionY[BLOCK_SIZE];
+    float _velocityX[BLOCK_SIZE];
+    float _velocityY[BLOCK_SIZE];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    An "array of structures of arrays" alternative to ParticleStorage and ParticleStorageSoA.
+    The particles are kept in fixed-size blocks (see ParticleBlock), so a loop over a block
+    works on one SIMD register's worth of each member, and a region or emitter that needs every
+    member of a particle finds them all close together.
+
+    The block size is a template argument so that it can be chosen to match the SIMD width.
+    Only 8 and 16 are instantiated (see the bottom of the .cpp), and they must divide 64 so that
+    blocks never straddle a chunk of the "active" mask.
+
+    The whole block array is uploaded to the GPU, and the particles are drawn one "lane" at a
+    time (all the particle 0s of every block, then all the particle 1s, etc.) by moving the
+    start of the vertex buffer binding by one float for each lane.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+struct ParticleStorageAoSoA
+{
+public:
+    static_assert(64 % BLOCK_SIZE == 0, "particle blocks must not straddle active mask chunks");
+    typedef ParticleBlock<BLOCK_SIZE> Block;
+
+    ParticleStorageAoSoA();
+    void Init(unsigned int programId, unsigned int numParticles);
+    void InitParticles(unsigned int numParticles);
+    unsigned int Size() const;
+    unsigned int NumParticlesInLane(const unsigned int laneIndex) const;
+
+    void SetParticle(const unsigned int particleIndex, const Particle &p);
+    Particle GetParticle(const unsigned int particleIndex) const;
+
+    // see ParticleStorage for why these are primitive types
+    unsigned int _vaoId;
+    unsigned int _arrayBufferId;
+    unsigned int _drawStyle;    // GL_POINTS
+    unsigned int _sizeBytes;    // the whole block array
+
+    unsigned int _numParticles;
+    std::vector<Block, AlignedAllocator<Block>> _blocks;
+
+    // same story as ParticleStorage
+    ParticleActiveMask _activeMask;
+    std::vector<unsigned int> _freeIndices;
+};
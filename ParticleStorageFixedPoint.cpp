@@ -0,0 +1,116 @@
+#include "ParticleStorageFixedPoint.h"
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleStorageFixedPoint::ParticleStorageFixedPoint() :
+    _vaoId(0),
+    _arrayBufferId(0),
+    _drawStyle(0),
+    _sizeBytes(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates a vertex buffer and vertex array object for the fixed-point particles.
+
+    The attributes are GL_SHORT with "normalize" turned on, so the GPU divides each value by 
+    32767 as it fetches it and the shader gets the same floats that the float storages send.  
+    That is exact for position.  Velocity arrives at half its real value (16384 is 1.0 per 
+    second), but the shader doesn't use velocity.
+Parameters:
+    programId       Program binding is required for vertex attributes.
+    numParticles    New memory is allocated to fit this number of particles.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageFixedPoint::Init(unsigned int programId, unsigned int numParticles)
+{
+    InitParticles(numParticles);
+    _drawStyle = GL_POINTS;
+
+    // MUST bind the program beforehand or else the VAO generation and binding will blow up
+    glUseProgram(programId);
+
+    glGenVertexArrays(1, &_vaoId);
+    glGenBuffers(1, &_arrayBufferId);
+    glBindVertexArray(_vaoId);
+    glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+
+    // just allocate space now, and send updated data at render time
+    glBufferData(GL_ARRAY_BUFFER, _sizeBytes, 0, GL_DYNAMIC_DRAW);
+
+    unsigned int vertexArrayIndex = 0;
+    unsigned int bufferStartOffset = 0;
+    unsigned int bytesPerStep = sizeof(ParticleFixedPoint);
+
+    // position X
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 1, GL_SHORT, GL_TRUE, bytesPerStep, (void *)bufferStartOffset);
+
+    // position Y
+    bufferStartOffset += sizeof(short);
+    vertexArrayIndex++;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 1, GL_SHORT, GL_TRUE, bytesPerStep, (void *)bufferStartOffset);
+
+    // velocity
+    bufferStartOffset += sizeof(short);
+    vertexArrayIndex++;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 2, GL_SHORT, GL_TRUE, bytesPerStep, (void *)bufferStartOffset);
+
+    // cleanup
+    glBindVertexArray(0);   // unbind this BEFORE the array
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);    // always last
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the particles, the "active" mask, and the "free index" stack without touching 
+    OpenGL.  Init(...) calls this, and the benchmarks call it directly.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageFixedPoint::InitParticles(unsigned int numParticles)
+{
+    ParticleFixedPoint zero = { 0, 0, 0, 0 };
+    _allParticles.assign(numParticles, zero);
+    _sizeBytes = sizeof(ParticleFixedPoint) * numParticles;
+    _activeMask.Init(numParticles);
+
+    // lowest index on top
+    _freeIndices.clear();
+    _freeIndices.reserve(numParticles);
+    for (unsigned int particleIndex = numParticles; particleIndex > 0; particleIndex--)
+    {
+        _freeIndices.push_back(particleIndex - 1);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleStorageFixedPoint::Size() const
+{
+    return _allParticles.size();
+}
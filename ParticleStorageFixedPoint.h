@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ParticleFixedPoint.h"
+#include "ParticleActiveMask.h"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A fixed-point alternative to ParticleStorage.  Each particle is an 8-byte 
+    ParticleFixedPoint instead of a 16-byte Particle, which halves the bytes that the updater 
+    reads and writes and that are uploaded every frame.
+
+    Otherwise the same as ParticleStorage: an "active" mask, a "free index" stack, and one 
+    interleaved OpenGL buffer that is uploaded all at once.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleStorageFixedPoint
+{
+public:
+    ParticleStorageFixedPoint();
+    void Init(unsigned int programId, unsigned int numParticles);
+    void InitParticles(unsigned int numParticles);
+    unsigned int Size() const;
+
+    // see ParticleStorage for why these are primitive types
+    unsigned int _vaoId;
+    unsigned int _arrayBufferId;
+    unsigned int _drawStyle;    // GL_POINTS
+    unsigned int _sizeBytes;
+
+    std::vector<ParticleFixedPoint> _allParticles;
+
+    // same story as ParticleStorage
+    ParticleActiveMask _activeMask;
+    std::vector<unsigned int> _freeIndices;
+};
@@ -0,0 +1,144 @@
+#include "ParticleStorageRing.h"
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleStorageRing::ParticleStorageRing() :
+    _vaoId(0),
+    _arrayBufferId(0),
+    _drawStyle(0),
+    _sizeBytes(0),
+    _tailIndex(0),
+    _numLive(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates a vertex buffer and vertex array object for the ring.  The buffer mirrors the 
+    ring (particle N is at the same place in both), so the live ranges can be uploaded and 
+    drawn without moving anything.  The vertex attributes are the same as ParticleStorage.
+Parameters:
+    programId       Program binding is required for vertex attributes.
+    numParticles    New memory is allocated to fit this number of particles.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageRing::Init(unsigned int programId, unsigned int numParticles)
+{
+    InitParticles(numParticles);
+    _drawStyle = GL_POINTS;
+
+    // MUST bind the program beforehand or else the VAO generation and binding will blow up
+    glUseProgram(programId);
+
+    glGenVertexArrays(1, &_vaoId);
+    glGenBuffers(1, &_arrayBufferId);
+    glBindVertexArray(_vaoId);
+    glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+
+    // just allocate space now, and send updated data at render time
+    glBufferData(GL_ARRAY_BUFFER, _sizeBytes, 0, GL_DYNAMIC_DRAW);
+
+    unsigned int vertexArrayIndex = 0;
+    unsigned int bufferStartOffset = 0;
+    unsigned int bytesPerStep = sizeof(Particle);
+
+    // position X
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 1, GL_FLOAT, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
+
+    // position Y
+    bufferStartOffset += sizeof(float);
+    vertexArrayIndex++;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 1, GL_FLOAT, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
+
+    // velocity
+    bufferStartOffset = sizeof(Particle::_position);
+    vertexArrayIndex++;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 2, GL_FLOAT, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
+
+    // cleanup
+    glBindVertexArray(0);   // unbind this BEFORE the array
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);    // always last
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the ring without touching OpenGL and empties it.  Init(...) calls this, and the 
+    benchmarks call it directly.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageRing::InitParticles(unsigned int numParticles)
+{
+    _allParticles.assign(numParticles, Particle());
+    _lifetimeRemainingSec.assign(numParticles, 0.0f);
+    _sizeBytes = sizeof(Particle) * numParticles;
+    _tailIndex = 0;
+    _numLive = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles that the ring can hold.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleStorageRing::Size() const
+{
+    return _allParticles.size();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Splits the live part of the ring into contiguous index ranges: one if it doesn't wrap 
+    around the end of the buffer, two if it does (tail to the end, then the start to the 
+    head), and none if nothing is live.
+Parameters:
+    firstIndices    Receives the first index of each range.
+    counts          Receives the number of particles in each range.
+Returns:
+    The number of ranges (0, 1, or 2).
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleStorageRing::LiveRanges(unsigned int firstIndices[2], 
+    unsigned int counts[2]) const
+{
+    if (_numLive == 0)
+    {
+        return 0;
+    }
+
+    unsigned int capacity = _allParticles.size();
+    unsigned int numBeforeWrap = capacity - _tailIndex;
+    firstIndices[0] = _tailIndex;
+    if (_numLive <= numBeforeWrap)
+    {
+        counts[0] = _numLive;
+        return 1;
+    }
+
+    counts[0] = numBeforeWrap;
+    firstIndices[1] = 0;
+    counts[1] = _numLive - numBeforeWrap;
+    return 2;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Particle.h"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A first-in, first-out ring buffer of particles for emitters whose particles have a fixed 
+    lifetime (see ParticleUpdater::AddEmitter(...)).  New particles are appended at the head, 
+    and particles only ever leave from the tail, so both are O(1), and the live particles are 
+    always one contiguous range, or two if the range wraps around the end of the buffer.  Only 
+    those ranges are updated, uploaded, and drawn.
+
+    Particles that die before they reach the tail (they left the region, or they came from an 
+    emitter with a shorter lifetime than the particles ahead of them) are "parked": moved off 
+    screen, stopped, and marked as dead.  They stay in the live range until they reach the 
+    tail.  If every emitter has the same lifetime and nothing leaves the region, then nothing 
+    is ever parked.
+
+    There is no "active" mask or "free index" stack; a particle is live if and only if it is in 
+    the live range.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleStorageRing
+{
+public:
+    ParticleStorageRing();
+    void Init(unsigned int programId, unsigned int numParticles);
+    void InitParticles(unsigned int numParticles);
+    unsigned int Size() const;
+    unsigned int LiveRanges(unsigned int firstIndices[2], unsigned int counts[2]) const;
+
+    // see ParticleStorage for why these are primitive types
+    unsigned int _vaoId;
+    unsigned int _arrayBufferId;
+    unsigned int _drawStyle;    // GL_POINTS
+    unsigned int _sizeBytes;
+
+    std::vector<Particle> _allParticles;
+
+    // seconds until each particle dies; 0 or less means dead (expired or parked)
+    // Note: A countdown instead of a death time means that there is no clock to lose float 
+    // precision as the program runs.
+    std::vector<float> _lifetimeRemainingSec;
+
+    // oldest live particle, and how many particles from there (wrapping) are live
+    unsigned int _tailIndex;
+    unsigned int _numLive;
+};
@@ -0,0 +1,114 @@
+#include "ParticleStorageSoA.h"
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleStorageSoA::ParticleStorageSoA() :
+    _vaoId(0),
+    _arrayBufferId(0),
+    _drawStyle(0),
+    _positionSizeBytes(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates all the particle arrays and generates a vertex buffer and vertex array object for
+    the particle positions.
+
+    The buffer holds all the X positions followed by all the Y positions, so the X and Y
+    vertex attributes are each a tightly packed float array with different starting offsets.
+Parameters:
+    programId       Program binding is required for vertex attributes.
+    numParticles    New memory is allocated to fit this number of particles.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageSoA::Init(unsigned int programId, unsigned int numParticles)
+{
+    InitParticles(numParticles);
+    _drawStyle = GL_POINTS;
+
+    // MUST bind the program beforehand or else the VAO generation and binding will blow up
+    glUseProgram(programId);
+
+    glGenVertexArrays(1, &_vaoId);
+    glGenBuffers(1, &_arrayBufferId);
+    glBindVertexArray(_vaoId);
+    glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+
+    // just allocate space for X and Y now, and send updated data at render time
+    glBufferData(GL_ARRAY_BUFFER, _positionSizeBytes * 2, 0, GL_DYNAMIC_DRAW);
+
+    // position X is attribute 0 and starts at the beginning of the buffer
+    // position Y is attribute 1 and starts right after the last X
+    // Note: A stride of 0 tells OpenGL that the items are tightly packed.
+    unsigned int vertexArrayIndex = 0;
+    unsigned int bufferStartOffset = 0;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 1, GL_FLOAT, GL_FALSE, 0, (void *)bufferStartOffset);
+
+    vertexArrayIndex++;
+    bufferStartOffset += _positionSizeBytes;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 1, GL_FLOAT, GL_FALSE, 0, (void *)bufferStartOffset);
+
+    // velocity is not sent to the GPU because the shader doesn't use it
+
+    // cleanup
+    glBindVertexArray(0);   // unbind this BEFORE the array
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);    // always last
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates all the particle arrays, the "active" mask, and the "free index" stack without 
+    touching OpenGL.  Init(...) calls this, and the benchmarks call it directly.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageSoA::InitParticles(unsigned int numParticles)
+{
+    // everything starts at 0 and inactive
+    _positionX.assign(numParticles, 0.0f);
+    _positionY.assign(numParticles, 0.0f);
+    _velocityX.assign(numParticles, 0.0f);
+    _velocityY.assign(numParticles, 0.0f);
+    _activeMask.Init(numParticles);
+    _positionSizeBytes = sizeof(float) * numParticles;
+
+    // all particles start inactive, so all of them are free (lowest index on top)
+    _freeIndices.clear();
+    _freeIndices.reserve(numParticles);
+    for (unsigned int particleIndex = numParticles; particleIndex > 0; particleIndex--)
+    {
+        _freeIndices.push_back(particleIndex - 1);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles.  All arrays are the same size, so just ask
+    one of them.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleStorageSoA::Size() const
+{
+    return _positionX.size();
+}
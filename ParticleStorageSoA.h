@@ -0,0 +1,49 @@
+#pragma once
+
+#include "AlignedAllocator.h"
+#include "ParticleActiveMask.h"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A "structure of arrays" alternative to ParticleStorage.  Instead of one array of Particle
+    structures, each particle member gets its own array, so a loop that only needs positions
+    only pulls positions into the cache.  Each array starts on a 64-byte boundary so that the
+    integration loop can be vectorized without worrying about the start of the array.
+
+    Only the positions are sent to the GPU (the particle shader doesn't use velocity), and they
+    are sent as two back-to-back arrays in the same buffer: all X values followed by all Y
+    values.
+
+    Like ParticleStorage, this is a struct with public members so that the ParticleUpdater and
+    the particle emitters can get at the arrays.  Be nice and don't resize them.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleStorageSoA
+{
+public:
+    typedef std::vector<float, AlignedAllocator<float>> FloatArray;
+
+    ParticleStorageSoA();
+    void Init(unsigned int programId, unsigned int numParticles);
+    void InitParticles(unsigned int numParticles);
+    unsigned int Size() const;
+
+    // save on the large header inclusion of OpenGL and write out these primitive types instead
+    // of using the OpenGL typedefs
+    unsigned int _vaoId;
+    unsigned int _arrayBufferId;
+    unsigned int _drawStyle;            // GL_POINTS
+    unsigned int _positionSizeBytes;    // size of one position array (X or Y)
+
+    FloatArray _positionX;
+    FloatArray _positionY;
+    FloatArray _velocityX;
+    FloatArray _velocityY;
+
+    // same story as ParticleStorage::_activeMask
+    ParticleActiveMask _activeMask;
+
+    // same story as ParticleStorage::_freeIndices
+    std::vector<unsigned int> _freeIndices;
+};
@@ -0,0 +1,208 @@
+#include "ParticleStorageStateless.h"
+
+#include "glload/include/glload/gl_4_4.h"
+
+#include <algorithm>    // for std::sort
+
+// at the demo's 100 updates per second, this covers about 10 seconds (see ParticleStorage)
+static const unsigned int EXPIRY_WHEEL_SLOTS = 1024;
+
+// if the spawned slots are scattered over more runs than this, then UploadSpawned() sends
+// everything from the first to the last instead of one small upload per run
+static const unsigned int MAX_UPLOAD_RUNS = 32;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleStorageStateless::ParticleStorageStateless() :
+    _vaoId(0),
+    _arrayBufferId(0),
+    _drawStyle(0),
+    _sizeBytes(0),
+    _numActiveParticles(0),
+    _tickSec(0.0f)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates a vertex buffer and vertex array object for the spawn records and uploads all of
+    them once.  After this, only UploadSpawned() touches the buffer.
+
+    The attributes are not the same as ParticleStorage's, so this must be given the program
+    for shaderParticleStateless.vert.
+Parameters:
+    programId       Program binding is required for vertex attributes.
+    numParticles    New memory is allocated to fit this number of particles.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageStateless::Init(unsigned int programId, unsigned int numParticles)
+{
+    InitParticles(numParticles);
+    _drawStyle = GL_POINTS;
+
+    // MUST bind the program beforehand or else the VAO generation and binding will blow up
+    glUseProgram(programId);
+
+    glGenVertexArrays(1, &_vaoId);
+    glGenBuffers(1, &_arrayBufferId);
+    glBindVertexArray(_vaoId);
+    glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+
+    // every slot starts out expired, so upload them all now and never again
+    glBufferData(GL_ARRAY_BUFFER, _sizeBytes, _allParticles.data(), GL_DYNAMIC_DRAW);
+    _spawnedIndices.clear();
+
+    unsigned int bytesPerStep = sizeof(ParticleSpawn);
+
+    // spawn position
+    unsigned int vertexArrayIndex = 0;
+    unsigned int bufferStartOffset = 0;
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 2, GL_FLOAT, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
+
+    // velocity
+    vertexArrayIndex++;
+    bufferStartOffset += sizeof(ParticleSpawn::_spawnPosition);
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribPointer(vertexArrayIndex, 2, GL_FLOAT, GL_FALSE, bytesPerStep, (void *)bufferStartOffset);
+
+    // spawn tick and expiry tick
+    // Note: The "I" version keeps them as integers instead of converting them to floats.
+    vertexArrayIndex++;
+    bufferStartOffset += sizeof(ParticleSpawn::_velocity);
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribIPointer(vertexArrayIndex, 1, GL_UNSIGNED_INT, bytesPerStep, (void *)bufferStartOffset);
+
+    vertexArrayIndex++;
+    bufferStartOffset += sizeof(ParticleSpawn::_spawnTick);
+    glEnableVertexAttribArray(vertexArrayIndex);
+    glVertexAttribIPointer(vertexArrayIndex, 1, GL_UNSIGNED_INT, bytesPerStep, (void *)bufferStartOffset);
+
+    // cleanup
+    glBindVertexArray(0);   // unbind this BEFORE the array
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);    // always last
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the spawn records, the "free index" stack, and the timing wheel without touching
+    OpenGL.  Every slot starts free and already expired (spawned on tick 0, expired on tick 1),
+    so the shader hides it until something is spawned into it.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleStorageStateless::InitParticles(unsigned int numParticles)
+{
+    ParticleSpawn expired;
+    expired._spawnPosition = glm::vec2(-10.0f, -10.0f);
+    expired._velocity = glm::vec2(0.0f, 0.0f);
+    expired._spawnTick = 0;
+    expired._expiryTick = 1;
+    _allParticles.assign(numParticles, expired);
+    _sizeBytes = sizeof(ParticleSpawn) * numParticles;
+
+    // push in reverse order so that the lowest indices are spawned first
+    _freeIndices.clear();
+    _freeIndices.reserve(numParticles);
+    for (unsigned int particleIndex = numParticles; particleIndex > 0; particleIndex--)
+    {
+        _freeIndices.push_back(particleIndex - 1);
+    }
+
+    _expiryWheel.Init(EXPIRY_WHEEL_SLOTS);
+    _numActiveParticles = 0;
+    _spawnedIndices.clear();
+    _spawnedIndices.reserve(numParticles);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particle slots.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleStorageStateless::Size() const
+{
+    return _allParticles.size();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sends the spawn records of the slots that were spawned into since the last call, and only
+    those.  The slots are sorted and merged into contiguous runs with one glBufferSubData(...)
+    each, unless there are so many runs that one upload of the whole span is cheaper.
+Parameters: None
+Returns:
+    The number of spawn records that were uploaded.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleStorageStateless::UploadSpawned()
+{
+    if (_spawnedIndices.empty())
+    {
+        return 0;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _arrayBufferId);
+    std::sort(_spawnedIndices.begin(), _spawnedIndices.end());
+
+    // count the runs first to decide how to upload
+    // Note: The same slot can be in the list twice if it expired and was spawned into again
+    // before an upload.  Equal neighbors are part of the same run.
+    unsigned int numRuns = 1;
+    for (size_t spawnedIndex = 1; spawnedIndex < _spawnedIndices.size(); spawnedIndex++)
+    {
+        if (_spawnedIndices[spawnedIndex] > _spawnedIndices[spawnedIndex - 1] + 1)
+        {
+            numRuns++;
+        }
+    }
+
+    unsigned int numUploaded = 0;
+    if (numRuns > MAX_UPLOAD_RUNS)
+    {
+        unsigned int firstIndex = _spawnedIndices.front();
+        unsigned int count = _spawnedIndices.back() - firstIndex + 1;
+        glBufferSubData(GL_ARRAY_BUFFER, firstIndex * sizeof(ParticleSpawn),
+            count * sizeof(ParticleSpawn), &_allParticles[firstIndex]);
+        numUploaded = count;
+    }
+    else
+    {
+        size_t runStart = 0;
+        for (size_t spawnedIndex = 1; spawnedIndex <= _spawnedIndices.size(); spawnedIndex++)
+        {
+            if (spawnedIndex < _spawnedIndices.size() &&
+                _spawnedIndices[spawnedIndex] <= _spawnedIndices[spawnedIndex - 1] + 1)
+            {
+                continue;
+            }
+
+            unsigned int firstIndex = _spawnedIndices[runStart];
+            unsigned int count = _spawnedIndices[spawnedIndex - 1] - firstIndex + 1;
+            glBufferSubData(GL_ARRAY_BUFFER, firstIndex * sizeof(ParticleSpawn),
+                count * sizeof(ParticleSpawn), &_allParticles[firstIndex]);
+            numUploaded += count;
+            runStart = spawnedIndex;
+        }
+    }
+
+    _spawnedIndices.clear();
+    return numUploaded;
+}
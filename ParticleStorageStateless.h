@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ParticleTimingWheel.h"
+#include "glm/vec2.hpp"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Everything that the GPU needs to know about a particle to draw it on any frame of its life.
+    Particles move in a straight line at constant velocity, so the vertex shader
+    (shaderParticleStateless.vert) works out where the particle is now from where and when it
+    was spawned, and hides it once its expiry frame comes.
+
+    Times are in frames ("ticks" of ParticleTimingWheel) instead of seconds so that there is no
+    float clock to lose precision as the program runs.  An expiry tick equal to the spawn tick
+    means "never expires".
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleSpawn
+{
+    glm::vec2 _spawnPosition;
+    glm::vec2 _velocity;
+    unsigned int _spawnTick;
+    unsigned int _expiryTick;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Particle storage for drawing with no per-frame CPU simulation.  The CPU only emits (see
+    ParticleUpdater::UpdateStateless(...)): each new particle's ParticleSpawn is written once,
+    its slot is marked dirty, and UploadSpawned(...) sends only the dirty slots.  Nothing is
+    integrated and nothing is uploaded for particles that are just flying along.  When a
+    particle leaves the region, the shader has already hidden it, so freeing its slot doesn't
+    need an upload either.
+
+    The slots are recycled with the same "free index" stack as ParticleStorage, and particles
+    are retired on the frame that they leave the region with the same timing wheel as
+    ParticleUpdater::UpdateScheduled(...).
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleStorageStateless
+{
+public:
+    ParticleStorageStateless();
+    void Init(unsigned int programId, unsigned int numParticles);
+    void InitParticles(unsigned int numParticles);
+    unsigned int Size() const;
+    unsigned int UploadSpawned();
+
+    // see ParticleStorage for why these are primitive types
+    unsigned int _vaoId;
+    unsigned int _arrayBufferId;
+    unsigned int _drawStyle;    // GL_POINTS
+    unsigned int _sizeBytes;
+
+    std::vector<ParticleSpawn> _allParticles;
+    std::vector<unsigned int> _freeIndices;
+    ParticleTimingWheel _expiryWheel;
+    unsigned int _numActiveParticles;
+
+    // the slots that were spawned into since the last upload
+    std::vector<unsigned int> _spawnedIndices;
+
+    // the length of a tick, for the shader; set by the updater every frame
+    float _tickSec;
+};
@@ -0,0 +1,763 @@
+#include "ParticleTaskScheduler.h"
+
+#include "RandomToast.h"
+
+#include <stdio.h>
+
+// the scheduler whose worker this thread is, if any, and which worker; set by WorkerLoop(...) 
+// for the worker threads and by ParallelFor(...) for the thread that calls it, so that a call 
+// from inside a task knows which deque is its own
+static thread_local ParticleTaskScheduler *thisThreadScheduler = 0;
+static thread_local unsigned int thisThreadWorkerIndex = 0;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives the object its task.  It starts out with no ranges, so it is done.
+Parameters:
+    task        Called once for each range.  Must be safe to call on several threads at once, 
+                and must outlive the group.
+    grainSize   The biggest range that the task is called with.  0 is treated as 1.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleTaskGroup::ParticleTaskGroup(const ParticleRangeTask &task, 
+    const unsigned int grainSize) :
+    _pTask(&task),
+    _grainSize((grainSize == 0) ? 1 : grainSize),
+    _numItemsLeft(0),
+    _inParallelFor(false)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks whether every item that was spawned in the group so far has been run.  Doesn't 
+    wait.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleTaskGroup::Done() const
+{
+    return _numItemsLeft.load() == 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.  There are no worker threads
+    until Init(...).
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleTaskScheduler::ParticleTaskScheduler() :
+    _stealing(true),
+    _numQueuedRanges(0),
+    _numSleeping(0),
+    _quit(false),
+    _nextSpawnWorker(0),
+    _parallelSec(0.0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Stops the worker threads.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleTaskScheduler::~ParticleTaskScheduler()
+{
+    Shutdown();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes the workers and starts their threads.  Any that were already running are stopped
+    first.  The stats start at 0.
+Parameters:
+    numThreads  The number of workers, including the thread that calls ParallelFor(...), so 1
+                makes no threads.  0 means one per hardware thread.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::Init(const unsigned int numThreads)
+{
+    Shutdown();
+
+    unsigned int numWorkers = numThreads;
+    if (numWorkers == 0)
+    {
+        // may be 0 if it can't tell
+        numWorkers = std::thread::hardware_concurrency();
+        numWorkers = (numWorkers == 0) ? 1 : numWorkers;
+    }
+
+    for (unsigned int workerIndex = 0; workerIndex < numWorkers; workerIndex++)
+    {
+        std::unique_ptr<Worker> pWorker(new Worker());
+        pWorker->_timer.Init();
+        pWorker->_taskDepth = 0;
+        pWorker->_callDepth = 0;
+        pWorker->_callTimer.Init();
+
+        // any odd number will do for xorshift as long as it isn't 0
+        pWorker->_randomState = (workerIndex * 0x9E3779B9u) | 1;
+        _workers.push_back(std::move(pWorker));
+    }
+    ResetStats();
+
+    _quit = false;
+    for (unsigned int workerIndex = 1; workerIndex < numWorkers; workerIndex++)
+    {
+        _threads.push_back(std::thread(&ParticleTaskScheduler::WorkerLoop, this, workerIndex));
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Tells the worker threads to quit, waits for them, and gets rid of the workers.  Must not be
+    called during ParallelFor(...) or while spawned ranges are left, so the deques are empty.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (size_t threadIndex = 0; threadIndex < _threads.size(); threadIndex++)
+    {
+        _threads[threadIndex].join();
+    }
+    _threads.clear();
+    _workers.clear();
+    _numQueuedRanges.store(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of workers, including the calling thread.  Before Init(...),
+    the calling thread is the only one.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleTaskScheduler::NumWorkers() const
+{
+    return _workers.empty() ? 1 : _workers.size();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Turns stealing on or off.  With it off, each worker only runs the share that
+    ParallelFor(...) gave it (and the ranges of calls that it made itself from inside a task).  
+    Must not be called during ParallelFor(...).
+Parameters:
+    stealing    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::SetStealing(const bool stealing)
+{
+    _stealing.store(stealing);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for whether idle workers steal.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleTaskScheduler::Stealing() const
+{
+    return _stealing.load();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs the task over every item in [begin, end), in ranges no bigger than the grain size,
+    spread over the workers, and returns when all of them are done.  Which worker runs which
+    range is not fixed, so tasks must not depend on that for anything but scratch space.
+
+    May be called from inside a task or on a worker thread (see the class description).  
+    Otherwise, it must only be called from one thread at a time, because that thread acts as 
+    worker 0.
+Parameters:
+    begin       The first item.
+    end         One past the last item.
+    grainSize   The biggest range that the task is called with.  0 is treated as 1.
+    task        Called once for each range.  Must be safe to call on several threads at once.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::ParallelFor(const unsigned int begin, const unsigned int end,
+    const unsigned int grainSize, const ParticleRangeTask &task)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+
+    ParticleTaskGroup group(task, grainSize);
+    if (_workers.empty())
+    {
+        // not initialized; just run it here
+        for (unsigned int rangeBegin = begin; rangeBegin < end; rangeBegin += group._grainSize)
+        {
+            unsigned int rangeEnd = (end - rangeBegin > group._grainSize) ? 
+                rangeBegin + group._grainSize : end;
+            task(rangeBegin, rangeEnd, 0);
+        }
+        return;
+    }
+
+    // a thread that isn't a worker's own is worker 0 until this returns
+    ParticleTaskScheduler *pOuterScheduler = thisThreadScheduler;
+    unsigned int outerWorkerIndex = thisThreadWorkerIndex;
+    if (thisThreadScheduler != this)
+    {
+        thisThreadScheduler = this;
+        thisThreadWorkerIndex = 0;
+    }
+    unsigned int workerIndex = thisThreadWorkerIndex;
+
+    // calls inside another call (or its ranges) aren't timed so that they aren't counted twice
+    Worker &worker = *_workers[workerIndex];
+    bool timed = (worker._taskDepth == 0) && (worker._callDepth == 0);
+    if (timed)
+    {
+        worker._callTimer.Start();
+    }
+    worker._callDepth++;
+
+    // give each worker an even share to start with, except that a worker thread leaves out 
+    // worker 0, whose thread may be off doing something else
+    unsigned int numItems = end - begin;
+    group._numItemsLeft.store(numItems);
+    group._inParallelFor = true;
+    unsigned int firstShareWorker = (workerIndex == 0) ? 0 : 1;
+    unsigned long long numShares = _workers.size() - firstShareWorker;
+    for (unsigned int shareIndex = 0; shareIndex < numShares; shareIndex++)
+    {
+        Range share;
+        share._pGroup = &group;
+        share._begin = begin + (unsigned int)((numItems * shareIndex) / numShares);
+        share._end = begin + (unsigned int)((numItems * (shareIndex + 1ULL)) / numShares);
+        if (share._end > share._begin)
+        {
+            PushRange(firstShareWorker + shareIndex, share);
+        }
+    }
+    WakeSleepers();
+
+    // the group can't be let go until every item is done
+    HelpUntilDone(workerIndex, group);
+
+    worker._callDepth--;
+    if (timed)
+    {
+        double callSec = worker._callTimer.Lap();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _parallelSec += callSec;
+    }
+    thisThreadScheduler = pOuterScheduler;
+    thisThreadWorkerIndex = outerWorkerIndex;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Adds the items [begin, end) to a group and hands them to the workers without waiting for 
+    them.  On a worker thread, they go on that worker's own deque.  From anywhere else, they go 
+    to the worker threads in turn (never worker 0, since the calling thread may not come back 
+    to run them).  If there are no worker threads, they are run right here.
+Parameters:
+    group       Gets the items.  See ParticleTaskGroup for how long it must live.
+    begin       The first item.
+    end         One past the last item.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::Spawn(ParticleTaskGroup &group, const unsigned int begin, 
+    const unsigned int end)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+
+    if (_threads.empty())
+    {
+        for (unsigned int rangeBegin = begin; rangeBegin < end; rangeBegin += group._grainSize)
+        {
+            unsigned int rangeEnd = (end - rangeBegin > group._grainSize) ? 
+                rangeBegin + group._grainSize : end;
+            (*group._pTask)(rangeBegin, rangeEnd, 0);
+        }
+        return;
+    }
+
+    // Note: Added before the range is pushed so that the group can't look done while the 
+    // range is on its way.
+    group._numItemsLeft.fetch_add(end - begin);
+    Range range = { &group, begin, end };
+    if (thisThreadScheduler == this && thisThreadWorkerIndex != 0)
+    {
+        PushRange(thisThreadWorkerIndex, range);
+    }
+    else
+    {
+        PushRange(1 + (_nextSpawnWorker % _threads.size()), range);
+        _nextSpawnWorker++;
+    }
+    WakeSleepers();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Returns once every item that was spawned in a group so far is done, and runs whatever 
+    ranges it can get in the meantime.  Same rules as ParallelFor(...) for which threads may 
+    call it.
+Parameters:
+    group   Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::Wait(ParticleTaskGroup &group)
+{
+    if (_workers.empty() || group.Done())
+    {
+        return;
+    }
+
+    ParticleTaskScheduler *pOuterScheduler = thisThreadScheduler;
+    unsigned int outerWorkerIndex = thisThreadWorkerIndex;
+    if (thisThreadScheduler != this)
+    {
+        thisThreadScheduler = this;
+        thisThreadWorkerIndex = 0;
+    }
+
+    HelpUntilDone(thisThreadWorkerIndex, group);
+
+    thisThreadScheduler = pOuterScheduler;
+    thisThreadWorkerIndex = outerWorkerIndex;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Zeroes every worker's stats and the time spent in ParallelFor(...).  Must not be called
+    during ParallelFor(...).
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::ResetStats()
+{
+    for (size_t workerIndex = 0; workerIndex < _workers.size(); workerIndex++)
+    {
+        ParticleWorkerStats &stats = _workers[workerIndex]->_stats;
+        stats._busySec = 0.0;
+        stats._numTasks = 0;
+        stats._numItems = 0;
+        stats._numSteals = 0;
+        stats._numFailedSteals = 0;
+    }
+    _parallelSec = 0.0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for what one worker did since the last ResetStats().  Only meaningful
+    between calls to ParallelFor(...).
+Parameters:
+    workerIndex     0 is the thread that calls ParallelFor(...).  Must be less than
+                    NumWorkers() and Init(...) must have been called.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+const ParticleWorkerStats &ParticleTaskScheduler::WorkerStats(const unsigned int workerIndex) const
+{
+    return _workers[workerIndex]->_stats;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the wall time spent in ParallelFor(...) since the last ResetStats().  A
+    worker's busy time divided by this is how much of that time it was doing something useful.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+double ParticleTaskScheduler::ParallelSec() const
+{
+    return _parallelSec;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Prints each worker's utilization (busy time out of the time spent in ParallelFor(...)),
+    tasks, items, and steals since the last ResetStats().
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::PrintStats() const
+{
+    printf("task scheduler: %u workers, stealing %s, %.3lf ms in parallel\n", NumWorkers(),
+        _stealing.load() ? "on" : "off", _parallelSec * 1000.0);
+    printf("    %-8s %8s %10s %12s %10s %14s\n",
+        "worker", "busy %", "tasks", "items", "steals", "failed steals");
+    for (size_t workerIndex = 0; workerIndex < _workers.size(); workerIndex++)
+    {
+        const ParticleWorkerStats &stats = _workers[workerIndex]->_stats;
+        double busyPercent = (_parallelSec > 0.0) ? (100.0 * stats._busySec / _parallelSec) : 0.0;
+        printf("    %-8u %8.1lf %10u %12u %10u %14u\n", (unsigned int)workerIndex, busyPercent,
+            stats._numTasks, stats._numItems, stats._numSteals, stats._numFailedSteals);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A worker thread's life: seed its random numbers, then run whatever ranges it can get, and 
+    sleep when there are none, until Shutdown().
+Parameters:
+    workerIndex     1 and up.  Passed to the tasks.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::WorkerLoop(const unsigned int workerIndex)
+{
+    thisThreadScheduler = this;
+    thisThreadWorkerIndex = workerIndex;
+    SeedRandomForThisThread(workerIndex);
+
+    while (true)
+    {
+        Range range;
+        if (TakeRange(workerIndex, &range))
+        {
+            RunRange(workerIndex, range);
+        }
+        else if (!Sleep(workerIndex, 0))
+        {
+            return;
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs whatever ranges a worker can get until a group is done, and sleeps when there are 
+    none.  The ranges may belong to other groups.  That is fine; they would have to be run by 
+    someone anyway.
+Parameters:
+    workerIndex     The calling thread's worker.
+    group           Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::HelpUntilDone(const unsigned int workerIndex, 
+    const ParticleTaskGroup &group)
+{
+    while (!group.Done())
+    {
+        Range range;
+        if (TakeRange(workerIndex, &range))
+        {
+            RunRange(workerIndex, range);
+        }
+        else
+        {
+            Sleep(workerIndex, &group);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Puts a range on the back of a worker's deque.  Doesn't wake anyone; that's up to the 
+    caller, which may push several first.
+Parameters:
+    workerIndex     Whose deque.
+    range           Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::PushRange(const unsigned int workerIndex, const Range &range)
+{
+    Worker &worker = *_workers[workerIndex];
+    std::lock_guard<std::mutex> lock(worker._dequeMutex);
+    worker._deque.push_back(range);
+    _numQueuedRanges.fetch_add(1);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gets the next range for a worker: its own newest one, or if it has none and stealing is 
+    on, one from another worker.
+Parameters:
+    workerIndex     Self-explanatory.
+    pRange          Gets the range, if there is one.
+Returns:
+    True if there was a range, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleTaskScheduler::TakeRange(const unsigned int workerIndex, Range *pRange)
+{
+    Worker &worker = *_workers[workerIndex];
+    if (PopOwn(worker, pRange))
+    {
+        return true;
+    }
+
+    if (_stealing.load() && _numQueuedRanges.load() > 0 && Steal(workerIndex, pRange))
+    {
+        worker._stats._numSteals++;
+        return true;
+    }
+    return false;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the range that was pushed last off of the worker's own deque.
+Parameters:
+    worker  Self-explanatory.
+    pRange  Gets the range, if there is one.
+Returns:
+    True if there was a range, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleTaskScheduler::PopOwn(Worker &worker, Range *pRange)
+{
+    std::lock_guard<std::mutex> lock(worker._dequeMutex);
+    if (worker._deque.empty())
+    {
+        return false;
+    }
+    *pRange = worker._deque.back();
+    worker._deque.pop_back();
+    _numQueuedRanges.fetch_sub(1);
+    return true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the range off the front of another worker's deque, which is the biggest one that it 
+    hasn't started on.  The victims are tried in order starting with a random one so that 
+    thieves don't all pile onto the same worker.
+Parameters:
+    thiefIndex  The worker that is stealing.
+    pRange      Gets the range, if there is one.
+Returns:
+    True if a range was stolen, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleTaskScheduler::Steal(const unsigned int thiefIndex, Range *pRange)
+{
+    Worker &thief = *_workers[thiefIndex];
+    unsigned int numWorkers = _workers.size();
+    if (numWorkers < 2)
+    {
+        return false;
+    }
+
+    // xorshift32
+    unsigned int x = thief._randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    thief._randomState = x;
+    unsigned int firstVictimOffset = x % (numWorkers - 1);
+
+    for (unsigned int victimCount = 0; victimCount < numWorkers - 1; victimCount++)
+    {
+        unsigned int victimOffset = 1 + ((firstVictimOffset + victimCount) % (numWorkers - 1));
+        Worker &victim = *_workers[(thiefIndex + victimOffset) % numWorkers];
+        std::lock_guard<std::mutex> lock(victim._dequeMutex);
+        if (victim._deque.empty())
+        {
+            thief._stats._numFailedSteals++;
+            continue;
+        }
+        *pRange = victim._deque.front();
+        victim._deque.pop_front();
+        _numQueuedRanges.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs one range on a worker.  A range bigger than its group's grain size is split in half 
+    over and over, with the back halves pushed onto the worker's deque, so that the front of 
+    the deque always has the biggest ranges for thieves and the worker itself goes through its 
+    items in order.
+Parameters:
+    workerIndex     Self-explanatory.
+    range           From TakeRange(...).
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::RunRange(const unsigned int workerIndex, Range range)
+{
+    Worker &worker = *_workers[workerIndex];
+    ParticleTaskGroup &group = *range._pGroup;
+
+    bool pushedAny = false;
+    while (range._end - range._begin > group._grainSize)
+    {
+        Range backHalf;
+        backHalf._pGroup = &group;
+        backHalf._begin = range._begin + ((range._end - range._begin) / 2);
+        backHalf._end = range._end;
+        PushRange(workerIndex, backHalf);
+        pushedAny = true;
+        range._end = backHalf._begin;
+    }
+    if (pushedAny && _stealing.load())
+    {
+        WakeSleepers();
+    }
+
+    // only the outermost ParallelFor(...) range is timed so that one that runs others inside 
+    // of it isn't counted twice
+    unsigned int numItems = range._end - range._begin;
+    bool counted = group._inParallelFor;
+    bool timed = counted && (worker._taskDepth == 0);
+    if (timed)
+    {
+        worker._timer.Start();
+    }
+    worker._taskDepth += counted ? 1 : 0;
+    (*group._pTask)(range._begin, range._end, workerIndex);
+    worker._taskDepth -= counted ? 1 : 0;
+    if (timed)
+    {
+        worker._stats._busySec += worker._timer.Lap();
+    }
+    if (counted)
+    {
+        worker._stats._numTasks++;
+        worker._stats._numItems += numItems;
+    }
+
+    // Note: Must be last.  Once this reaches 0, the group's ParallelFor(...) may return and the 
+    // group is gone.
+    if (group._numItemsLeft.fetch_sub(numItems) == numItems)
+    {
+        WakeSleepers();
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Puts a thread to sleep until there is something that it can run, or the group that it is
+    waiting on is done, or Shutdown().
+Parameters:
+    workerIndex     The thread's worker.
+    pGroup          The group that the thread is waiting on, or 0 for a worker thread that is 
+                    just idle.
+Returns:
+    False if the scheduler is shutting down, otherwise true.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleTaskScheduler::Sleep(const unsigned int workerIndex, 
+    const ParticleTaskGroup *pGroup)
+{
+    // Note: The sleeper count goes up before the checks, and the pushers and finishers change 
+    // what's checked before they read the count, so one or the other always sees the other 
+    // (both are sequentially consistent).
+    std::unique_lock<std::mutex> lock(_mutex);
+    _numSleeping.fetch_add(1);
+    _wakeCondition.wait(lock, [this, workerIndex, pGroup]() 
+    {
+        return _quit || (pGroup != 0 && pGroup->Done()) || HasWorkFor(workerIndex);
+    });
+    _numSleeping.fetch_sub(1);
+    return !_quit;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks whether a worker could get a range right now: one of its own, or with stealing on,
+    anyone's.
+Parameters:
+    workerIndex     Self-explanatory.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleTaskScheduler::HasWorkFor(const unsigned int workerIndex)
+{
+    if (_stealing.load())
+    {
+        return _numQueuedRanges.load() > 0;
+    }
+
+    Worker &worker = *_workers[workerIndex];
+    std::lock_guard<std::mutex> lock(worker._dequeMutex);
+    return !worker._deque.empty();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Wakes every sleeping thread so that they check again whether they have something to do.
+    Does nothing if no one is asleep, which is most of the time while a group is running.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTaskScheduler::WakeSleepers()
+{
+    if (_numSleeping.load() == 0)
+    {
+        return;
+    }
+
+    // taking the mutex means that anyone who is about to sleep either already sees the change 
+    // or is waiting and gets the notification
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _wakeCondition.notify_all();
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "Stopwatch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// a task runs items [begin, end) of a ParallelFor(...) on the given worker (0 is the thread 
+// that called the outermost ParallelFor(...))
+typedef std::function<void(unsigned int begin, unsigned int end, unsigned int workerIndex)> 
+    ParticleRangeTask;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    What one worker of a ParticleTaskScheduler did since the last ResetStats().
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleWorkerStats
+{
+    double _busySec;                // time spent running tasks
+    unsigned int _numTasks;         // ranges run (each no bigger than the grain size)
+    unsigned int _numItems;         // items in those ranges
+    unsigned int _numSteals;        // ranges taken from another worker's deque
+    unsigned int _numFailedSteals;  // times that the chosen victim had nothing
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The ranges of one task that were handed to ParticleTaskScheduler::Spawn(...), which returns 
+    without waiting for them.  Ranges may be added to the same group over and over (even from 
+    inside its own task), and ParticleTaskScheduler::Wait(...) returns once all of them so far 
+    are done.  The scheduler only keeps pointers to the group and its task, so both must stay 
+    alive until then.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleTaskGroup
+{
+public:
+    ParticleTaskGroup(const ParticleRangeTask &task, const unsigned int grainSize);
+    bool Done() const;
+
+private:
+    friend class ParticleTaskScheduler;
+
+    // not copyable, just like the atomic
+    ParticleTaskGroup(const ParticleTaskGroup &);
+    ParticleTaskGroup &operator=(const ParticleTaskGroup &);
+
+    const ParticleRangeTask *_pTask;
+    unsigned int _grainSize;
+    std::atomic<unsigned int> _numItemsLeft;
+
+    // only the ranges of ParallelFor(...) go into the workers' stats
+    bool _inParallelFor;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A small work-stealing scheduler for the particle update (see 
+    ParticleUpdater::UpdateParallel(...), whose jobs also do the emission) and anything else 
+    that can be split into ranges.
+
+    ParallelFor(...) splits its range evenly between the workers (the calling thread is worker 
+    0 and works too) and puts each share on that worker's deque.  A worker takes a range off 
+    the back of its own deque, and while the range is bigger than the grain size, it splits 
+    it in half, pushes the back half onto its deque, and keeps the front half.  That way it 
+    works through its share in order.  A worker whose deque is empty steals from the front of 
+    another worker's deque (starting with a random one), which is where the biggest ranges 
+    that the victim hasn't split yet are.  So when some shares are more work than others (more 
+    active particles, more emission, or particles that need the expensive polygon test), the 
+    workers that finish early take work from the ones that are behind instead of waiting for 
+    them.
+
+    A task may call ParallelFor(...) itself, and so may other threads' work that was handed to 
+    the workers with Spawn(...) (like the frame task graph's tasks; see FrameTaskGraph).  Each 
+    call keeps its own task, grain size, and count of items left (a ParticleTaskGroup), and 
+    every range on a deque points at the group that it belongs to, so calls don't disturb each 
+    other.  While a call waits for its items, its thread runs whatever ranges it can get, so 
+    the thread is never lost to waiting.
+
+    The thread that isn't one of the workers' own (the main thread) is worker 0 only while it 
+    is in ParallelFor(...) or Wait(...), so nothing is ever left on its deque for later.  A 
+    call made on one of the worker threads splits its range between the worker threads only, 
+    and Spawn(...) from outside hands its ranges to the worker threads in turn.
+
+    Stealing can be turned off to compare against the plain even split, and the per-worker 
+    stats show how long each worker was busy out of the time spent in ParallelFor(...).
+
+    The deques are locked with a mutex per worker.  Tasks are meant to be thousands of items, 
+    so the lock is taken rarely compared to the work.  The threads are made once in Init(...) 
+    and sleep on a condition variable whenever there is nothing that they can run.  Each 
+    worker seeds its own random numbers (see SeedRandomForThisThread(...)) so that the 
+    emitters give different particles on each thread.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleTaskScheduler
+{
+public:
+    ParticleTaskScheduler();
+    ~ParticleTaskScheduler();
+    void Init(const unsigned int numThreads);
+    void Shutdown();
+    unsigned int NumWorkers() const;
+    void SetStealing(const bool stealing);
+    bool Stealing() const;
+
+    void ParallelFor(const unsigned int begin, const unsigned int end, 
+        const unsigned int grainSize, const ParticleRangeTask &task);
+    void Spawn(ParticleTaskGroup &group, const unsigned int begin, const unsigned int end);
+    void Wait(ParticleTaskGroup &group);
+
+    void ResetStats();
+    const ParticleWorkerStats &WorkerStats(const unsigned int workerIndex) const;
+    double ParallelSec() const;
+    void PrintStats() const;
+
+private:
+    // not copyable; the workers have a pointer to this
+    ParticleTaskScheduler(const ParticleTaskScheduler &);
+    ParticleTaskScheduler &operator=(const ParticleTaskScheduler &);
+
+    struct Range
+    {
+        ParticleTaskGroup *_pGroup;
+        unsigned int _begin;
+        unsigned int _end;
+    };
+
+    // each worker is allocated on its own so that they don't share cache lines
+    struct Worker
+    {
+        std::mutex _dequeMutex;
+        std::deque<Range> _deque;
+        ParticleWorkerStats _stats;
+        Stopwatch _timer;
+        unsigned int _taskDepth;    // ParallelFor(...) ranges running on it, counting nested ones
+
+        // calls to ParallelFor(...) on its thread that haven't returned, and the outermost 
+        // one's time
+        unsigned int _callDepth;
+        Stopwatch _callTimer;
+        unsigned int _randomState;  // for picking victims
+    };
+
+    void WorkerLoop(const unsigned int workerIndex);
+    void HelpUntilDone(const unsigned int workerIndex, const ParticleTaskGroup &group);
+    void PushRange(const unsigned int workerIndex, const Range &range);
+    bool TakeRange(const unsigned int workerIndex, Range *pRange);
+    bool PopOwn(Worker &worker, Range *pRange);
+    bool Steal(const unsigned int thiefIndex, Range *pRange);
+    void RunRange(const unsigned int workerIndex, Range range);
+    bool Sleep(const unsigned int workerIndex, const ParticleTaskGroup *pGroup);
+    bool HasWorkFor(const unsigned int workerIndex);
+    void WakeSleepers();
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _stealing;   // idle workers read it while deciding whether to sleep
+
+    // ranges on all the deques; lets a thief tell if there is anything to steal without locking 
+    // them all
+    std::atomic<unsigned int> _numQueuedRanges;
+
+    // threads sleep when there's nothing that they can run, and are woken when a range is 
+    // pushed or a group finishes
+    // Note: Waking only takes the mutex if someone is asleep (or about to be).
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::atomic<unsigned int> _numSleeping;
+    bool _quit;
+
+    // the worker thread that gets the next Spawn(...) from outside
+    unsigned int _nextSpawnWorker;
+
+    // time spent in calls to ParallelFor(...) that weren't made inside another one, added up 
+    // over the threads that made them; several may add to it, so it's guarded by the mutex
+    double _parallelSec;
+};
@@ -0,0 +1,169 @@
+#include "ParticleTimingWheel.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.  The wheel has no slots
+    until Init(...) is called.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleTimingWheel::ParticleTimingWheel() :
+    _slotMask(0),
+    _currentTick(0),
+    _numScheduled(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Throws out every entry and makes the number of slots the provided number rounded up to a
+    power of two.  The current tick starts over at 0.
+Parameters:
+    numSlots    Should cover most particles' lifetimes in ticks.  Longer lifetimes still work,
+                but they are looked at (and put back) once per trip around the wheel.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTimingWheel::Init(const unsigned int numSlots)
+{
+    unsigned int roundedNumSlots = 1;
+    while (roundedNumSlots < numSlots)
+    {
+        roundedNumSlots *= 2;
+    }
+
+    _slots.resize(roundedNumSlots);
+    for (unsigned int slotIndex = 0; slotIndex < _slots.size(); slotIndex++)
+    {
+        _slots[slotIndex].clear();
+    }
+    _slotMask = roundedNumSlots - 1;
+    _currentTick = 0;
+    _numScheduled = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Removes the entries of every particle with an index at or above the provided one.  Used
+    when the storage shrinks so that the wheel doesn't later retire particles that aren't
+    there anymore (or that were re-emitted after the storage grew again).
+Parameters:
+    firstDroppedIndex   Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTimingWheel::DropParticlesFrom(const unsigned int firstDroppedIndex)
+{
+    for (unsigned int slotIndex = 0; slotIndex < _slots.size(); slotIndex++)
+    {
+        std::vector<Entry> &slot = _slots[slotIndex];
+        unsigned int numKept = 0;
+        for (unsigned int entryIndex = 0; entryIndex < slot.size(); entryIndex++)
+        {
+            if (slot[entryIndex]._particleIndex < firstDroppedIndex)
+            {
+                slot[numKept] = slot[entryIndex];
+                numKept++;
+            }
+        }
+        _numScheduled -= slot.size() - numKept;
+        slot.resize(numKept);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of times that Advance(...) has been called since Init(...).
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleTimingWheel::CurrentTick() const
+{
+    return _currentTick;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of particles that are waiting to expire.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleTimingWheel::NumScheduled() const
+{
+    return _numScheduled;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Files a particle to expire on the provided tick.  A tick that is not after the current
+    one is moved up to the next one so that it still comes up.
+Parameters:
+    particleIndex   Self-explanatory.
+    expiryTick      The value of CurrentTick() after the Advance(...) that should retire it.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleTimingWheel::Schedule(const unsigned int particleIndex,
+    const unsigned int expiryTick)
+{
+    Entry entry;
+    entry._particleIndex = particleIndex;
+    entry._expiryTick = expiryTick;
+
+    // compare through the difference so that this survives the tick wrapping around
+    if ((int)(expiryTick - _currentTick) <= 0)
+    {
+        entry._expiryTick = _currentTick + 1;
+    }
+
+    _slots[entry._expiryTick & _slotMask].push_back(entry);
+    _numScheduled++;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Moves to the next tick and hands over every particle whose time is up.  Only that tick's
+    slot is looked at.  Entries in it that belong to a later trip around the wheel stay put.
+Parameters:
+    pExpiredIndices     The expired particles' indices are pushed onto the end of this.
+Returns:
+    The number of expired particles.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleTimingWheel::Advance(std::vector<unsigned int> *pExpiredIndices)
+{
+    _currentTick++;
+    std::vector<Entry> &slot = _slots[_currentTick & _slotMask];
+
+    unsigned int numKept = 0;
+    for (unsigned int entryIndex = 0; entryIndex < slot.size(); entryIndex++)
+    {
+        const Entry &entry = slot[entryIndex];
+        if ((int)(entry._expiryTick - _currentTick) <= 0)
+        {
+            pExpiredIndices->push_back(entry._particleIndex);
+        }
+        else
+        {
+            slot[numKept] = entry;
+            numKept++;
+        }
+    }
+
+    unsigned int numExpired = slot.size() - numKept;
+    slot.resize(numKept);
+    _numScheduled -= numExpired;
+    return numExpired;
+}
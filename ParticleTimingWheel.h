@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A hashed timing wheel of particle expiries.  Particles here move in straight lines at
+    constant velocity, so the frame on which a particle leaves its region is known the moment
+    it is emitted (see IParticleRegion::ExitTime(...)).  The particle's index is filed in the
+    slot for that frame ("tick"), and each frame only the current slot is looked at, so the
+    cost of retiring particles is proportional to the number that retire instead of the number
+    that are active.
+
+    There are a fixed number of slots (a power of two), and a particle that expires more than
+    that many ticks from now goes in the slot that its tick wraps around to.  Every entry
+    keeps its full expiry tick, and entries that come up early are left in the slot for the
+    next time around.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleTimingWheel
+{
+public:
+    ParticleTimingWheel();
+    void Init(const unsigned int numSlots);
+    void DropParticlesFrom(const unsigned int firstDroppedIndex);
+
+    unsigned int CurrentTick() const;
+    unsigned int NumScheduled() const;
+
+    void Schedule(const unsigned int particleIndex, const unsigned int expiryTick);
+    unsigned int Advance(std::vector<unsigned int> *pExpiredIndices);
+
+private:
+    struct Entry
+    {
+        unsigned int _particleIndex;
+        unsigned int _expiryTick;
+    };
+
+    // one vector per slot; they keep their capacity, so filing doesn't allocate once the
+    // wheel has warmed up
+    std::vector<std::vector<Entry> > _slots;
+    unsigned int _slotMask;
+    unsigned int _currentTick;
+    unsigned int _numScheduled;
+};
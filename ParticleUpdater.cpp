@@ -1,5 +1,60 @@
 #include "ParticleUpdater.h"
 
+#include "BitOperations.h"
+#include "ParticleKernels.h"
+#include "ParticleEmitBatch.h"
+#include "ParticleTaskScheduler.h"
+#include "ParticleEmissionBudget.h"
+
+#include <float.h>  // for FLT_MAX
+
+// where ring particles that die before they reach the tail wait, and where scheduled particles 
+// go when they expire; well outside of window space so that they are clipped
+static const glm::vec2 PARKED_PARTICLE_POSITION(-10.0f, -10.0f);
+
+// a few thousand particles; 2048 "structure of arrays" particles (positions and velocities) 
+// are 32KB, which is the size of a typical L1 data cache
+static const unsigned int DEFAULT_TILE_SIZE = 2048;
+
+// the particles in one job of UpdateParallel(...); must be a multiple of 4096 (64 chunks of 64) 
+// so that no two jobs share a word of the active mask's occupancy bits
+// Note: Small enough that a big storage makes a few dozen jobs per worker, so that there is 
+// something left to steal when one worker's share turns out to be more work than the others.
+static const unsigned int PARALLEL_JOB_SIZE = 16384;
+
+// particles that won't leave the region for longer than this many frames (practically 
+// forever) aren't given an expiry; keeps the frame count well inside an unsigned int
+static const float MAX_SCHEDULED_FRAMES = 1073741824.0f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Works out the tick (frame) on which a particle that was just emitted will be outside of 
+    the region.  It is outside after frame N if N * delta time > exit time.
+Parameters:
+    exitTimeSec     From IParticleRegion::ExitTime(...).
+    deltaTimeSec    The length of a frame.
+    currentTick     The tick that the particle was emitted on.
+    pExpiryTick     Receives the tick.  Not touched if the particle never expires.
+Returns:    
+    False if the particle doesn't leave (practically) ever, otherwise true.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+static bool ExpiryTick(const float exitTimeSec, const float deltaTimeSec, 
+    const unsigned int currentTick, unsigned int *pExpiryTick)
+{
+    // Note: The "not less than" also catches NaN, which never leaves, the same as with the 
+    // other updates.
+    float numFramesInside = exitTimeSec / deltaTimeSec;
+    if (!(numFramesInside < MAX_SCHEDULED_FRAMES))
+    {
+        return false;
+    }
+
+    *pExpiryTick = currentTick + (unsigned int)numFramesInside + 1;
+    return true;
+}
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Ensures that the object starts object with initialized values.
@@ -9,14 +64,23 @@ Exception:  Safe
 Creator:    John Cox (7-4-2016)
 -----------------------------------------------------------------------------------------------*/
 ParticleUpdater::ParticleUpdater() :
-    _pRegion(0)
+    _pRegion(0),
+    _stageCount(0),
+    _tileSize(DEFAULT_TILE_SIZE)
 {
     for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
     {
         _pEmitters[emitterIndex] = 0;
         _maxParticlesEmittedPerFrame[emitterIndex] = 0;
+        _particleLifetimeSec[emitterIndex] = 0.0f;
     }
     _emitterCount = 0;
+
+    for (size_t stageIndex = 0; stageIndex < MAX_STAGES; stageIndex++)
+    {
+        _pStages[stageIndex] = 0;
+        _stageSlots[stageIndex] = PARTICLE_STAGE_BEFORE_INTEGRATE;
+    }
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -40,11 +104,15 @@ Parameters:
     pEmitter    A pointer to a "particle emitter" interface.
     maxParticlesEmittedPerFrame     A restriction on the provided emitter to prevent all 
         particles from being emitted at once.
+    particleLifetimeSec     How long this emitter's particles live if they don't leave the 
+        region first.  0 means that they only die by leaving the region.  Only the ring storage 
+        (ParticleStorageRing) keeps track of age, so the other storages ignore this.
 Returns:    None
 Exception:  Safe
 Creator:    John Cox (7-4-2016)
 -----------------------------------------------------------------------------------------------*/
-void ParticleUpdater::AddEmitter(const IParticleEmitter *pEmitter, const int maxParticlesEmittedPerFrame)
+void ParticleUpdater::AddEmitter(const IParticleEmitter *pEmitter, const int maxParticlesEmittedPerFrame, 
+    const float particleLifetimeSec)
 {
     if (_emitterCount >= MAX_EMITTERS)
     {
@@ -53,28 +121,92 @@ void ParticleUpdater::AddEmitter(const IParticleEmitter *pEmitter, const int max
 
     _pEmitters[_emitterCount] = pEmitter;
     _maxParticlesEmittedPerFrame[_emitterCount] = maxParticlesEmittedPerFrame;
+    _particleLifetimeSec[_emitterCount] = particleLifetimeSec;
     _emitterCount++;
 }
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Checks if each particle is out of bounds, and if so, tells the emitter to reset it.  If the 
-    emitter hasn't reached its quota for emitted particles, then the particle is sent back out 
-    again.  Lastly, if the particle is active, then its position is updated with its velocity and
-    the provided delta time.
+    A simple assignment.  Stages only run in UpdateTiled(...).
+Parameters: 
+    pStage      A pointer to a "particle stage" interface.
+    slot        Where in each tile's update it runs.  Stages in the same slot run in the order 
+                that they were added.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleUpdater::AddStage(const IParticleStage *pStage, const ParticleStageSlot slot)
+{
+    if (_stageCount >= MAX_STAGES)
+    {
+        return;
+    }
+
+    _pStages[_stageCount] = pStage;
+    _stageSlots[_stageCount] = slot;
+    _stageCount++;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets the number of particles that UpdateTiled(...) takes through every step before moving 
+    on to the next ones.  Rounded up to a whole number of active mask chunks (64 particles).
+Parameters: 
+    tileSize    Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleUpdater::SetTileSize(const unsigned int tileSize)
+{
+    _tileSize = ((tileSize + 63) / 64) * 64;
+    if (_tileSize == 0)
+    {
+        _tileSize = 64;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter.
+Parameters: None
+Returns:
+    See SetTileSize(...).
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::TileSize() const
+{
+    return _tileSize;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks if each active particle is out of bounds, and if so, deactivates it and puts its 
+    index on the storage's "free index" stack.  If the particle is still active, then its 
+    position is updated with its velocity and the provided delta time.
+
+    The bounds checks are done 64 particles at a time with the region's batch check, so there 
+    is one virtual call per occupied chunk instead of one per particle.
+
+    Emission is NOT done here.  Call Emit(...) once per frame after all the particles have 
+    been updated (this used to be done in the same loop, but then the emitters' quotas were 
+    spent on whichever low indices happened to be inactive).
 Parameters:
-    particleCollection  The particle collection that will be updated.
+    particleStorage     The particle storage that will be updated.
     startIndex          Used in case the user wanted to adapt the updater to use multiple 
                         emitters and then wanted to split the number of particles between these 
                         emitters.
     numToUpdate         Same idea as "start index".
     deltatimeSec        Self-explanatory
 Returns:    
-    The number of active particles.  Useful for performance comparison with GPU version.
+    The number of active particles in the range.  Useful for performance comparison with GPU 
+    version.
 Exception:  Safe
 Creator:    John Cox (7-4-2016)
 -----------------------------------------------------------------------------------------------*/
-unsigned int ParticleUpdater::Update(std::vector<Particle> &particleCollection, 
+unsigned int ParticleUpdater::Update(ParticleStorage &particleStorage, 
     const unsigned int startIndex, const unsigned int numToUpdate, const float deltaTimeSec) const
 {
     if (_emitterCount == 0 || _pRegion == 0)
@@ -82,67 +214,425 @@ unsigned int ParticleUpdater::Update(std::vector<Particle> &particleCollection,
         return 0;
     }
 
-    // for all particles:
-    // - if it has gone out of bounds, reset it and deactivate it
-    // - if it is inactive and the emitter hasn't used up its quota for emitted particles this frame, reactivate it
-    // - if it is active, update its position with its velocity
-    // Note: If if() statements are used for each situation, then a particle has a chance to go 
-    // out of bounds and get reset, get reactivated, and emit again in the same frame.  If 
-    // else-if() statements are used, then only one of those situations will be run per frame.  
-    // I did the former, but it doesn't really matter which approach is chosen.
+    ParticlePool &particleCollection = particleStorage._allParticles;
 
     // simply called "end" because I want to keep using the "< end" notation on the loop end 
     // condition
     unsigned int endIndex = startIndex + numToUpdate;
-    if (endIndex > particleCollection.size())
+    if (endIndex > particleCollection.Size())
     {
         // if "end" was already == particle collection size, then all is good
-        endIndex = particleCollection.size();
+        endIndex = particleCollection.Size();
+    }
+
+    // walk the active bits one 64-particle chunk at a time, skipping chunks (and whole runs of 
+    // chunks) that have no active particles, and only visiting the particles whose bits are set
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int endChunk = (endIndex + 63) / 64;
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long rangeBits = RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+
+        // one virtual call tests the whole chunk
+        // Note: Pool segments are a multiple of 64 particles, so a chunk is always contiguous.
+        unsigned int numInChunk = (endIndex < chunkStart + 64) ? (endIndex - chunkStart) : 64;
+        unsigned long long outOfBoundsBits = 0;
+        _pRegion->OutOfBoundsBatch(
+            MakePositionSpan(&particleCollection[chunkStart], numInChunk), &outOfBoundsBits);
+
+        unsigned long long leavingBits = activeBits & rangeBits & outOfBoundsBits;
+        activeBits &= ~leavingBits;
+        while (leavingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(leavingBits);
+            leavingBits &= leavingBits - 1;
+            particleStorage._freeIndices.push_back(chunkStart + bitIndex);
+        }
+
+        unsigned long long remainingBits = activeBits & rangeBits;
+        while (remainingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(remainingBits);
+            remainingBits &= remainingBits - 1;
+
+            Particle &p = particleCollection[chunkStart + bitIndex];
+            p._position = p._position + (p._velocity * deltaTimeSec);
+        }
+
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(activeBits & rangeBits);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A version of Update(...) with no branches that depend on the particles.  Update(...) only
+    visits the active particles in a chunk, so once active and inactive particles are mixed 
+    randomly (which they are after the demo has run for a while), the loops that walk the bits 
+    end after an unpredictable number of particles and the branch predictor can't keep up.
+
+    Instead, every particle in an occupied chunk is moved, and particles that aren't moving 
+    (inactive, out of bounds, or outside of [startIndex, endIndex)) are multiplied by 0, so the 
+    loop is always the same length and the compiler can vectorize it.  The indices of the 
+    particles that went out of bounds are compacted without branching (each one is written, 
+    and the count only advances if it left) and appended to the "free index" stack all at once.
+    Only a few particles leave each frame, so chunks where none did skip that (one branch per 
+    chunk that is nearly always predicted).
+
+    Emission is still the separate pass that it always was: call Emit(...) afterwards, which 
+    takes its quotas off the top of the compacted stack.
+
+    Whether this beats Update(...) depends on the fraction of active particles (see
+    BenchmarkPredicatedUpdate(...)): when nearly all are active, both do the same work and this
+    only saves the mispredictions; when few are active, this moves a lot of particles for 
+    nothing.
+Parameters:
+    particleStorage     The particle storage that will be updated.
+    startIndex          See Update(...).
+    numToUpdate         Same idea as "start index".
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles in the range.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::UpdatePredicated(ParticleStorage &particleStorage, 
+    const unsigned int startIndex, const unsigned int numToUpdate, const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    ParticlePool &particleCollection = particleStorage._allParticles;
+    unsigned int endIndex = startIndex + numToUpdate;
+    if (endIndex > particleCollection.Size())
+    {
+        endIndex = particleCollection.Size();
+    }
+
+    // whole chunks with no active particles are still skipped; that is one branch per chunk, 
+    // and it is predictable unless the active fraction is very low
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int endChunk = (endIndex + 63) / 64;
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long rangeBits = RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+
+        // Note: Pool segments are a multiple of 64 particles, so a chunk is always contiguous.
+        Particle *pChunk = &particleCollection[chunkStart];
+        unsigned int numInChunk = (endIndex < chunkStart + 64) ? (endIndex - chunkStart) : 64;
+        unsigned long long outOfBoundsBits = 0;
+        _pRegion->OutOfBoundsBatch(MakePositionSpan(pChunk, numInChunk), &outOfBoundsBits);
+
+        unsigned long long leavingBits = activeBits & rangeBits & outOfBoundsBits;
+        activeBits &= ~leavingBits;
+        unsigned long long movingBits = activeBits & rangeBits;
+        for (unsigned int bitIndex = 0; bitIndex < numInChunk; bitIndex++)
+        {
+            float scale = deltaTimeSec * (float)((movingBits >> bitIndex) & 1);
+            pChunk[bitIndex]._position += pChunk[bitIndex]._velocity * scale;
+        }
+
+        if (leavingBits != 0)
+        {
+            unsigned int leavingIndices[64];
+            unsigned int numLeaving = 0;
+            for (unsigned int bitIndex = 0; bitIndex < numInChunk; bitIndex++)
+            {
+                leavingIndices[numLeaving] = chunkStart + bitIndex;
+                numLeaving += (unsigned int)((leavingBits >> bitIndex) & 1);
+            }
+            particleStorage._freeIndices.insert(particleStorage._freeIndices.end(), 
+                leavingIndices, leavingIndices + numLeaving);
+        }
+
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(movingBits);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Each emitter takes exactly its quota of indices (or whatever is left) off of the storage's 
+    "free index" stack and resets and activates those particles.  Taking an index off the stack
+    is O(1), so the cost doesn't depend on where the inactive particles are.  The emitters 
+    reset the particles in batches (see IParticleEmitter::ResetParticles(...)).
+Parameters:
+    particleStorage     The particle storage whose inactive particles will be emitted.
+Returns:    
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::Emit(ParticleStorage &particleStorage) const
+{
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+    unsigned int numEmitted = 0;
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > freeIndices.size())
+        {
+            numToEmit = freeIndices.size();
+        }
+
+        // the free slots are scattered around the pool, so the emitter resets a batch on the 
+        // stack that is then copied into them
+        Particle emitted[PARTICLE_EMIT_BATCH_SIZE];
+        for (unsigned int batchStart = 0; batchStart < numToEmit; 
+            batchStart += PARTICLE_EMIT_BATCH_SIZE)
+        {
+            unsigned int numInBatch = numToEmit - batchStart;
+            if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+            {
+                numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+            }
+            _pEmitters[emitterIndex]->ResetParticles(emitted, numInBatch);
+
+            for (unsigned int batchIndex = 0; batchIndex < numInBatch; batchIndex++)
+            {
+                unsigned int particleIndex = freeIndices.back();
+                freeIndices.pop_back();
+                particleStorage._allParticles[particleIndex] = emitted[batchIndex];
+                particleStorage._activeMask.Activate(particleIndex);
+            }
+        }
+        numEmitted += numToEmit;
+    }
+
+    return numEmitted;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Update(...) and Emit(...) for the whole storage, split into jobs of PARALLEL_JOB_SIZE 
+    particles that run on the task scheduler.  Each job checks, moves, and then emits into its own 
+    range, so jobs never touch the same particles or the same words of the active mask.
+
+    Update(...) can't just be called on several threads with different ranges because every 
+    call pushes onto the same "free index" stack, and Emit(...) spends each emitter's whole 
+    quota from that one stack.  Here, each emitter's quota goes into an atomic counter (see 
+    ParticleEmissionBudget) at the start of the frame.  After a job has moved its particles, it 
+    knows how many of its slots are free, claims batches from the counters (never more than it 
+    has room for), and finds the slots by scanning its own range of the active mask.  The "free 
+    index" stack is not used.  Jobs that run first take more of the budget, and a job that is 
+    full leaves the rest to the others, so exactly the quota is emitted unless the whole storage 
+    fills up, just like Emit(...), and without a lock or a serial pass to hand out leftovers.
+
+    Each job writes its active count into its own slot, and they are added up at the end, so 
+    the jobs don't share a counter either.  The emitters are called on the worker threads, 
+    which is safe because the random numbers are per thread (see SeedRandomForThisThread(...)).
+
+    If the pool defers its first touch, then any particles that haven't been touched yet (all 
+    of them on the first update, and the new ones after growing) are touched first by the same 
+    jobs on the same workers, so their pages end up on the NUMA nodes of the workers that will 
+    update them (see ParticlePool::SetMemoryPolicy(...)).
+Parameters:
+    particleStorage     The particle storage that will be updated.  Its "free index" stack 
+                        goes stale, so don't use it with Update(...) or Emit(...) as well.
+    taskScheduler       Runs the jobs.  Jobs are handed out one at a time, so a worker that 
+                        is done with its share steals single jobs from the others.
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles, including the ones that were just emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::UpdateParallel(ParticleStorage &particleStorage, 
+    ParticleTaskScheduler &taskScheduler, const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    ParticlePool &particlePool = particleStorage._allParticles;
+    unsigned int numParticles = particlePool.Size();
+    unsigned int numJobs = (numParticles + PARALLEL_JOB_SIZE - 1) / PARALLEL_JOB_SIZE;
+    unsigned int firstUntouchedIndex = particlePool.FirstUntouchedIndex();
+    if (firstUntouchedIndex < numParticles)
+    {
+        taskScheduler.ParallelFor(0, numJobs, 1, 
+            [&particlePool, firstUntouchedIndex](unsigned int firstJob, unsigned int endJob, 
+            unsigned int)
+        {
+            unsigned int touchStart = firstJob * PARALLEL_JOB_SIZE;
+            if (touchStart < firstUntouchedIndex)
+            {
+                touchStart = firstUntouchedIndex;
+            }
+            unsigned int touchEnd = endJob * PARALLEL_JOB_SIZE;
+            if (touchEnd > touchStart)
+            {
+                // clamped to the end of the pool
+                particlePool.FirstTouch(touchStart, touchEnd - touchStart);
+            }
+        });
+        particlePool.FinishFirstTouch();
+    }
+
+    static_assert(MAX_EMITTERS <= ParticleEmissionBudget::MAX_EMITTERS, 
+        "every emitter needs its own emission budget");
+    ParticleEmissionBudget emissionBudget;
+    for (unsigned int emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        // unused emitters keep an empty budget
+        if (_pEmitters[emitterIndex] != 0)
+        {
+            emissionBudget.Reset(emitterIndex, _maxParticlesEmittedPerFrame[emitterIndex]);
+        }
     }
 
-    // when using multiple emitters, it looks best to cycle between all emitters one by one, but that is also more difficult to deal with and requires a number of different checks and conditions, and provided the total number of particles to update exceeds the total number of max particles emitted per frame across all emitters, then it will look just as good to "fill up" each emitter one by one, and that is much easier to implement
-    unsigned int particleEmitCounter = 0;
-    int emitterIndex = 0;
+    std::vector<unsigned int> jobActiveCounts(numJobs, 0);
+    taskScheduler.ParallelFor(0, numJobs, 1, 
+        [this, &particleStorage, &jobActiveCounts, &emissionBudget, deltaTimeSec]
+        (unsigned int firstJob, unsigned int endJob, unsigned int)
+    {
+        for (unsigned int jobIndex = firstJob; jobIndex < endJob; jobIndex++)
+        {
+            jobActiveCounts[jobIndex] = 
+                UpdateAndEmitJob(particleStorage, jobIndex, emissionBudget, deltaTimeSec);
+        }
+    });
+
     unsigned int numActiveParticles = 0;
+    for (unsigned int jobIndex = 0; jobIndex < numJobs; jobIndex++)
+    {
+        numActiveParticles += jobActiveCounts[jobIndex];
+    }
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    One job of UpdateParallel(...).  The update is the same as Update(...) except that 
+    particles that leave only lose their "active" bit.  Then the job claims batches from each 
+    emitter's budget, as many as it has inactive particles for, and emits them into those 
+    particles, lowest index first.
+Parameters:
+    particleStorage     Self-explanatory.
+    jobIndex            Which PARALLEL_JOB_SIZE range of particles to do.
+    emissionBudget      What is left of each emitter's quota.  Shared with the other jobs.
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles in the job's range, including the ones that were just 
+    emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::UpdateAndEmitJob(ParticleStorage &particleStorage, 
+    const unsigned int jobIndex, ParticleEmissionBudget &emissionBudget, 
+    const float deltaTimeSec) const
+{
+    ParticlePool &particleCollection = particleStorage._allParticles;
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int jobStart = jobIndex * PARALLEL_JOB_SIZE;
+    unsigned int jobEnd = jobStart + PARALLEL_JOB_SIZE;
+    jobEnd = (jobEnd < particleCollection.Size()) ? jobEnd : particleCollection.Size();
+    unsigned int endChunk = (jobEnd + 63) / 64;
 
-    for (size_t particleIndex = startIndex; particleIndex < endIndex; particleIndex++)
+    unsigned int numActiveParticles = 0;
+    // Note: The search stops at the end of the job so that it doesn't read occupancy bits 
+    // that another job is writing.
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(jobStart / 64, endChunk); 
+        chunkIndex < endChunk; 
+        chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1, endChunk))
     {
-        Particle &pCopy = particleCollection[particleIndex];
-        if (_pRegion->OutOfBounds(pCopy))
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+        unsigned int numInChunk = (jobEnd < chunkStart + 64) ? (jobEnd - chunkStart) : 64;
+        unsigned long long outOfBoundsBits = 0;
+        _pRegion->OutOfBoundsBatch(
+            MakePositionSpan(&particleCollection[chunkStart], numInChunk), &outOfBoundsBits);
+        activeBits &= ~outOfBoundsBits;
+
+        unsigned long long remainingBits = activeBits;
+        while (remainingBits != 0)
         {
-            pCopy._isActive = false;
+            unsigned int bitIndex = CountTrailingZeros64(remainingBits);
+            remainingBits &= remainingBits - 1;
+
+            Particle &p = particleCollection[chunkStart + bitIndex];
+            p._position = p._position + (p._velocity * deltaTimeSec);
         }
 
-        if (pCopy._isActive)
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(activeBits);
+    }
+
+    // walk the inactive bits from the start of the range while emitting
+    unsigned int numFreeSlots = (jobEnd - jobStart) - numActiveParticles;
+    unsigned int freeChunkIndex = jobStart / 64;
+    unsigned long long freeBits = ~activeMask.GetChunk(freeChunkIndex) & 
+        RangeMask64(freeChunkIndex * 64, jobStart, jobEnd);
+    for (unsigned int emitterIndex = 0; emitterIndex < MAX_EMITTERS && numFreeSlots > 0; 
+        emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
         {
-            numActiveParticles++;
-            pCopy._position = pCopy._position + (pCopy._velocity * deltaTimeSec);
+            continue;
         }
-        else if (emitterIndex < MAX_EMITTERS)   // also implicitly, "is active" is false
+
+        Particle emitted[PARTICLE_EMIT_BATCH_SIZE];
+        unsigned int particleIndices[PARTICLE_EMIT_BATCH_SIZE];
+        while (numFreeSlots > 0)
         {
-            // if all emitters have put out all they can this frame, then this condition will 
-            // not be entered
-            _pEmitters[emitterIndex]->ResetParticle(&pCopy);
-            pCopy._isActive = true;
-            particleCollection[particleIndex] = pCopy;
+            // there are at least this many inactive bits left, so the scan shouldn't run out
+            unsigned int numWanted = (numFreeSlots < PARTICLE_EMIT_BATCH_SIZE) ? 
+                numFreeSlots : PARTICLE_EMIT_BATCH_SIZE;
+            unsigned int numInBatch = emissionBudget.Claim(emitterIndex, numWanted);
+            if (numInBatch == 0)
+            {
+                break;
+            }
 
-            particleEmitCounter++;
-            if (particleEmitCounter >= _maxParticlesEmittedPerFrame[emitterIndex])
+            // but it still stops at the job's last chunk so that it can never wander into the 
+            // mask words of another job (or off the end of the mask)
+            unsigned int numFound = 0;
+            for (; numFound < numInBatch; numFound++)
             {
-                // get the next emitter
-                // Note: This is in a while loop because the number of emitters in this particle updater are unknown and some of the pointers in the emitter array may still be 0, so this has to loop through (potentially) all of them.
-                emitterIndex++;
-                while (emitterIndex < MAX_EMITTERS)
+                while (freeBits == 0 && freeChunkIndex + 1 < endChunk)
+                {
+                    freeChunkIndex++;
+                    freeBits = ~activeMask.GetChunk(freeChunkIndex) & 
+                        RangeMask64(freeChunkIndex * 64, jobStart, jobEnd);
+                }
+                if (freeBits == 0)
                 {
-                    if (_pEmitters[emitterIndex] != 0)
-                    {
-                        // got another one, so start the particle emission counter over again
-                        particleEmitCounter = 0;
-                        break;
-                    }
-                    emitterIndex++;
+                    break;
                 }
+
+                unsigned int bitIndex = CountTrailingZeros64(freeBits);
+                freeBits &= freeBits - 1;
+                particleIndices[numFound] = (freeChunkIndex * 64) + bitIndex;
             }
+
+            _pEmitters[emitterIndex]->ResetParticles(emitted, numFound);
+            for (unsigned int batchIndex = 0; batchIndex < numFound; batchIndex++)
+            {
+                particleCollection[particleIndices[batchIndex]] = emitted[batchIndex];
+                activeMask.Activate(particleIndices[batchIndex]);
+            }
+            numFreeSlots = (numFound < numInBatch) ? 0 : numFreeSlots - numFound;
+            numActiveParticles += numFound;
         }
     }
 
@@ -151,27 +641,1051 @@ unsigned int ParticleUpdater::Update(std::vector<Particle> &particleCollection,
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Used during initialization to give all particles initial values.  It would not do to have 
-    everyone with random values composed of whatever bits were already in the memory where they 
-    ended up.
+    A version of Update(...) that keeps all the active particles packed at the front of the 
+    storage, [0, _numActiveParticles), so that the cost of a frame (update, upload, and draw) 
+    depends on the number of active particles instead of the size of the storage.
+    - Active particles are moved, and then any that went out of bounds are removed by copying 
+    the last active particle into their place.  The bounds checks are batched 64 at a time, 
+    starting from the end, so the last active particle has always already been checked.
+    - Each emitter then appends up to its quota of new particles to the end of the active ones.
+
+    The storage's "active" mask is not used here because a particle is active if and only if 
+    its index is less than the active count.
 Parameters:
-    particleCollection  Self-explanatory
-Returns:    None
+    particleStorage     The particle storage that will be updated.  Its active count must only 
+                        be changed by this method.
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles, which is also the storage's new active count.
 Exception:  Safe
-Creator:    John Cox (8-13-2016)
+Creator:    agent (10-17-2026)
 -----------------------------------------------------------------------------------------------*/
-void ParticleUpdater::ResetAllParticles(std::vector<Particle> &particleCollection)
+unsigned int ParticleUpdater::UpdateCompacted(ParticleStorage &particleStorage, 
+    const float deltaTimeSec) const
 {
-    // reset all particles evenly 
-    // Note: I could do a weighted fancy algorithm and account for the "particles emitted per frame" for each emitter, but this is just a demo program.
-    // Also Note: This integer division could leave a few particles unaffected, but those will quickly be swept up into the flow of things when "update" runs.
-    unsigned int particlesPerEmitter = particleCollection.size() / _emitterCount;
-    for (size_t emitterIndex = 0; emitterIndex < _emitterCount; emitterIndex++)
+    if (_emitterCount == 0 || _pRegion == 0)
     {
-        for (size_t particleIndex = 0; particleIndex < particlesPerEmitter; particleIndex++)
+        return 0;
+    }
+
+    ParticlePool &particles = particleStorage._allParticles;
+    unsigned int capacity = particles.Size();
+    unsigned int numActiveParticles = particleStorage._numActiveParticles;
+
+    for (unsigned int particleIndex = 0; particleIndex < numActiveParticles; particleIndex++)
+    {
+        Particle &p = particles[particleIndex];
+        p._position = p._position + (p._velocity * deltaTimeSec);
+    }
+
+    // test 64 particles at a time, last group first, and remove the ones that are out of 
+    // bounds from the highest index down
+    // Note: Every particle above the one being removed has already been tested and kept, so 
+    // the last active particle that fills the hole never needs to be tested again.
+    for (unsigned int groupIndex = (numActiveParticles + 63) / 64; groupIndex > 0; groupIndex--)
+    {
+        unsigned int groupStart = (groupIndex - 1) * 64;
+        unsigned int numInGroup = numActiveParticles - groupStart;
+        if (numInGroup > 64)
         {
-            _pEmitters[emitterIndex]->ResetParticle(&particleCollection[particleIndex]);
+            numInGroup = 64;
+        }
+
+        unsigned long long outOfBoundsBits = 0;
+        _pRegion->OutOfBoundsBatch(MakePositionSpan(&particles[groupStart], numInGroup), 
+            &outOfBoundsBits);
+        while (outOfBoundsBits != 0)
+        {
+            unsigned int bitIndex = IndexOfHighestBit64(outOfBoundsBits);
+            outOfBoundsBits &= ~(1ULL << bitIndex);
+
+            // Note: If this was the last active particle, then it is copied onto itself, which 
+            // is harmless.
+            numActiveParticles--;
+            particles[groupStart + bitIndex] = particles[numActiveParticles];
+        }
+    }
+
+    // emission just appends to the end of the active particles
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > capacity - numActiveParticles)
+        {
+            numToEmit = capacity - numActiveParticles;
+        }
+
+        // the new particles are contiguous, so they are reset in place, but a run can't cross 
+        // into the next pool segment
+        unsigned int emitCount = 0;
+        while (emitCount < numToEmit)
+        {
+            unsigned int numToSegmentEnd = ParticlePool::PARTICLES_PER_SEGMENT - 
+                (numActiveParticles & (ParticlePool::PARTICLES_PER_SEGMENT - 1));
+            unsigned int numInRun = numToEmit - emitCount;
+            if (numInRun > numToSegmentEnd)
+            {
+                numInRun = numToSegmentEnd;
+            }
+            _pEmitters[emitterIndex]->ResetParticles(&particles[numActiveParticles], numInRun);
+            numActiveParticles += numInRun;
+            emitCount += numInRun;
         }
     }
+
+    particleStorage._numActiveParticles = numActiveParticles;
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A version of Update(...) + Emit(...) with no bounds checks.  Particles move in straight 
+    lines at constant velocity, so when a particle is emitted, the region says how long it has 
+    until it leaves (IParticleRegion::ExitTime(...)), and the particle is filed in the 
+    storage's timing wheel under the frame on which it will be outside.  Each frame:
+    - The wheel moves forward one frame and the particles filed under it are deactivated and 
+    put on the "free index" stack.
+    - Every active particle is moved.  There is nothing else in this loop.
+    - Each emitter resets up to its quota of particles, and each one is filed in the wheel.
+
+    A particle is retired on the first frame that it would have been moved outside of the 
+    region, so, like the "structure of arrays" Update(...), it is never drawn outside.  A 
+    particle that isn't moving is never filed and stays active, the same as with the other 
+    updates.
+
+    Every call is treated as one frame of "delta time", so call this with the same delta time 
+    every frame or the expiries will be off by however much the frame length changed.
+Parameters:
+    particleStorage     The particle storage that will be updated.  Particles must only be 
+                        activated and deactivated by this method, or the wheel will be out of 
+                        step with the "active" mask.
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles after emission.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::UpdateScheduled(ParticleStorage &particleStorage, 
+    const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    ParticlePool &particles = particleStorage._allParticles;
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    ParticleTimingWheel &expiryWheel = particleStorage._expiryWheel;
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+
+    // retire this frame's expired particles
+    // Note: Inactive particles are still drawn, and these are just inside the region, so they 
+    // are parked out of sight like the ring's dead particles.
+    size_t firstExpired = freeIndices.size();
+    expiryWheel.Advance(&freeIndices);
+    for (size_t freeIndex = firstExpired; freeIndex < freeIndices.size(); freeIndex++)
+    {
+        unsigned int particleIndex = freeIndices[freeIndex];
+        activeMask.Deactivate(particleIndex);
+        particles[particleIndex]._position = PARKED_PARTICLE_POSITION;
+    }
+
+    // move everything that's left
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(0); 
+        chunkIndex < activeMask.NumChunks(); 
+        chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long remainingBits = activeMask.GetChunk(chunkIndex);
+        numActiveParticles += PopCount64(remainingBits);
+        while (remainingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(remainingBits);
+            remainingBits &= remainingBits - 1;
+
+            Particle &p = particles[chunkStart + bitIndex];
+            p._position = p._position + (p._velocity * deltaTimeSec);
+        }
+    }
+
+    // emit and schedule
+    unsigned int currentTick = expiryWheel.CurrentTick();
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > freeIndices.size())
+        {
+            numToEmit = freeIndices.size();
+        }
+
+        Particle emitted[PARTICLE_EMIT_BATCH_SIZE];
+        for (unsigned int batchStart = 0; batchStart < numToEmit; 
+            batchStart += PARTICLE_EMIT_BATCH_SIZE)
+        {
+            unsigned int numInBatch = numToEmit - batchStart;
+            if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+            {
+                numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+            }
+            _pEmitters[emitterIndex]->ResetParticles(emitted, numInBatch);
+
+            for (unsigned int batchIndex = 0; batchIndex < numInBatch; batchIndex++)
+            {
+                const Particle &p = emitted[batchIndex];
+                unsigned int particleIndex = freeIndices.back();
+                freeIndices.pop_back();
+                particles[particleIndex] = p;
+                activeMask.Activate(particleIndex);
+
+                unsigned int expiryTick = 0;
+                if (ExpiryTick(_pRegion->ExitTime(p._position, p._velocity), deltaTimeSec, 
+                    currentTick, &expiryTick))
+                {
+                    expiryWheel.Schedule(particleIndex, expiryTick);
+                }
+            }
+        }
+        numActiveParticles += numToEmit;
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The update for ParticleStorageStateless, where the GPU moves the particles.  The only 
+    per-frame work here is bookkeeping for the particles that expire and are emitted:
+    - The storage's timing wheel moves forward one frame, and the slots of the particles that 
+    left the region go back on the "free index" stack.  The shader has already hidden them, 
+    so nothing is written.
+    - Each emitter resets up to its quota of particles.  Each one's spawn record is written 
+    with the current tick and the tick on which it will leave the region (from 
+    IParticleRegion::ExitTime(...)), its slot is filed in the wheel, and the slot is marked 
+    for ParticleStorageStateless::UploadSpawned().
+
+    Like UpdateScheduled(...), every call is one frame of "delta time".
+Parameters:
+    particleStorage     Self-explanatory.
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles after emission.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::UpdateStateless(ParticleStorageStateless &particleStorage, 
+    const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    ParticleTimingWheel &expiryWheel = particleStorage._expiryWheel;
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+    particleStorage._numActiveParticles -= expiryWheel.Advance(&freeIndices);
+    particleStorage._tickSec = deltaTimeSec;
+
+    unsigned int currentTick = expiryWheel.CurrentTick();
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > freeIndices.size())
+        {
+            numToEmit = freeIndices.size();
+        }
+
+        Particle emitted[PARTICLE_EMIT_BATCH_SIZE];
+        for (unsigned int batchStart = 0; batchStart < numToEmit; 
+            batchStart += PARTICLE_EMIT_BATCH_SIZE)
+        {
+            unsigned int numInBatch = numToEmit - batchStart;
+            if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+            {
+                numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+            }
+            _pEmitters[emitterIndex]->ResetParticles(emitted, numInBatch);
+
+            for (unsigned int batchIndex = 0; batchIndex < numInBatch; batchIndex++)
+            {
+                const Particle &p = emitted[batchIndex];
+                unsigned int particleIndex = freeIndices.back();
+                freeIndices.pop_back();
+
+                // an expiry equal to the spawn means "never"
+                ParticleSpawn &spawn = particleStorage._allParticles[particleIndex];
+                spawn._spawnPosition = p._position;
+                spawn._velocity = p._velocity;
+                spawn._spawnTick = currentTick;
+                spawn._expiryTick = currentTick;
+                if (ExpiryTick(_pRegion->ExitTime(p._position, p._velocity), deltaTimeSec, 
+                    currentTick, &spawn._expiryTick))
+                {
+                    expiryWheel.Schedule(particleIndex, spawn._expiryTick);
+                }
+                particleStorage._spawnedIndices.push_back(particleIndex);
+            }
+        }
+        particleStorage._numActiveParticles += numToEmit;
+    }
+
+    return particleStorage._numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Used during initialization to give all particles initial values.  It would not do to have 
+    everyone with random values composed of whatever bits were already in the memory where they 
+    ended up.
+Parameters:
+    particleCollection  Self-explanatory
+Returns:    None
+Exception:  Safe
+Creator:    John Cox (8-13-2016)
+-----------------------------------------------------------------------------------------------*/
+void ParticleUpdater::ResetAllParticles(ParticlePool &particleCollection)
+{
+    // reset all particles evenly 
+    // Note: I could do a weighted fancy algorithm and account for the "particles emitted per frame" for each emitter, but this is just a demo program.
+    // Also Note: This integer division could leave a few particles unaffected, but those will quickly be swept up into the flow of things when "update" runs.
+    unsigned int particlesPerEmitter = particleCollection.Size() / _emitterCount;
+    for (size_t emitterIndex = 0; emitterIndex < _emitterCount; emitterIndex++)
+    {
+        for (size_t particleIndex = 0; particleIndex < particlesPerEmitter; particleIndex++)
+        {
+            _pEmitters[emitterIndex]->ResetParticle(&particleCollection[particleIndex]);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "structure of arrays" version of Update(...).  Same rules, but in two passes:
+    - Move all active particles.  Chunks with no active particles are skipped, and each 
+    occupied chunk goes to the integration kernel for this CPU (see ParticleKernels).
+    - Check if each active particle is out of bounds (64 at a time with the region's batch 
+    check), and if so, deactivate it and put its index on the "free index" stack for Emit(...).
+    
+    Moving first and checking bounds second means that a particle that leaves the region is 
+    deactivated before it is drawn outside of it.
+Parameters:
+    particleStorage     The particle arrays that will be updated.
+    startIndex          See the other Update(...).
+    numToUpdate         Same idea as "start index".
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::Update(ParticleStorageSoA &particleStorage, 
+    const unsigned int startIndex, const unsigned int numToUpdate, const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    unsigned int endIndex = startIndex + numToUpdate;
+    if (endIndex > particleStorage.Size())
+    {
+        endIndex = particleStorage.Size();
+    }
+
+    // grab the raw pointers so that the compiler doesn't have to prove anything about the 
+    // vectors inside the loop
+    float *posX = particleStorage._positionX.data();
+    float *posY = particleStorage._positionY.data();
+    const float *velX = particleStorage._velocityX.data();
+    const float *velY = particleStorage._velocityY.data();
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int endChunk = (endIndex + 63) / 64;
+
+    // the kernel multiplies inactive particles by 0 instead of skipping them; particles 
+    // outside of [startIndex, endIndex) are masked off the same way
+    const ParticleKernels &kernels = GetParticleKernels();
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex) & 
+            RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned int numInChunk = (endIndex < chunkStart + 64) ? (endIndex - chunkStart) : 64;
+        kernels._integrate(posX + chunkStart, posY + chunkStart, velX + chunkStart, 
+            velY + chunkStart, &activeBits, numInChunk, deltaTimeSec);
+    }
+
+    // deactivate particles that went out of bounds and make their slots available to Emit(...)
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long rangeBits = RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+
+        unsigned int numInChunk = (endIndex < chunkStart + 64) ? (endIndex - chunkStart) : 64;
+        unsigned long long outOfBoundsBits = 0;
+        _pRegion->OutOfBoundsBatch(MakePositionSpan(posX + chunkStart, posY + chunkStart, 
+            numInChunk), &outOfBoundsBits);
+
+        unsigned long long leavingBits = activeBits & rangeBits & outOfBoundsBits;
+        activeBits &= ~leavingBits;
+        while (leavingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(leavingBits);
+            leavingBits &= leavingBits - 1;
+            particleStorage._freeIndices.push_back(chunkStart + bitIndex);
+        }
+
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(activeBits & rangeBits);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "structure of arrays" version of Emit(...).
+Parameters:
+    particleStorage     The particle arrays whose inactive particles will be emitted.
+Returns:    
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::Emit(ParticleStorageSoA &particleStorage) const
+{
+    unsigned int remainingQuotas[MAX_EMITTERS];
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        remainingQuotas[emitterIndex] = _maxParticlesEmittedPerFrame[emitterIndex];
+    }
+
+    return EmitIntoFreeSlots(particleStorage, remainingQuotas, 
+        particleStorage._freeIndices.size());
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "structure of arrays" version of ResetAllParticles(...).  Gives each emitter an even 
+    share of the particles.
+Parameters:
+    particleStorage     Self-explanatory
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleUpdater::ResetAllParticles(ParticleStorageSoA &particleStorage)
+{
+    unsigned int particlesPerEmitter = particleStorage.Size() / _emitterCount;
+    for (size_t emitterIndex = 0; emitterIndex < _emitterCount; emitterIndex++)
+    {
+        unsigned int startIndex = emitterIndex * particlesPerEmitter;
+        for (size_t particleIndex = 0; particleIndex < particlesPerEmitter; particleIndex++)
+        {
+            _pEmitters[emitterIndex]->ResetParticle(&particleStorage, startIndex + particleIndex);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A version of Update(...) + Emit(...) for "structure of arrays" storage that works one tile 
+    (see SetTileSize(...)) at a time.  Each tile goes through every step before the next tile 
+    is touched:
+    - stages in PARTICLE_STAGE_BEFORE_INTEGRATE (forces)
+    - integration
+    - the bounds check
+    - emission into the slots that the bounds check just freed, out of what is left of each 
+    emitter's quota for the frame
+    - stages in PARTICLE_STAGE_AFTER_EMIT (collisions, counters)
+
+    The tile is small enough to stay in the L1 cache the whole time, so every step after the 
+    first reads it from the cache instead of memory.  The other Update(...) streams the whole 
+    storage through the cache once for integration and again for the bounds check, and a 
+    stage run on its own would be another pass, so each step added to it costs a pass over 
+    memory.
+
+    Whatever is left of the emitters' quotas after the last tile goes into older free slots, 
+    the same as Emit(...), so a frame emits as many particles as Update(...) + Emit(...) does.  
+    PARTICLE_STAGE_AFTER_EMIT stages don't see those particles until the next frame.
+Parameters:
+    particleStorage     The particle arrays that will be updated and emitted into.
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles, including the ones that were just emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::UpdateTiled(ParticleStorageSoA &particleStorage, 
+    const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    float *posX = particleStorage._positionX.data();
+    float *posY = particleStorage._positionY.data();
+    const float *velX = particleStorage._velocityX.data();
+    const float *velY = particleStorage._velocityY.data();
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+    const ParticleKernels &kernels = GetParticleKernels();
+
+    unsigned int remainingQuotas[MAX_EMITTERS];
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        remainingQuotas[emitterIndex] = _maxParticlesEmittedPerFrame[emitterIndex];
+    }
+
+    unsigned int numParticles = particleStorage.Size();
+    unsigned int numActiveParticles = 0;
+    for (unsigned int tileStart = 0; tileStart < numParticles; tileStart += _tileSize)
+    {
+        unsigned int tileEnd = (tileStart + _tileSize < numParticles) ? 
+            (tileStart + _tileSize) : numParticles;
+        unsigned int endChunk = (tileEnd + 63) / 64;
+
+        RunStages(particleStorage, PARTICLE_STAGE_BEFORE_INTEGRATE, tileStart, tileEnd, 
+            deltaTimeSec);
+
+        for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(tileStart / 64); 
+            chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+        {
+            unsigned int chunkStart = chunkIndex * 64;
+            unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+            unsigned int numInChunk = (tileEnd < chunkStart + 64) ? (tileEnd - chunkStart) : 64;
+            kernels._integrate(posX + chunkStart, posY + chunkStart, velX + chunkStart, 
+                velY + chunkStart, &activeBits, numInChunk, deltaTimeSec);
+        }
+
+        unsigned int numFreeBeforeTile = freeIndices.size();
+        for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(tileStart / 64); 
+            chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+        {
+            unsigned int chunkStart = chunkIndex * 64;
+            unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+            unsigned int numInChunk = (tileEnd < chunkStart + 64) ? (tileEnd - chunkStart) : 64;
+            unsigned long long outOfBoundsBits = 0;
+            _pRegion->OutOfBoundsBatch(MakePositionSpan(posX + chunkStart, posY + chunkStart, 
+                numInChunk), &outOfBoundsBits);
+
+            unsigned long long leavingBits = activeBits & outOfBoundsBits;
+            activeBits &= ~leavingBits;
+            while (leavingBits != 0)
+            {
+                unsigned int bitIndex = CountTrailingZeros64(leavingBits);
+                leavingBits &= leavingBits - 1;
+                freeIndices.push_back(chunkStart + bitIndex);
+            }
+
+            activeMask.SetChunk(chunkIndex, activeBits);
+            numActiveParticles += PopCount64(activeBits);
+        }
+
+        // the slots that this tile just freed are at the top of the stack
+        numActiveParticles += EmitIntoFreeSlots(particleStorage, remainingQuotas, 
+            freeIndices.size() - numFreeBeforeTile);
+
+        RunStages(particleStorage, PARTICLE_STAGE_AFTER_EMIT, tileStart, tileEnd, 
+            deltaTimeSec);
+    }
+
+    numActiveParticles += EmitIntoFreeSlots(particleStorage, remainingQuotas, 
+        freeIndices.size());
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Emits from the top of the "free index" stack.  Each emitter takes up to what is left of its 
+    quota, and all of them together take no more than the given number of slots.  The top of 
+    the stack is a contiguous array of indices, so each emitter scatters into all of its slots 
+    in one call before they are popped.
+Parameters:
+    particleStorage     The particle arrays whose inactive particles will be emitted.
+    remainingQuotas     One per emitter.  Reduced by the number that each one emitted.
+    numFreeSlots        The most slots to take off the stack.  Must not be more than the 
+                        stack has.
+Returns:    
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::EmitIntoFreeSlots(ParticleStorageSoA &particleStorage, 
+    unsigned int *remainingQuotas, unsigned int numFreeSlots) const
+{
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+    unsigned int numEmitted = 0;
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = remainingQuotas[emitterIndex];
+        if (numToEmit > numFreeSlots)
+        {
+            numToEmit = numFreeSlots;
+        }
+        if (numToEmit == 0)
+        {
+            continue;
+        }
+
+        unsigned int firstStackIndex = freeIndices.size() - numToEmit;
+        const unsigned int *particleIndices = freeIndices.data() + firstStackIndex;
+        _pEmitters[emitterIndex]->ResetParticles(&particleStorage, particleIndices, numToEmit);
+        for (unsigned int emitCount = 0; emitCount < numToEmit; emitCount++)
+        {
+            particleStorage._activeMask.Activate(particleIndices[emitCount]);
+        }
+        freeIndices.resize(firstStackIndex);
+
+        remainingQuotas[emitterIndex] -= numToEmit;
+        numFreeSlots -= numToEmit;
+        numEmitted += numToEmit;
+    }
+
+    return numEmitted;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs the stages in one slot, in the order that they were added, on one tile.
+Parameters:
+    particleStorage     Self-explanatory.
+    slot                Self-explanatory.
+    tileStart           See IParticleStage.
+    tileEnd             See IParticleStage.
+    deltaTimeSec        Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleUpdater::RunStages(ParticleStorageSoA &particleStorage, 
+    const ParticleStageSlot slot, const unsigned int tileStart, const unsigned int tileEnd, 
+    const float deltaTimeSec) const
+{
+    for (unsigned int stageIndex = 0; stageIndex < _stageCount; stageIndex++)
+    {
+        if (_stageSlots[stageIndex] == slot)
+        {
+            _pStages[stageIndex]->Run(&particleStorage, tileStart, tileEnd, deltaTimeSec);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "array of structures of arrays" version of Update(...).  Works one block at a time 
+    instead of one pass per job: all the particles in a block are moved (inactive ones are 
+    multiplied by 0, so the loop is a fixed-length, branch-free loop over one SIMD register's 
+    worth of each member), and then the block's active particles are checked against the 
+    region while the block is still in the cache.  Blocks with no active particles are skipped.
+Parameters:
+    particleStorage     The particle blocks that will be updated.
+    startIndex          See the other Update(...).
+    numToUpdate         Same idea as "start index".
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles in the range.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+unsigned int ParticleUpdater::Update(ParticleStorageAoSoA<BLOCK_SIZE> &particleStorage, 
+    const unsigned int startIndex, const unsigned int numToUpdate, const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    unsigned int endIndex = startIndex + numToUpdate;
+    if (endIndex > particleStorage.Size())
+    {
+        endIndex = particleStorage.Size();
+    }
+
+    typedef typename ParticleStorageAoSoA<BLOCK_SIZE>::Block Block;
+    const unsigned int BLOCKS_PER_CHUNK = 64 / BLOCK_SIZE;
+    const unsigned long long LANE_BITS = (1ULL << BLOCK_SIZE) - 1;
+
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int endChunk = (endIndex + 63) / 64;
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long rangeBits = RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+        for (unsigned int blockInChunk = 0; blockInChunk < BLOCKS_PER_CHUNK; blockInChunk++)
+        {
+            unsigned int blockShift = blockInChunk * BLOCK_SIZE;
+            unsigned long long blockBits = ((activeBits & rangeBits) >> blockShift) & LANE_BITS;
+            if (blockBits == 0)
+            {
+                continue;
+            }
+
+            Block &block = particleStorage._blocks[(chunkIndex * BLOCKS_PER_CHUNK) + blockInChunk];
+            for (unsigned int laneIndex = 0; laneIndex < BLOCK_SIZE; laneIndex++)
+            {
+                float stepSec = deltaTimeSec * (float)((blockBits >> laneIndex) & 1);
+                block._positionX[laneIndex] += block._velocityX[laneIndex] * stepSec;
+                block._positionY[laneIndex] += block._velocityY[laneIndex] * stepSec;
+            }
+
+            // a block's positions are contiguous, so the whole block is one batch
+            unsigned long long outOfBoundsBits = 0;
+            _pRegion->OutOfBoundsBatch(MakePositionSpan(block._positionX, block._positionY, 
+                BLOCK_SIZE), &outOfBoundsBits);
+            unsigned long long leavingBits = blockBits & outOfBoundsBits;
+            activeBits &= ~(leavingBits << blockShift);
+            while (leavingBits != 0)
+            {
+                unsigned int laneIndex = CountTrailingZeros64(leavingBits);
+                leavingBits &= leavingBits - 1;
+                particleStorage._freeIndices.push_back(chunkStart + blockShift + laneIndex);
+            }
+        }
+
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(activeBits & rangeBits);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "array of structures of arrays" version of Emit(...).  The emitters only know how to 
+    reset Particle structures, so each one resets a Particle that is then scattered into its 
+    block.
+Parameters:
+    particleStorage     The particle blocks whose inactive particles will be emitted.
+Returns:    
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<unsigned int BLOCK_SIZE>
+unsigned int ParticleUpdater::Emit(ParticleStorageAoSoA<BLOCK_SIZE> &particleStorage) const
+{
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+    unsigned int numEmitted = 0;
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > freeIndices.size())
+        {
+            numToEmit = freeIndices.size();
+        }
+
+        for (unsigned int emitCount = 0; emitCount < numToEmit; emitCount++)
+        {
+            unsigned int particleIndex = freeIndices.back();
+            freeIndices.pop_back();
+
+            Particle p;
+            _pEmitters[emitterIndex]->ResetParticle(&p);
+            particleStorage.SetParticle(particleIndex, p);
+            particleStorage._activeMask.Activate(particleIndex);
+        }
+        numEmitted += numToEmit;
+    }
+
+    return numEmitted;
+}
+
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The fixed-point version of Update(...).  Same walk over the "active" mask as the 
+    ParticleStorage version, but both the bounds check and the integration are integer math 
+    on 16-bit values (see ParticleFixedPoint.h).
+Parameters:
+    particleStorage     The fixed-point particles that will be updated.
+    startIndex          See the other Update(...).
+    numToUpdate         Same idea as "start index".
+    deltatimeSec        Converted once to a fixed-point step scale.
+Returns:    
+    The number of active particles in the range.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::Update(ParticleStorageFixedPoint &particleStorage, 
+    const unsigned int startIndex, const unsigned int numToUpdate, const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    std::vector<ParticleFixedPoint> &particleCollection = particleStorage._allParticles;
+    unsigned int endIndex = startIndex + numToUpdate;
+    if (endIndex > particleCollection.size())
+    {
+        endIndex = particleCollection.size();
+    }
+
+    int stepScale = FixedPointStepScale(deltaTimeSec);
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int endChunk = (endIndex + 63) / 64;
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long rangeBits = RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+        unsigned long long remainingBits = activeBits & rangeBits;
+        while (remainingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(remainingBits);
+            remainingBits &= remainingBits - 1;
+
+            unsigned int particleIndex = chunkStart + bitIndex;
+            ParticleFixedPoint &p = particleCollection[particleIndex];
+            if (_pRegion->OutOfBoundsFixedPoint(p._positionX, p._positionY))
+            {
+                activeBits &= ~(1ULL << bitIndex);
+                particleStorage._freeIndices.push_back(particleIndex);
+            }
+            else
+            {
+                p._positionX = FixedPointStep(p._positionX, p._velocityX, stepScale);
+                p._positionY = FixedPointStep(p._positionY, p._velocityY, stepScale);
+            }
+        }
+
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(activeBits & rangeBits);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The fixed-point version of Emit(...).  The emitters work in floats, so each emitted particle 
+    is reset in a temporary Particle and then converted.
+Parameters:
+    particleStorage     The storage whose inactive particles will be emitted.
+Returns:    
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::Emit(ParticleStorageFixedPoint &particleStorage) const
+{
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+    unsigned int numEmitted = 0;
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > freeIndices.size())
+        {
+            numToEmit = freeIndices.size();
+        }
+
+        for (unsigned int emitCount = 0; emitCount < numToEmit; emitCount++)
+        {
+            unsigned int particleIndex = freeIndices.back();
+            freeIndices.pop_back();
+
+            Particle emitted;
+            _pEmitters[emitterIndex]->ResetParticle(&emitted);
+            particleStorage._allParticles[particleIndex] = ToFixedPoint(emitted);
+            particleStorage._activeMask.Activate(particleIndex);
+        }
+        numEmitted += numToEmit;
+    }
+
+    return numEmitted;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The ring version of Update(...).  Only the live range(s) of the ring are visited.
+    - Each live particle's remaining lifetime counts down.  A particle whose lifetime ran out 
+    or that left the region is parked (moved off screen, stopped, and marked dead) unless it 
+    already was.  Everything else moves.
+    - Then dead particles are retired from the tail until the tail particle is alive.  Parked 
+    particles in the middle of the range wait until they reach the tail.
+Parameters:
+    particleStorage     The ring that will be updated.
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of particles that are alive (live and not parked).
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::Update(ParticleStorageRing &particleStorage, 
+    const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    std::vector<Particle> &particles = particleStorage._allParticles;
+    std::vector<float> &lifetimeRemaining = particleStorage._lifetimeRemainingSec;
+
+    unsigned int firstIndices[2];
+    unsigned int counts[2];
+    unsigned int numRanges = particleStorage.LiveRanges(firstIndices, counts);
+    unsigned int numAlive = 0;
+    for (unsigned int rangeIndex = 0; rangeIndex < numRanges; rangeIndex++)
+    {
+        unsigned int endIndex = firstIndices[rangeIndex] + counts[rangeIndex];
+        for (unsigned int particleIndex = firstIndices[rangeIndex]; particleIndex < endIndex; 
+            particleIndex++)
+        {
+            float &lifetimeSec = lifetimeRemaining[particleIndex];
+            if (lifetimeSec <= 0.0f)
+            {
+                // already parked
+                continue;
+            }
+
+            Particle &p = particles[particleIndex];
+            lifetimeSec -= deltaTimeSec;
+            if (lifetimeSec <= 0.0f || _pRegion->OutOfBounds(p._position))
+            {
+                lifetimeSec = 0.0f;
+                p._position = PARKED_PARTICLE_POSITION;
+                p._velocity = glm::vec2();
+            }
+            else
+            {
+                p._position = p._position + (p._velocity * deltaTimeSec);
+                numAlive++;
+            }
+        }
+    }
+
+    // retire from the tail
+    unsigned int capacity = particles.size();
+    while (particleStorage._numLive > 0 && 
+        lifetimeRemaining[particleStorage._tailIndex] <= 0.0f)
+    {
+        particleStorage._tailIndex++;
+        if (particleStorage._tailIndex == capacity)
+        {
+            particleStorage._tailIndex = 0;
+        }
+        particleStorage._numLive--;
+    }
+
+    return numAlive;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The ring version of Emit(...).  Each emitter appends up to its quota of new particles at 
+    the head of the ring, with its particle lifetime, until the ring is full.
+Parameters:
+    particleStorage     The ring that will get the new particles.
+Returns:    
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleUpdater::Emit(ParticleStorageRing &particleStorage) const
+{
+    unsigned int capacity = particleStorage._allParticles.size();
+    unsigned int numEmitted = 0;
+    for (size_t emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > capacity - particleStorage._numLive)
+        {
+            numToEmit = capacity - particleStorage._numLive;
+        }
+
+        // no lifetime means "until it leaves the region", which will happen before this runs out
+        float lifetimeSec = _particleLifetimeSec[emitterIndex];
+        if (lifetimeSec <= 0.0f)
+        {
+            lifetimeSec = FLT_MAX;
+        }
+
+        unsigned int headIndex = particleStorage._tailIndex + particleStorage._numLive;
+        if (headIndex >= capacity)
+        {
+            headIndex -= capacity;
+        }
+        // at most two contiguous runs: up to the end of the buffer, and then from the start
+        unsigned int emitCount = 0;
+        while (emitCount < numToEmit)
+        {
+            unsigned int numInRun = numToEmit - emitCount;
+            if (numInRun > capacity - headIndex)
+            {
+                numInRun = capacity - headIndex;
+            }
+            _pEmitters[emitterIndex]->ResetParticles(&particleStorage._allParticles[headIndex], 
+                numInRun);
+            for (unsigned int runIndex = 0; runIndex < numInRun; runIndex++)
+            {
+                particleStorage._lifetimeRemainingSec[headIndex + runIndex] = lifetimeSec;
+            }
+
+            emitCount += numInRun;
+            headIndex += numInRun;
+            if (headIndex == capacity)
+            {
+                headIndex = 0;
+            }
+        }
+        particleStorage._numLive += numToEmit;
+        numEmitted += numToEmit;
+    }
+
+    return numEmitted;
 }
 
+// see ParticleStorageAoSoA for why these are the only two
+template unsigned int ParticleUpdater::Update<8>(ParticleStorageAoSoA<8> &, const unsigned int, 
+    const unsigned int, const float) const;
+template unsigned int ParticleUpdater::Update<16>(ParticleStorageAoSoA<16> &, const unsigned int, 
+    const unsigned int, const float) const;
+template unsigned int ParticleUpdater::Emit<8>(ParticleStorageAoSoA<8> &) const;
+template unsigned int ParticleUpdater::Emit<16>(ParticleStorageAoSoA<16> &) const;
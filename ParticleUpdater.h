@@ -3,8 +3,21 @@
 #include "Particle.h"
 #include "IParticleEmitter.h"
 #include "IParticleRegion.h"
+#include "IParticleStage.h"
+#include "ParticleStorage.h"
+#include "ParticleStorageSoA.h"
+#include "ParticleStorageAoSoA.h"
+#include "ParticleStorageFixedPoint.h"
+#include "ParticleStorageRing.h"
+#include "ParticleStorageStateless.h"
+#include "ParticleSchemaStorage.h"
+#include "BitOperations.h"
 #include <vector>
 
+// forward declarations to avoid dragging the threading headers into everything
+class ParticleTaskScheduler;
+class ParticleEmissionBudget;
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Encapsulates particle updating with a given emitter and region.  The main function is the 
@@ -20,12 +33,74 @@ public:
     ParticleUpdater();
     
     void SetRegion(const IParticleRegion *pRegion);
-    void AddEmitter(const IParticleEmitter *pEmitter, const int maxParticlesEmittedPerFrame);
+    void AddEmitter(const IParticleEmitter *pEmitter, const int maxParticlesEmittedPerFrame, 
+        const float particleLifetimeSec = 0.0f);
     // no "remove emitter" method because this is just a demo
+    void AddStage(const IParticleStage *pStage, const ParticleStageSlot slot);
+    void SetTileSize(const unsigned int tileSize);
+    unsigned int TileSize() const;
 
-    unsigned int Update(std::vector<Particle> &particleCollection, const unsigned int startIndex, 
+    unsigned int Update(ParticleStorage &particleStorage, const unsigned int startIndex, 
         const unsigned int numToUpdate, const float deltaTimeSec) const;
-    void ResetAllParticles(std::vector<Particle> &particleCollection);
+    unsigned int Emit(ParticleStorage &particleStorage) const;
+    void ResetAllParticles(ParticlePool &particleCollection);
+
+    // moves every particle in an occupied chunk and masks the results instead of branching on 
+    // each one; use the same Emit(...) afterwards
+    unsigned int UpdatePredicated(ParticleStorage &particleStorage, 
+        const unsigned int startIndex, const unsigned int numToUpdate, 
+        const float deltaTimeSec) const;
+
+    // Update(...) + Emit(...) split into jobs on a work-stealing scheduler, which claim 
+    // emissions from shared atomic per-emitter budgets
+    unsigned int UpdateParallel(ParticleStorage &particleStorage, 
+        ParticleTaskScheduler &taskScheduler, const float deltaTimeSec) const;
+
+    // keeps active particles packed at the front of the storage
+    unsigned int UpdateCompacted(ParticleStorage &particleStorage, const float deltaTimeSec) const;
+
+    // retires particles on the frame that the region says they leave instead of checking them
+    unsigned int UpdateScheduled(ParticleStorage &particleStorage, const float deltaTimeSec) const;
+
+    // only emits and retires; the GPU moves the particles (see ParticleStorageStateless)
+    unsigned int UpdateStateless(ParticleStorageStateless &particleStorage, 
+        const float deltaTimeSec) const;
+
+    // "structure of arrays" versions
+    unsigned int Update(ParticleStorageSoA &particleStorage, const unsigned int startIndex, 
+        const unsigned int numToUpdate, const float deltaTimeSec) const;
+    unsigned int Emit(ParticleStorageSoA &particleStorage) const;
+    void ResetAllParticles(ParticleStorageSoA &particleStorage);
+
+    // runs the stages, integration, the bounds check, and emission one tile at a time
+    unsigned int UpdateTiled(ParticleStorageSoA &particleStorage, const float deltaTimeSec) const;
+
+    // "array of structures of arrays" versions (only defined for blocks of 8 and 16)
+    template<unsigned int BLOCK_SIZE>
+    unsigned int Update(ParticleStorageAoSoA<BLOCK_SIZE> &particleStorage, 
+        const unsigned int startIndex, const unsigned int numToUpdate, 
+        const float deltaTimeSec) const;
+    template<unsigned int BLOCK_SIZE>
+    unsigned int Emit(ParticleStorageAoSoA<BLOCK_SIZE> &particleStorage) const;
+
+    // fixed-point versions
+    unsigned int Update(ParticleStorageFixedPoint &particleStorage, 
+        const unsigned int startIndex, const unsigned int numToUpdate, 
+        const float deltaTimeSec) const;
+    unsigned int Emit(ParticleStorageFixedPoint &particleStorage) const;
+
+    // first-in, first-out ring version; the only one that uses the emitters' lifetimes
+    unsigned int Update(ParticleStorageRing &particleStorage, const float deltaTimeSec) const;
+    unsigned int Emit(ParticleStorageRing &particleStorage) const;
+
+    // versions for storages generated from a ParticleSchema<...> (defined below because they 
+    // work with any schema)
+    template<typename SCHEMA>
+    unsigned int Update(ParticleSchemaStorage<SCHEMA> &particleStorage, 
+        const unsigned int startIndex, const unsigned int numToUpdate, 
+        const float deltaTimeSec) const;
+    template<typename SCHEMA>
+    unsigned int Emit(ParticleSchemaStorage<SCHEMA> &particleStorage) const;
 
 private:
     // the form "const something *" means that it is a pointer to a const something, so the 
@@ -39,4 +114,139 @@ private:
     static const int MAX_EMITTERS = 5;
     const IParticleEmitter *_pEmitters[MAX_EMITTERS];
     unsigned int _maxParticlesEmittedPerFrame[MAX_EMITTERS];
+    float _particleLifetimeSec[MAX_EMITTERS];   // 0 means "until it leaves the region"
+
+    // extra steps for UpdateTiled(...), in the order that they were added
+    unsigned int _stageCount;
+    static const int MAX_STAGES = 5;
+    const IParticleStage *_pStages[MAX_STAGES];
+    ParticleStageSlot _stageSlots[MAX_STAGES];
+    unsigned int _tileSize;
+
+    unsigned int UpdateAndEmitJob(ParticleStorage &particleStorage, 
+        const unsigned int jobIndex, ParticleEmissionBudget &emissionBudget, 
+        const float deltaTimeSec) const;
+    unsigned int EmitIntoFreeSlots(ParticleStorageSoA &particleStorage, 
+        unsigned int *remainingQuotas, unsigned int numFreeSlots) const;
+    void RunStages(ParticleStorageSoA &particleStorage, const ParticleStageSlot slot, 
+        const unsigned int tileStart, const unsigned int tileEnd, 
+        const float deltaTimeSec) const;
 };
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The schema version of Update(...).  Same walk over the "active" mask as the 
+    ParticleStorage version, but the work per particle is whatever the schema generated in 
+    ParticleSchema<...>::Integrate(...), so a schema without velocity doesn't move and a schema 
+    without age doesn't age.
+
+    The bounds check happens before integration, same as the ParticleStorage version.
+Parameters:
+    particleStorage     The particle records that will be updated.
+    startIndex          See the other Update(...).
+    numToUpdate         Same idea as "start index".
+    deltatimeSec        Self-explanatory
+Returns:    
+    The number of active particles in the range.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename SCHEMA>
+unsigned int ParticleUpdater::Update(ParticleSchemaStorage<SCHEMA> &particleStorage, 
+    const unsigned int startIndex, const unsigned int numToUpdate, const float deltaTimeSec) const
+{
+    if (_emitterCount == 0 || _pRegion == 0)
+    {
+        return 0;
+    }
+
+    typedef typename SCHEMA::Record Record;
+    std::vector<Record> &particleCollection = particleStorage._allParticles;
+
+    unsigned int endIndex = startIndex + numToUpdate;
+    if (endIndex > particleCollection.size())
+    {
+        endIndex = particleCollection.size();
+    }
+
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int endChunk = (endIndex + 63) / 64;
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64); 
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long rangeBits = RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+        unsigned long long remainingBits = activeBits & rangeBits;
+        while (remainingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(remainingBits);
+            remainingBits &= remainingBits - 1;
+
+            unsigned int particleIndex = chunkStart + bitIndex;
+            Record &record = particleCollection[particleIndex];
+            if (_pRegion->OutOfBounds(GetAttribute<ParticleAttributePosition>(record)))
+            {
+                activeBits &= ~(1ULL << bitIndex);
+                particleStorage._freeIndices.push_back(particleIndex);
+            }
+            else
+            {
+                SCHEMA::Integrate(record, deltaTimeSec);
+            }
+        }
+
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(activeBits & rangeBits);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The schema version of Emit(...).  The emitters only know about Particle structures, so each 
+    emitted particle is reset in a temporary Particle, and then the schema fills in the record: 
+    defaults for every attribute, then the emitter's position and (if the schema has it) 
+    velocity.
+Parameters:
+    particleStorage     The storage whose inactive particles will be emitted.
+Returns:    
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename SCHEMA>
+unsigned int ParticleUpdater::Emit(ParticleSchemaStorage<SCHEMA> &particleStorage) const
+{
+    std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+    unsigned int numEmitted = 0;
+    for (unsigned int emitterIndex = 0; emitterIndex < MAX_EMITTERS; emitterIndex++)
+    {
+        if (_pEmitters[emitterIndex] == 0)
+        {
+            continue;
+        }
+
+        unsigned int numToEmit = _maxParticlesEmittedPerFrame[emitterIndex];
+        if (numToEmit > freeIndices.size())
+        {
+            numToEmit = freeIndices.size();
+        }
+
+        for (unsigned int emitCount = 0; emitCount < numToEmit; emitCount++)
+        {
+            unsigned int particleIndex = freeIndices.back();
+            freeIndices.pop_back();
+
+            Particle emitted;
+            _pEmitters[emitterIndex]->ResetParticle(&emitted);
+            SCHEMA::Emit(particleStorage._allParticles[particleIndex], emitted, emitterIndex);
+            particleStorage._activeMask.Activate(particleIndex);
+        }
+        numEmitted += numToEmit;
+    }
+
+    return numEmitted;
+}
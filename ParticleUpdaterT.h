@@ -0,0 +1,263 @@
+#pragma once
+
+#include "Particle.h"
+#include "ParticleStorage.h"
+#include "ParticleEmitBatch.h"
+#include "BitOperations.h"
+#include <tuple>
+#include <type_traits>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A ParticleUpdater whose region and emitters are template arguments instead of interface
+    pointers, for scenes whose region and emitters are known when the program is written.
+
+    Every call to the region and the emitters is qualified with the concrete type (ex:
+    pRegion->REGION::OutOfBoundsBatch(...)), so none of them go through the virtual table and 
+    the compiler is free to inline them.  The emitters are walked with compile-time recursion, 
+    so there is no emitter array and no empty slots to skip.
+
+    Note: The bounds check is still the region's batch check, one call per 64-particle chunk, 
+    instead of the per-particle OutOfBounds(...) inlined into the loop.  The inlined version 
+    was tried, and even with the face loop unrolled (ParticleRegionPolygonFixed<...>), it was 
+    slower than the batch check's SIMD kernel.  The virtual calls were already only one per 
+    chunk, so most of what this saves is on the emitter side.
+
+    It gives the same results as ParticleUpdater (same order of bounds check, move, and
+    emission), and ParticleUpdater is still there for anything that picks its region or
+    emitters at runtime.
+
+    Like ParticleUpdater, it won't delete the given pointers.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename REGION, typename... EMITTERS>
+class ParticleUpdaterT
+{
+public:
+    static const unsigned int NUM_EMITTERS = sizeof...(EMITTERS);
+
+    ParticleUpdaterT();
+
+    void SetRegion(const REGION *pRegion);
+    template<unsigned int EMITTER_INDEX>
+    void SetEmitter(const typename std::tuple_element<EMITTER_INDEX,
+        std::tuple<EMITTERS...> >::type *pEmitter, const unsigned int maxParticlesEmittedPerFrame);
+
+    unsigned int Update(ParticleStorage &particleStorage, const unsigned int startIndex,
+        const unsigned int numToUpdate, const float deltaTimeSec) const;
+    unsigned int Emit(ParticleStorage &particleStorage) const;
+
+private:
+    typedef std::integral_constant<unsigned int, NUM_EMITTERS> EmittersDone;
+
+    template<unsigned int EMITTER_INDEX>
+    unsigned int EmitFrom(ParticleStorage &particleStorage,
+        std::integral_constant<unsigned int, EMITTER_INDEX>) const;
+    unsigned int EmitFrom(ParticleStorage &, EmittersDone) const { return 0; }
+
+    const REGION *_pRegion;
+    std::tuple<const EMITTERS *...> _pEmitters;
+    unsigned int _maxParticlesEmittedPerFrame[NUM_EMITTERS];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives members initial values.  Nothing is updated or emitted until the region and every
+    emitter have been set.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename REGION, typename... EMITTERS>
+ParticleUpdaterT<REGION, EMITTERS...>::ParticleUpdaterT() :
+    _pRegion(0),
+    _pEmitters()
+{
+    static_assert(NUM_EMITTERS > 0, "ParticleUpdaterT needs at least one emitter");
+    for (unsigned int emitterIndex = 0; emitterIndex < NUM_EMITTERS; emitterIndex++)
+    {
+        _maxParticlesEmittedPerFrame[emitterIndex] = 0;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Self-explanatory.
+Parameters:
+    pRegion     A pointer to a region of the template's type.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename REGION, typename... EMITTERS>
+void ParticleUpdaterT<REGION, EMITTERS...>::SetRegion(const REGION *pRegion)
+{
+    _pRegion = pRegion;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The compile-time version of ParticleUpdater::AddEmitter(...).  The emitter's type is
+    checked against the template's emitter types.
+Parameters:
+    pEmitter                    The emitter for slot EMITTER_INDEX.
+    maxParticlesEmittedPerFrame Self-explanatory.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename REGION, typename... EMITTERS>
+template<unsigned int EMITTER_INDEX>
+void ParticleUpdaterT<REGION, EMITTERS...>::SetEmitter(const typename std::tuple_element<
+    EMITTER_INDEX, std::tuple<EMITTERS...> >::type *pEmitter,
+    const unsigned int maxParticlesEmittedPerFrame)
+{
+    std::get<EMITTER_INDEX>(_pEmitters) = pEmitter;
+    _maxParticlesEmittedPerFrame[EMITTER_INDEX] = maxParticlesEmittedPerFrame;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as ParticleUpdater::Update(ParticleStorage &, ...), but with a direct call to the 
+    region's batch check.
+Parameters:
+    particleStorage     The particle storage that will be updated.
+    startIndex          See ParticleUpdater::Update(...).
+    numToUpdate         Same idea as "start index".
+    deltatimeSec        Self-explanatory
+Returns:
+    The number of active particles in the range.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename REGION, typename... EMITTERS>
+unsigned int ParticleUpdaterT<REGION, EMITTERS...>::Update(ParticleStorage &particleStorage,
+    const unsigned int startIndex, const unsigned int numToUpdate, const float deltaTimeSec) const
+{
+    if (_pRegion == 0)
+    {
+        return 0;
+    }
+
+    ParticlePool &particleCollection = particleStorage._allParticles;
+    unsigned int endIndex = startIndex + numToUpdate;
+    if (endIndex > particleCollection.Size())
+    {
+        endIndex = particleCollection.Size();
+    }
+
+    ParticleActiveMask &activeMask = particleStorage._activeMask;
+    unsigned int endChunk = (endIndex + 63) / 64;
+    unsigned int numActiveParticles = 0;
+    for (unsigned int chunkIndex = activeMask.NextOccupiedChunk(startIndex / 64);
+        chunkIndex < endChunk; chunkIndex = activeMask.NextOccupiedChunk(chunkIndex + 1))
+    {
+        unsigned int chunkStart = chunkIndex * 64;
+        unsigned long long rangeBits = RangeMask64(chunkStart, startIndex, endIndex);
+        unsigned long long activeBits = activeMask.GetChunk(chunkIndex);
+
+        // Note: Pool segments are a multiple of 64 particles, so a chunk is always contiguous.
+        Particle *chunkParticles = &particleCollection[chunkStart];
+        unsigned int numInChunk = (endIndex < chunkStart + 64) ? (endIndex - chunkStart) : 64;
+        unsigned long long outOfBoundsBits = 0;
+        _pRegion->REGION::OutOfBoundsBatch(MakePositionSpan(chunkParticles, numInChunk), 
+            &outOfBoundsBits);
+
+        unsigned long long leavingBits = activeBits & rangeBits & outOfBoundsBits;
+        activeBits &= ~leavingBits;
+        while (leavingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(leavingBits);
+            leavingBits &= leavingBits - 1;
+            particleStorage._freeIndices.push_back(chunkStart + bitIndex);
+        }
+
+        unsigned long long remainingBits = activeBits & rangeBits;
+        while (remainingBits != 0)
+        {
+            unsigned int bitIndex = CountTrailingZeros64(remainingBits);
+            remainingBits &= remainingBits - 1;
+
+            Particle &p = chunkParticles[bitIndex];
+            p._position = p._position + (p._velocity * deltaTimeSec);
+        }
+
+        activeMask.SetChunk(chunkIndex, activeBits);
+        numActiveParticles += PopCount64(activeBits & rangeBits);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as ParticleUpdater::Emit(ParticleStorage &).  The emitters take their quotas in the
+    order of the template arguments.
+Parameters:
+    particleStorage     The particle storage whose inactive particles will be emitted.
+Returns:
+    The number of particles that were emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename REGION, typename... EMITTERS>
+unsigned int ParticleUpdaterT<REGION, EMITTERS...>::Emit(ParticleStorage &particleStorage) const
+{
+    return EmitFrom(particleStorage, std::integral_constant<unsigned int, 0>());
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Emits from one emitter and then recurses to the next one.  The overload for EmittersDone
+    ends the recursion.
+Parameters:
+    particleStorage     See Emit(...).
+    (unnamed)           Only used to pick the emitter at compile time.
+Returns:
+    The number of particles that this emitter and all the later ones emitted.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename REGION, typename... EMITTERS>
+template<unsigned int EMITTER_INDEX>
+unsigned int ParticleUpdaterT<REGION, EMITTERS...>::EmitFrom(ParticleStorage &particleStorage,
+    std::integral_constant<unsigned int, EMITTER_INDEX>) const
+{
+    typedef typename std::tuple_element<EMITTER_INDEX, std::tuple<EMITTERS...> >::type EMITTER;
+    const EMITTER *pEmitter = std::get<EMITTER_INDEX>(_pEmitters);
+
+    unsigned int numToEmit = 0;
+    if (pEmitter != 0)
+    {
+        std::vector<unsigned int> &freeIndices = particleStorage._freeIndices;
+        numToEmit = _maxParticlesEmittedPerFrame[EMITTER_INDEX];
+        if (numToEmit > freeIndices.size())
+        {
+            numToEmit = freeIndices.size();
+        }
+
+        Particle emitted[PARTICLE_EMIT_BATCH_SIZE];
+        for (unsigned int batchStart = 0; batchStart < numToEmit;
+            batchStart += PARTICLE_EMIT_BATCH_SIZE)
+        {
+            unsigned int numInBatch = numToEmit - batchStart;
+            if (numInBatch > PARTICLE_EMIT_BATCH_SIZE)
+            {
+                numInBatch = PARTICLE_EMIT_BATCH_SIZE;
+            }
+            pEmitter->EMITTER::ResetParticles(emitted, numInBatch);
+
+            for (unsigned int batchIndex = 0; batchIndex < numInBatch; batchIndex++)
+            {
+                unsigned int particleIndex = freeIndices.back();
+                freeIndices.pop_back();
+                particleStorage._allParticles[particleIndex] = emitted[batchIndex];
+                particleStorage._activeMask.Activate(particleIndex);
+            }
+        }
+    }
+
+    return numToEmit +
+        EmitFrom(particleStorage, std::integral_constant<unsigned int, EMITTER_INDEX + 1>());
+}
@@ -14,12 +14,18 @@ Description:
     Alternately, I could just make them functions and use a "fast random" algorithm that I found 
     online that doesn't require initialization.  I'll do that.
 
+    The generator's state is per thread so that the particle updater's worker threads can emit 
+    at the same time.  Threads start with the same state, so each worker seeds its own with 
+    SeedRandomForThisThread(...).
+
     And why the "Toast" in the file name?  Because this is a randomness handler and I thought of 
     toast.  2 + 2 = toast, obviously.
 Creator:    John Cox (6-25-2016)
 -----------------------------------------------------------------------------------------------*/
 
 float RandomOnRange0to1();
+void RandomOnRange0to1Batch(float *values, const unsigned int count);
+void SeedRandomForThisThread(const unsigned long long seed);
 unsigned long Random();
 long RandomPosAndNeg();
 glm::vec3 RandomColor();
@@ -7,10 +7,9 @@
 
 #include <stdio.h>
 
-// these are declared static here in order to avoid having to include Windows.h in the header
+// the CPU timer frequency only changes on system reset, so all stopwatches can share it
+// Note: This is declared static here in order to avoid having to include Windows.h in the header.
 static double gInverseCpuTimerFrequency;
-static LARGE_INTEGER gStartCounter;
-static LARGE_INTEGER gLastLapCounter;
 
 /*-----------------------------------------------------------------------------------------------
 Description:
@@ -37,10 +36,10 @@ Exception:  Safe
 Creator:    John Cox (??-2015)
 -----------------------------------------------------------------------------------------------*/
 Stopwatch::Stopwatch() :
-    _haveInitialized(false)
+    _haveInitialized(false),
+    _startCounter(0),
+    _lastLapCounter(0)
 {
-    gStartCounter.QuadPart = 0;
-    gLastLapCounter.QuadPart = 0;
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -84,8 +83,10 @@ void Stopwatch::Start()
     // Note: "On systems that run Windows XP or later, the function will always succeed and will 
     // thus never return zero."
     // http://msdn.microsoft.com/en-us/library/windows/desktop/ms644904(v=vs.85).aspx
-    QueryPerformanceCounter(&gStartCounter);
-    gLastLapCounter.QuadPart = gStartCounter.QuadPart;
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    _startCounter = now.QuadPart;
+    _lastLapCounter = now.QuadPart;
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -111,10 +112,10 @@ double Stopwatch::Lap()
 
     // calculate delta time relative to previous frame
     LARGE_INTEGER deltaLargeInt;
-    deltaLargeInt.QuadPart = now.QuadPart - gLastLapCounter.QuadPart;
+    deltaLargeInt.QuadPart = now.QuadPart - _lastLapCounter;
     double deltaTime = CounterToSeconds(deltaLargeInt);
 
-    gLastLapCounter.QuadPart = now.QuadPart;
+    _lastLapCounter = now.QuadPart;
 
     return deltaTime;
 }
@@ -140,7 +141,7 @@ double Stopwatch::TotalTime()
     QueryPerformanceCounter(&now);
 
     LARGE_INTEGER deltaLargeInt;
-    deltaLargeInt.QuadPart = now.QuadPart - gStartCounter.QuadPart;
+    deltaLargeInt.QuadPart = now.QuadPart - _startCounter;
     double deltaTime = CounterToSeconds(deltaLargeInt);
     
     return deltaTime;
@@ -24,5 +24,12 @@ public:
     void Reset();
 private:
     bool _haveInitialized;
+
+    // these are LARGE_INTEGER::QuadPart values, but Windows.h is too big to include here
+    // Note: These used to be file-static globals in the .cpp, which meant that every stopwatch 
+    // shared the same start and lap times.  That was fine when there was only the frame rate 
+    // timer, but the benchmarks need their own.
+    long long _startCounter;
+    long long _lastLapCounter;
 };
 
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Hands whole objects from one writer thread to one reader thread without either of them ever
+    waiting on the other.
+
+    There are three buffers.  The writer owns one and fills it, the reader owns one and reads
+    it, and the third is in the middle.  Publish() swaps the writer's buffer with the middle
+    one and marks it as new.  Update() swaps the reader's buffer with the middle one, but only
+    if it's new, so the reader always ends up with the latest buffer that was published and
+    never one that is being written.  If the writer publishes several times before the reader
+    updates, the older ones are just overwritten, and if the reader updates more often than the
+    writer publishes, it keeps the one that it has.
+
+    Both swaps are a single atomic exchange of the middle buffer's index (with the "new" bit
+    in the same word), so there is nothing to lock.  Only one thread may write and only one may
+    read.
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer();
+    void Reset();
+
+    // writer only
+    T &WriteBuffer();
+    void Publish();
+
+    // reader only
+    bool Update();
+    const T &ReadBuffer() const;
+
+    // only when neither thread is using it, like for allocating every buffer up front
+    T &Buffer(const unsigned int bufferIndex);
+
+private:
+    // not copyable, just like the atomic
+    TripleBuffer(const TripleBuffer &);
+    TripleBuffer &operator=(const TripleBuffer &);
+
+    static const unsigned int INDEX_MASK = 0x3;
+    static const unsigned int NEW_BIT = 0x4;
+
+    T _buffers[3];
+    unsigned int _writeIndex;
+    std::atomic<unsigned int> _middle;  // index | NEW_BIT if it was published since the last Update()
+    unsigned int _readIndex;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.  The writer gets buffer 0,
+    the reader gets buffer 2, and nothing has been published.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+TripleBuffer<T>::TripleBuffer()
+{
+    Reset();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Goes back to having published nothing.  The buffers themselves are left alone.  Must not be
+    called while either thread is using the triple buffer.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+void TripleBuffer<T>::Reset()
+{
+    _writeIndex = 0;
+    _middle.store(1);
+    _readIndex = 2;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the buffer that the writer is filling.  It changes after each
+    Publish(), and the new one has whatever was published two or three times ago (or nothing,
+    at first), so the writer must fill all of it again.
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+T &TripleBuffer<T>::WriteBuffer()
+{
+    return _buffers[_writeIndex];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes the write buffer the latest one for the reader and gives the writer the middle one to
+    fill next.  Never waits.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+void TripleBuffer<T>::Publish()
+{
+    // release so that the reader sees everything that was written, and acquire so that the
+    // writer doesn't write over what the reader was doing with the buffer it gets back
+    _writeIndex = _middle.exchange(_writeIndex | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the latest published buffer, if there is one that the reader doesn't already have.
+    Never waits.
+Parameters: None
+Returns:
+    True if the read buffer changed, otherwise false.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+bool TripleBuffer<T>::Update()
+{
+    // the "new" bit can only be cleared by this thread, so checking first is safe and saves
+    // an exchange when nothing was published
+    if ((_middle.load(std::memory_order_relaxed) & NEW_BIT) == 0)
+    {
+        return false;
+    }
+    _readIndex = _middle.exchange(_readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the buffer that the reader has.  It stays the same until Update().
+Parameters: None
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+const T &TripleBuffer<T>::ReadBuffer() const
+{
+    return _buffers[_readIndex];
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for any of the three buffers, no matter who has it.  Only for when neither
+    thread is using the triple buffer.
+Parameters:
+    bufferIndex     0, 1, or 2.
+Returns:
+    See description.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+template<typename T>
+T &TripleBuffer<T>::Buffer(const unsigned int bufferIndex)
+{
+    return _buffers[bufferIndex];
+}
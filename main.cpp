@@ -51,7 +51,19 @@
 #include "ParticleEmitterPoint.h"
 #include "ParticleEmitterBar.h"
 #include "ParticleStorage.h"
+#include "ParticleStorageSoA.h"
+#include "ParticleStorageAoSoA.h"
+#include "ParticleStorageFixedPoint.h"
+#include "ParticleStorageRing.h"
+#include "ParticleSchemaStorage.h"
 #include "ParticleUpdater.h"
+#include "ParticleBenchmark.h"
+#include "ParticleKernels.h"
+#include "ParticleTaskScheduler.h"
+#include "ParticleSimulationThread.h"
+
+// for running the frame's phases side by side
+#include "FrameTaskGraph.h"
 
 // for moving the shapes around in window space
 #include "glm/gtc/matrix_transform.hpp"
@@ -65,9 +77,24 @@ Stopwatch gTimer;
 
 FreeTypeEncapsulated gTextAtlases;
 
+// written by LayOutHud(...) on any thread, drawn by DrawHud() on the main thread
+char gFrameRateText[32];
+char gActiveParticlesText[32];
+
+// the frame's phases (see InitFrameTaskGraph()); 'g' dumps the next frame's timings
+FrameTaskGraph gFrameTaskGraph;
+bool gDumpFrameTaskGraph = false;
+
+// the particle update runs a frame ahead of the draw, so the counts are passed between them 
+// instead of being local to Display()
+unsigned int gNumActiveParticles = 0;
+unsigned int gNumDrawnParticles = 0;
+
 // in a bigger program, uniform locations would probably be stored in the same place as the 
 // shader programs
 GLint gUnifMatrixTransformLoc;
+GLint gUnifCurrentTickLoc;
+GLint gUnifTickSecLoc;
 
 // in a bigger program, geometry data would be stored in some kind of "scene" or in a renderer
 // or behind door number 3 so that collision boxes could get at the vertex data
@@ -81,16 +108,78 @@ glm::mat4 gRegionTransformMatrix;
 // in a bigger program, ??where would particle stuff be stored??
 IParticleRegion *gpParticleRegionCircle;
 IParticleRegion *gpParticleRegionPolygon;
-IParticleEmitter *gpParticleEmitterPoint;
-IParticleEmitter *gpParticleEmitterBar;
+ParticleRegionPolygonFixed<4> *gpParticleRegionPolygonFixed;
+ParticleEmitterPoint *gpParticleEmitterPoint;
+ParticleEmitterBar *gpParticleEmitterBar;
 ParticleUpdater gParticleUpdater;
 
+// the same scene with its types fixed at compile time; used for the default storage mode
+DemoParticleUpdaterT gParticleUpdaterFixed;
+
 // divide between the circle and the polygon regions
 // Note: 
 // - 10,000 particles => ~60 fps on my computer
 // - 15,000 particles => 30-40 fps on my computer
-const unsigned int MAX_PARTICLE_COUNT = 15000;
+// Also Note: The "array of structures" storages (modes 1, 3, 8, and 0) can be resized at runtime 
+// with the +/- keys (see Keyboard(...)); the others stay at the initial count.
+const unsigned int INITIAL_PARTICLE_COUNT = 15000;
+unsigned int gParticleCount = INITIAL_PARTICLE_COUNT;
 ParticleStorage gParticleStorage;
+ParticleStorageSoA gParticleStorageSoA;
+ParticleStorage gParticleStorageCompacted;
+ParticleStorage gParticleStorageScheduled;
+ParticleStorageStateless gParticleStorageStateless;
+
+// updated by every hardware thread at once (see ParticleUpdater::UpdateParallel(...))
+ParticleStorage gParticleStorageParallel;
+ParticleTaskScheduler gParticleTaskScheduler;
+
+// simulated on its own thread and drawn from the latest finished step; the storage is only 
+// used for its buffer and VAO (see ParticleSimulationThread)
+ParticleSimulationThread gParticleSimulationThread;
+ParticleStorage gParticleStorageThreaded;
+unsigned long long gLastUploadedSimulationStep = 0;
+
+// 8 floats per member fill one AVX register; use 16 on machines with AVX-512
+const unsigned int PARTICLE_BLOCK_SIZE = 8;
+ParticleStorageAoSoA<PARTICLE_BLOCK_SIZE> gParticleStorageAoSoA;
+ParticleStorageFixedPoint gParticleStorageFixedPoint;
+ParticleStorageRing gParticleStorageRing;
+
+// a particle system that only pays for the attributes it declares; this one colors particles 
+// by emitter and draws them bigger, and doesn't carry age or emitter ID
+typedef ParticleSchema<ParticleAttributePosition, ParticleAttributeVelocity, 
+    ParticleAttributeColor, ParticleAttributeSize> ColoredParticleSchema;
+ParticleSchemaStorage<ColoredParticleSchema> gParticleStorageColored;
+
+// the storage layout benchmark (see Keyboard(...)) runs at a much higher particle count than 
+// the demo so that the particles don't all fit in the cache
+const unsigned int BENCHMARK_PARTICLE_COUNT = 1000000;
+
+// except for the polygon benchmarks, which are about compute and should stay in it
+const unsigned int BENCHMARK_IN_CACHE_PARTICLE_COUNT = 16384;
+
+// and the parallel update benchmark, which needs enough particles to keep many cores busy
+const unsigned int BENCHMARK_PARALLEL_PARTICLE_COUNT = 5000000;
+
+// every storage layout is initialized up front and shares the same updater, but only the 
+// selected one is updated and drawn each frame; the number keys switch between them (see 
+// Keyboard(...))
+enum ParticleStorageMode
+{
+    PARTICLE_STORAGE_AOS = 0,   // "array of structures"; std::vector<Particle>
+    PARTICLE_STORAGE_SOA,       // "structure of arrays"; one array per particle member
+    PARTICLE_STORAGE_COMPACTED, // array of structures with active particles packed at the front
+    PARTICLE_STORAGE_AOSOA,     // "array of structures of arrays"; blocks of PARTICLE_BLOCK_SIZE
+    PARTICLE_STORAGE_SCHEMA,    // array of records generated from ColoredParticleSchema
+    PARTICLE_STORAGE_FIXED_POINT,   // array of 16-bit fixed-point structures
+    PARTICLE_STORAGE_RING,      // first-in, first-out ring of particles with lifetimes
+    PARTICLE_STORAGE_SCHEDULED, // array of structures retired by precomputed exit frames
+    PARTICLE_STORAGE_STATELESS, // spawn records only; the vertex shader moves the particles
+    PARTICLE_STORAGE_PARALLEL,  // array of structures updated on every hardware thread
+    PARTICLE_STORAGE_THREADED,  // array of structures updated on its own thread
+};
+ParticleStorageMode gParticleStorageMode = PARTICLE_STORAGE_AOS;
 
 
 
@@ -136,6 +225,11 @@ void Init()
     shaderStorageRef.LinkShader("particles");
     GLuint particleProgramId = shaderStorageRef.GetShaderProgram("particles");
 
+    // the particle shader sets the point size, and storages that don't send color or size get 
+    // white, 1-pixel particles
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    SetDefaultParticleVertexAttributes();
+
     // the circle starts centered on the origin and the translate matrix will move it
     // Note: The 1.0f makes it translatable.
     gRegionTransformMatrix = glm::translate(glm::mat4(), glm::vec3(+0.3f, +0.3f, 0.0f));
@@ -155,6 +249,12 @@ void Init()
     polygonCorners.push_back(glm::vec2(-0.5f, +0.25f));
     gpParticleRegionPolygon = new ParticleRegionPolygon(polygonCorners);
     gpParticleRegionPolygon->SetTransform(gRegionTransformMatrix);
+    glm::vec2 polygonCornerArray[4] = 
+    { 
+        polygonCorners[0], polygonCorners[1], polygonCorners[2], polygonCorners[3] 
+    };
+    gpParticleRegionPolygonFixed = new ParticleRegionPolygonFixed<4>(polygonCornerArray);
+    gpParticleRegionPolygonFixed->SetTransform(gRegionTransformMatrix);
 
 
     // stick the point emitter in the center (changing this would only require some addition/subtraction from the "circle center"
@@ -173,12 +273,50 @@ void Init()
     gpParticleEmitterBar->SetTransform(gRegionTransformMatrix);
 
     // stick the particle region and emitters into a single "updater" object
-    gParticleStorage.Init(particleProgramId, MAX_PARTICLE_COUNT);
+    // ask for huge pages for the resizable storages (each pool segment is one 2MB page); the 
+    // parallel storage leaves the first touch to the scheduler's workers (see 
+    // ParticleUpdater::UpdateParallel(...)), and the others are updated on this thread anyway
+    gParticleStorage._allParticles.SetMemoryPolicy(PARTICLE_MEMORY_TRANSPARENT_HUGE_PAGES, false);
+    gParticleStorageCompacted._allParticles.SetMemoryPolicy(
+        PARTICLE_MEMORY_TRANSPARENT_HUGE_PAGES, false);
+    gParticleStorageParallel._allParticles.SetMemoryPolicy(
+        PARTICLE_MEMORY_TRANSPARENT_HUGE_PAGES, true);
+    gParticleStorage.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    printf("particle memory: requested %s, applied %s\n", 
+        ParticleMemoryPolicyName(gParticleStorage._allParticles.RequestedMemoryPolicy()), 
+        ParticleMemoryPolicyName(gParticleStorage._allParticles.AppliedMemoryPolicy()));
+    printf("particle kernels: %s\n", ParticleKernelVariantName(GetParticleKernels()._variant));
     //gParticleUpdater.SetRegion(gpParticleRegionCircle);
     gParticleUpdater.SetRegion(gpParticleRegionPolygon);
-    gParticleUpdater.AddEmitter(gpParticleEmitterBar, 10);
-    gParticleUpdater.AddEmitter(gpParticleEmitterPoint, 10);
+    gParticleUpdater.AddEmitter(gpParticleEmitterBar, 10, 1.5f);
+    gParticleUpdater.AddEmitter(gpParticleEmitterPoint, 10, 1.0f);
     gParticleUpdater.ResetAllParticles(gParticleStorage._allParticles);
+    gParticleUpdaterFixed.SetRegion(gpParticleRegionPolygonFixed);
+    gParticleUpdaterFixed.SetEmitter<0>(gpParticleEmitterBar, 10);
+    gParticleUpdaterFixed.SetEmitter<1>(gpParticleEmitterPoint, 10);
+    gParticleStorageSoA.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleUpdater.ResetAllParticles(gParticleStorageSoA);
+    gParticleStorageCompacted.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleStorageAoSoA.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleStorageColored.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleStorageFixedPoint.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleStorageRing.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleStorageScheduled.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleStorageParallel.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleTaskScheduler.Init(0);
+    gParticleStorageThreaded.Init(particleProgramId, INITIAL_PARTICLE_COUNT);
+    gParticleSimulationThread.Init(&gParticleUpdater, INITIAL_PARTICLE_COUNT, 0.01f);
+
+    // the stateless storage has its own vertex shader (same fragment shader) because it sends 
+    // spawn records instead of positions
+    shaderStorageRef.NewShader("particlesStateless");
+    shaderStorageRef.AddShaderFile("particlesStateless", "shaderParticleStateless.vert", GL_VERTEX_SHADER);
+    shaderStorageRef.AddShaderFile("particlesStateless", "shaderParticle.frag", GL_FRAGMENT_SHADER);
+    shaderStorageRef.LinkShader("particlesStateless");
+    GLuint particleStatelessProgramId = shaderStorageRef.GetShaderProgram("particlesStateless");
+    gUnifCurrentTickLoc = shaderStorageRef.GetUniformLocation("particlesStateless", "currentTick");
+    gUnifTickSecLoc = shaderStorageRef.GetUniformLocation("particlesStateless", "tickSec");
+    gParticleStorageStateless.Init(particleStatelessProgramId, INITIAL_PARTICLE_COUNT);
     
     // geometry for particle region borders
     shaderStorageRef.NewShader("geometry");
@@ -203,46 +341,242 @@ void Init()
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    This is the rendering function.  It tells OpenGL to clear out some color and depth buffers,
-    to set up the data to draw, to draw than stuff, and to report any errors that it came across.
-    This is not a user-called function.
-
-    This function is registered with glutDisplayFunc(...) during glut's initialization.
+    Updates and emits the particles of the storage that is being drawn.  Only CPU work, so it 
+    can run on any thread (see InitFrameTaskGraph()).  The simulation thread's storage is 
+    updated on that thread instead, so that mode does nothing here.
 Parameters: None
-Returns:    None
+Returns:    
+    The number of active particles after the update.
 Exception:  Safe
-Creator:    John Cox (2-13-2016)
+Creator:    agent (10-17-2026)
 -----------------------------------------------------------------------------------------------*/
-void Display()
+unsigned int UpdateParticles()
 {
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClearDepth(1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    unsigned int numActiveParticles = 0;
+    if (gParticleStorageMode == PARTICLE_STORAGE_SOA)
+    {
+        numActiveParticles = gParticleUpdater.Update(gParticleStorageSoA, 0, 
+            gParticleStorageSoA.Size(), 0.01f);
+        numActiveParticles += gParticleUpdater.Emit(gParticleStorageSoA);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_COMPACTED)
+    {
+        numActiveParticles = gParticleUpdater.UpdateCompacted(gParticleStorageCompacted, 0.01f);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_SCHEDULED)
+    {
+        numActiveParticles = gParticleUpdater.UpdateScheduled(gParticleStorageScheduled, 0.01f);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_PARALLEL)
+    {
+        numActiveParticles = gParticleUpdater.UpdateParallel(gParticleStorageParallel, 
+            gParticleTaskScheduler, 0.01f);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_THREADED)
+    {
+        // already done on the simulation thread
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_STATELESS)
+    {
+        numActiveParticles = gParticleUpdater.UpdateStateless(gParticleStorageStateless, 0.01f);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_AOSOA)
+    {
+        numActiveParticles = gParticleUpdater.Update(gParticleStorageAoSoA, 0, 
+            gParticleStorageAoSoA.Size(), 0.01f);
+        numActiveParticles += gParticleUpdater.Emit(gParticleStorageAoSoA);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_SCHEMA)
+    {
+        numActiveParticles = gParticleUpdater.Update(gParticleStorageColored, 0, 
+            gParticleStorageColored.Size(), 0.01f);
+        numActiveParticles += gParticleUpdater.Emit(gParticleStorageColored);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_FIXED_POINT)
+    {
+        numActiveParticles = gParticleUpdater.Update(gParticleStorageFixedPoint, 0, 
+            gParticleStorageFixedPoint.Size(), 0.01f);
+        numActiveParticles += gParticleUpdater.Emit(gParticleStorageFixedPoint);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_RING)
+    {
+        numActiveParticles = gParticleUpdater.Update(gParticleStorageRing, 0.01f);
+        numActiveParticles += gParticleUpdater.Emit(gParticleStorageRing);
+    }
+    else
+    {
+        unsigned int numParticles = gParticleStorage._allParticles.Size();
+        numActiveParticles = gParticleUpdaterFixed.Update(gParticleStorage, 0, numParticles, 
+            0.01f);
+        numActiveParticles += gParticleUpdaterFixed.Emit(gParticleStorage);
+    }
 
-    // update all particle locations
-    unsigned int numActiveParticles = gParticleUpdater.Update(gParticleStorage._allParticles, 0, 
-        gParticleStorage._allParticles.size(), 0.01f);
+    return numActiveParticles;
+}
 
-    // draw the particles
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sends the particles of the storage that is being drawn to its OpenGL buffer and draws them.
+    Must be on the main thread.
+Parameters:
+    numActiveParticles  From the last UpdateParticles().
+Returns:    
+    The number of active particles that were drawn, which is the given number except for the 
+    compacted storage (which counts its own) and the simulation thread's storage.
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int UploadAndDrawParticles(unsigned int numActiveParticles)
+{
     glUseProgram(ShaderStorage::GetInstance().GetShaderProgram("particles"));
-    glBindVertexArray(gParticleStorage._vaoId);
-    glBindBuffer(GL_ARRAY_BUFFER, gParticleStorage._arrayBufferId);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, gParticleStorage._sizeBytes, gParticleStorage._allParticles.data());
-    glDrawArrays(gParticleStorage._drawStyle, 0, gParticleStorage._allParticles.size());
-
-    // draw the particle region borders
-    glUseProgram(ShaderStorage::GetInstance().GetShaderProgram("geometry"));
-    glUniformMatrix4fv(gUnifMatrixTransformLoc, 1, GL_FALSE, glm::value_ptr(gRegionTransformMatrix));
-    //glBindVertexArray(gCircleGeometry._vaoId);
-    //glDrawElements(gCircleGeometry._drawStyle, gCircleGeometry._indices.size(), GL_UNSIGNED_SHORT, 0);
-    glBindVertexArray(gPolygonGeometry._vaoId);
-    glDrawElements(gPolygonGeometry._drawStyle, gPolygonGeometry._indices.size(), GL_UNSIGNED_SHORT, 0);
-
-    // draw the frame rate once per second in the lower left corner
-    // Note: The font textures' orgin is their lower left corner, so the "lower left" in screen 
-    // space is just above [-1.0f, -1.0f].
-    GLfloat color[4] = { 0.5f, 0.5f, 0.0f, 1.0f };
-    char str[32];
+
+    // the schema storage sends color and size as arrays, which leaves the default values 
+    // undefined for everyone else after it is drawn, so set them again each time
+    SetDefaultParticleVertexAttributes();
+    if (gParticleStorageMode == PARTICLE_STORAGE_SOA)
+    {
+        // X and Y arrays are back to back in the buffer
+        unsigned int positionSizeBytes = gParticleStorageSoA._positionSizeBytes;
+        glBindVertexArray(gParticleStorageSoA._vaoId);
+        glBindBuffer(GL_ARRAY_BUFFER, gParticleStorageSoA._arrayBufferId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, positionSizeBytes, gParticleStorageSoA._positionX.data());
+        glBufferSubData(GL_ARRAY_BUFFER, positionSizeBytes, positionSizeBytes, gParticleStorageSoA._positionY.data());
+        glDrawArrays(gParticleStorageSoA._drawStyle, 0, gParticleStorageSoA.Size());
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_COMPACTED)
+    {
+        // only the active particles at the front are uploaded and drawn
+        // Note: The count comes from the storage and not from the last update, which may have 
+        // been of another storage (just after a mode switch) or from before a resize.
+        unsigned int numCompacted = gParticleStorageCompacted._numActiveParticles;
+        unsigned int numParticles = gParticleStorageCompacted._allParticles.Size();
+        numActiveParticles = (numCompacted < numParticles) ? numCompacted : numParticles;
+        glBindVertexArray(gParticleStorageCompacted._vaoId);
+        gParticleStorageCompacted.Upload(numActiveParticles);
+        glDrawArrays(gParticleStorageCompacted._drawStyle, 0, numActiveParticles);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_SCHEDULED)
+    {
+        unsigned int numParticles = gParticleStorageScheduled._allParticles.Size();
+        glBindVertexArray(gParticleStorageScheduled._vaoId);
+        gParticleStorageScheduled.Upload(numParticles);
+        glDrawArrays(gParticleStorageScheduled._drawStyle, 0, numParticles);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_PARALLEL)
+    {
+        // the particles past the first untouched one haven't been placed by the workers yet 
+        // (just after a mode switch or a resize), so they're neither uploaded nor drawn
+        // Note: Reading them here would fault their pages in on this thread's node instead.
+        unsigned int numParticles = gParticleStorageParallel._allParticles.FirstUntouchedIndex();
+        glBindVertexArray(gParticleStorageParallel._vaoId);
+        gParticleStorageParallel.Upload(numParticles);
+        glDrawArrays(gParticleStorageParallel._drawStyle, 0, numParticles);
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_THREADED)
+    {
+        // never waits for the simulation; draws whatever step it finished last, and only 
+        // uploads it if it wasn't uploaded already (the simulation may be slower than this)
+        // Note: Until the first step is published, there's nothing in the buffer to draw.
+        const ParticleFrame &frame = gParticleSimulationThread.LatestFrame();
+        unsigned int numParticles = frame._particles.size();
+        numActiveParticles = frame._numActiveParticles;
+
+        if (frame._stepIndex != 0)
+        {
+            glBindVertexArray(gParticleStorageThreaded._vaoId);
+            if (frame._stepIndex != gLastUploadedSimulationStep)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, gParticleStorageThreaded._arrayBufferId);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, numParticles * sizeof(Particle), 
+                    frame._particles.data());
+                gLastUploadedSimulationStep = frame._stepIndex;
+            }
+            glDrawArrays(gParticleStorageThreaded._drawStyle, 0, numParticles);
+        }
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_STATELESS)
+    {
+        // nothing is moved on the CPU, and only the newly spawned particles are uploaded
+        glUseProgram(ShaderStorage::GetInstance().GetShaderProgram("particlesStateless"));
+        glUniform1ui(gUnifCurrentTickLoc, gParticleStorageStateless._expiryWheel.CurrentTick());
+        glUniform1f(gUnifTickSecLoc, gParticleStorageStateless._tickSec);
+        glBindVertexArray(gParticleStorageStateless._vaoId);
+        gParticleStorageStateless.UploadSpawned();
+        glDrawArrays(gParticleStorageStateless._drawStyle, 0, gParticleStorageStateless.Size());
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_AOSOA)
+    {
+        // upload all the blocks at once, then draw one lane at a time by sliding the start of 
+        // the vertex buffer binding over by one float per lane; the stride is a whole block
+        glBindVertexArray(gParticleStorageAoSoA._vaoId);
+        glBindBuffer(GL_ARRAY_BUFFER, gParticleStorageAoSoA._arrayBufferId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, gParticleStorageAoSoA._sizeBytes, 
+            gParticleStorageAoSoA._blocks.data());
+        for (unsigned int laneIndex = 0; laneIndex < PARTICLE_BLOCK_SIZE; laneIndex++)
+        {
+            GLintptr laneOffsetBytes = laneIndex * sizeof(float);
+            glBindVertexBuffer(0, gParticleStorageAoSoA._arrayBufferId, laneOffsetBytes, 
+                sizeof(ParticleStorageAoSoA<PARTICLE_BLOCK_SIZE>::Block));
+            glDrawArrays(gParticleStorageAoSoA._drawStyle, 0, 
+                gParticleStorageAoSoA.NumParticlesInLane(laneIndex));
+        }
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_SCHEMA)
+    {
+        glBindVertexArray(gParticleStorageColored._vaoId);
+        glBindBuffer(GL_ARRAY_BUFFER, gParticleStorageColored._arrayBufferId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, gParticleStorageColored._sizeBytes, 
+            gParticleStorageColored._allParticles.data());
+        glDrawArrays(gParticleStorageColored._drawStyle, 0, gParticleStorageColored.Size());
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_FIXED_POINT)
+    {
+        glBindVertexArray(gParticleStorageFixedPoint._vaoId);
+        glBindBuffer(GL_ARRAY_BUFFER, gParticleStorageFixedPoint._arrayBufferId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, gParticleStorageFixedPoint._sizeBytes, 
+            gParticleStorageFixedPoint._allParticles.data());
+        glDrawArrays(gParticleStorageFixedPoint._drawStyle, 0, gParticleStorageFixedPoint.Size());
+    }
+    else if (gParticleStorageMode == PARTICLE_STORAGE_RING)
+    {
+        // only the live range(s) are uploaded and drawn
+        glBindVertexArray(gParticleStorageRing._vaoId);
+        glBindBuffer(GL_ARRAY_BUFFER, gParticleStorageRing._arrayBufferId);
+        unsigned int firstIndices[2];
+        unsigned int counts[2];
+        unsigned int numRanges = gParticleStorageRing.LiveRanges(firstIndices, counts);
+        for (unsigned int rangeIndex = 0; rangeIndex < numRanges; rangeIndex++)
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, firstIndices[rangeIndex] * sizeof(Particle), 
+                counts[rangeIndex] * sizeof(Particle), 
+                gParticleStorageRing._allParticles.data() + firstIndices[rangeIndex]);
+            glDrawArrays(gParticleStorageRing._drawStyle, firstIndices[rangeIndex], 
+                counts[rangeIndex]);
+        }
+    }
+    else
+    {
+        unsigned int numParticles = gParticleStorage._allParticles.Size();
+        glBindVertexArray(gParticleStorage._vaoId);
+        gParticleStorage.Upload(numParticles);
+        glDrawArrays(gParticleStorage._drawStyle, 0, numParticles);
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Works out the frame rate (once per second) and writes the HUD's strings.  No OpenGL calls, 
+    so it can run on any thread.
+Parameters:
+    numActiveParticles  The number of active particles in what was drawn.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void LayOutHud(unsigned int numActiveParticles)
+{
     static int elapsedFramesPerSecond = 0;
     static double elapsedTime = 0.0;
     static double frameRate = 0.0;
@@ -254,27 +588,143 @@ void Display()
         elapsedFramesPerSecond = 0;
         elapsedTime -= 1.0f;
     }
-    sprintf(str, "%.2lf", frameRate);
+    sprintf(gFrameRateText, "%.2lf", frameRate);
+    sprintf(gActiveParticlesText, "active: %d", numActiveParticles);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Draws the HUD's strings: the frame rate in the lower left corner and the number of active 
+    particles above it.  Must be on the main thread.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void DrawHud()
+{
+    // Note: The font textures' orgin is their lower left corner, so the "lower left" in screen 
+    // space is just above [-1.0f, -1.0f].
+    GLfloat color[4] = { 0.5f, 0.5f, 0.0f, 1.0f };
     float xy[2] = { -0.99f, -0.99f };
     float scaleXY[2] = { 1.0f, 1.0f };
 
     // the first time that "get shader program" runs, it will load the atlas
     glUseProgram(ShaderStorage::GetInstance().GetShaderProgram("freetype"));
-    gTextAtlases.GetAtlas(48)->RenderText(str, xy, scaleXY, color);
+    gTextAtlases.GetAtlas(48)->RenderText(gFrameRateText, xy, scaleXY, color);
 
     // now show number of active particles
     // Note: For some reason, lower case "i" seems to appear too close to the other letters.
-    sprintf(str, "active: %d", numActiveParticles);
     float numActiveParticlesXY[2] = { -0.99f, +0.7f };
-    gTextAtlases.GetAtlas(48)->RenderText(str, numActiveParticlesXY, scaleXY, color);
+    gTextAtlases.GetAtlas(48)->RenderText(gActiveParticlesText, numActiveParticlesXY, scaleXY, 
+        color);
+}
 
-    // clean up bindings
-    glUseProgram(0);
-    glBindVertexArray(0);       // unbind this BEFORE the buffer
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Splits the frame into tasks that say what they read and write, so that the frame task graph 
+    can run the CPU work next to the OpenGL calls:
+
+    - The particles that were updated last frame are uploaded and drawn first, and then the 
+      next frame's update starts on a worker while the main thread draws the region, the HUD, 
+      and swaps.  The update only has to wait for the upload (it writes what the upload reads).
+    - The HUD's text is written on a worker while the particles are drawn.
+
+    The graph never changes, only what the tasks do (like which storage is drawn).  Call it 
+    once, after Init().
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-17-2026)
+-----------------------------------------------------------------------------------------------*/
+void InitFrameTaskGraph()
+{
+    gFrameTaskGraph.AddTask("clear", FRAME_TASK_MAIN_THREAD, {}, { "framebuffer" }, []()
+    {
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClearDepth(1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    });
+
+    gFrameTaskGraph.AddTask("upload and draw particles", FRAME_TASK_MAIN_THREAD, 
+        { "particles", "active count", "framebuffer" }, { "framebuffer", "drawn count" }, []()
+    {
+        gNumDrawnParticles = UploadAndDrawParticles(gNumActiveParticles);
+    });
+
+    gFrameTaskGraph.AddTask("update particles", FRAME_TASK_ANY_THREAD, 
+        { "particles" }, { "particles", "active count" }, []()
+    {
+        gNumActiveParticles = UpdateParticles();
+    });
+
+    gFrameTaskGraph.AddTask("draw region", FRAME_TASK_MAIN_THREAD, 
+        { "framebuffer" }, { "framebuffer" }, []()
+    {
+        glUseProgram(ShaderStorage::GetInstance().GetShaderProgram("geometry"));
+        glUniformMatrix4fv(gUnifMatrixTransformLoc, 1, GL_FALSE, glm::value_ptr(gRegionTransformMatrix));
+        //glBindVertexArray(gCircleGeometry._vaoId);
+        //glDrawElements(gCircleGeometry._drawStyle, gCircleGeometry._indices.size(), GL_UNSIGNED_SHORT, 0);
+        glBindVertexArray(gPolygonGeometry._vaoId);
+        glDrawElements(gPolygonGeometry._drawStyle, gPolygonGeometry._indices.size(), GL_UNSIGNED_SHORT, 0);
+    });
+
+    gFrameTaskGraph.AddTask("lay out HUD", FRAME_TASK_ANY_THREAD, 
+        { "drawn count" }, { "HUD text" }, []()
+    {
+        LayOutHud(gNumDrawnParticles);
+    });
+
+    gFrameTaskGraph.AddTask("draw HUD", FRAME_TASK_MAIN_THREAD, 
+        { "HUD text", "framebuffer" }, { "framebuffer" }, []()
+    {
+        DrawHud();
+    });
+
+    gFrameTaskGraph.AddTask("swap buffers", FRAME_TASK_MAIN_THREAD, 
+        { "framebuffer" }, { "framebuffer" }, []()
+    {
+        // clean up bindings
+        glUseProgram(0);
+        glBindVertexArray(0);       // unbind this BEFORE the buffer
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // tell the GPU to swap out the displayed buffer with the one that was just rendered
+        glutSwapBuffers();
+    });
+
+    // the "any thread" tasks share the particle update's workers so that there is only one 
+    // thread per core
+    gFrameTaskGraph.Init(&gParticleTaskScheduler);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    This is the rendering function.  It runs the frame's tasks (see InitFrameTaskGraph()), which
+    tell OpenGL to clear out some color and depth buffers, to set up the data to draw, and to 
+    draw that stuff, while the CPU work for the next frame runs on other threads.
+    This is not a user-called function.
 
-    // tell the GPU to swap out the displayed buffer with the one that was just rendered
-    glutSwapBuffers();
+    This function is registered with glutDisplayFunc(...) during glut's initialization.
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    John Cox (2-13-2016)
+-----------------------------------------------------------------------------------------------*/
+void Display()
+{
+    // the simulation thread only runs while its storage is the one being drawn
+    if (gParticleStorageMode != PARTICLE_STORAGE_THREADED)
+    {
+        gParticleSimulationThread.Stop();
+    }
+
+    gFrameTaskGraph.Run();
+    if (gDumpFrameTaskGraph)
+    {
+        gFrameTaskGraph.DumpLastFrame();
+        gDumpFrameTaskGraph = false;
+    }
 
     // tell glut to call this display() function again on the next iteration of the main loop
     // Note: https://www.opengl.org/discussion_boards/showthread.php/168717-I-dont-understand-what-glutPostRedisplay()-does
@@ -336,6 +786,180 @@ void Keyboard(unsigned char key, int x, int y)
         glutLeaveMainLoop();
         return;
     }
+    case '1':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_AOS;
+        printf("particle storage: array of structures\n");
+        break;
+    }
+    case '2':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_SOA;
+        printf("particle storage: structure of arrays\n");
+        break;
+    }
+    case '3':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_COMPACTED;
+        printf("particle storage: array of structures, compacted\n");
+        break;
+    }
+    case '4':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_AOSOA;
+        printf("particle storage: array of structures of arrays, blocks of %u\n", 
+            PARTICLE_BLOCK_SIZE);
+        break;
+    }
+    case '5':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_SCHEMA;
+        printf("particle storage: schema (position, velocity, color, size), %u bytes per particle\n", 
+            (unsigned int)sizeof(ColoredParticleSchema::Record));
+        break;
+    }
+    case '6':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_FIXED_POINT;
+        printf("particle storage: 16-bit fixed point\n");
+        break;
+    }
+    case '7':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_RING;
+        printf("particle storage: first-in, first-out ring with lifetimes\n");
+        break;
+    }
+    case '8':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_SCHEDULED;
+        printf("particle storage: array of structures, retired on precomputed exit frames\n");
+        break;
+    }
+    case '9':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_STATELESS;
+        printf("particle storage: spawn records, moved by the vertex shader\n");
+        break;
+    }
+    case '0':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_PARALLEL;
+        printf("particle storage: array of structures, updated on %u threads\n", 
+            gParticleTaskScheduler.NumWorkers());
+        break;
+    }
+    case 't':
+    {
+        gParticleStorageMode = PARTICLE_STORAGE_THREADED;
+        gParticleSimulationThread.Start();
+        printf("particle storage: array of structures, simulated on its own thread\n");
+        break;
+    }
+    case '+':
+    case '=':
+    case '-':
+    {
+        // double or halve, but keep at least a few chunks of the active mask
+        if (key == '-')
+        {
+            gParticleCount /= 2;
+            if (gParticleCount < 1024)
+            {
+                gParticleCount = 1024;
+            }
+        }
+        else
+        {
+            gParticleCount *= 2;
+        }
+
+        gParticleStorage.Resize(gParticleCount);
+        gParticleStorageCompacted.Resize(gParticleCount);
+        gParticleStorageScheduled.Resize(gParticleCount);
+        gParticleStorageParallel.Resize(gParticleCount);
+        printf("particle count: %u (%u pool segments, %s)\n", gParticleCount, 
+            gParticleStorage._allParticles.NumSegments(), 
+            ParticleMemoryPolicyName(gParticleStorage._allParticles.AppliedMemoryPolicy()));
+        break;
+    }
+    case 'u':
+    {
+        // how busy each worker was in the parallel mode since the last time this was pressed
+        gParticleTaskScheduler.PrintStats();
+        gParticleTaskScheduler.ResetStats();
+        break;
+    }
+    case 'w':
+    {
+        gParticleTaskScheduler.SetStealing(!gParticleTaskScheduler.Stealing());
+        printf("task scheduler: stealing %s\n", gParticleTaskScheduler.Stealing() ? "on" : "off");
+        break;
+    }
+    case 'g':
+    {
+        gDumpFrameTaskGraph = true;
+        break;
+    }
+    case 'k':
+    {
+        // force the next supported kernel variant, wrapping around to scalar
+        // Note: The simulation thread uses the kernels, so it can't be running while they change.
+        bool simulationRunning = gParticleSimulationThread.Running();
+        gParticleSimulationThread.Stop();
+        int variant = GetParticleKernels()._variant + 1;
+        if (!ParticleKernelVariantSupported((ParticleKernelVariant)variant))
+        {
+            variant = PARTICLE_KERNEL_SCALAR;
+        }
+        ForceParticleKernelVariant((ParticleKernelVariant)variant);
+        printf("particle kernels: %s\n", ParticleKernelVariantName((ParticleKernelVariant)variant));
+        if (simulationRunning)
+        {
+            gParticleSimulationThread.Start();
+        }
+        break;
+    }
+    case 'b':
+    {
+        // the benchmarks switch kernels and want every core, so the simulation thread waits
+        bool simulationRunning = gParticleSimulationThread.Running();
+        gParticleSimulationThread.Stop();
+
+        // same region and emitters as the demo, but with emission quotas scaled up to the 
+        // benchmark's particle count so that a good fraction of the particles are active
+        ParticleUpdater benchmarkUpdater;
+        benchmarkUpdater.SetRegion(gpParticleRegionPolygon);
+        benchmarkUpdater.AddEmitter(gpParticleEmitterBar, BENCHMARK_PARTICLE_COUNT / 500);
+        benchmarkUpdater.AddEmitter(gpParticleEmitterPoint, BENCHMARK_PARTICLE_COUNT / 500);
+        BenchmarkStorageLayouts(benchmarkUpdater, BENCHMARK_PARTICLE_COUNT, 300, 100);
+        BenchmarkFixedPointRegions(*gpParticleRegionCircle, *gpParticleRegionPolygon, 1000000);
+        DemoParticleUpdaterT benchmarkUpdaterFixed;
+        benchmarkUpdaterFixed.SetRegion(gpParticleRegionPolygonFixed);
+        benchmarkUpdaterFixed.SetEmitter<0>(gpParticleEmitterBar, BENCHMARK_PARTICLE_COUNT / 500);
+        benchmarkUpdaterFixed.SetEmitter<1>(gpParticleEmitterPoint, BENCHMARK_PARTICLE_COUNT / 500);
+        BenchmarkDevirtualizedUpdater(benchmarkUpdater, benchmarkUpdaterFixed, 
+            BENCHMARK_PARTICLE_COUNT, 300, 100);
+        BenchmarkPredicatedUpdate(benchmarkUpdater, *gpParticleRegionPolygon, 
+            BENCHMARK_PARTICLE_COUNT, 20);
+        BenchmarkTiledUpdate(benchmarkUpdater, BENCHMARK_PARTICLE_COUNT, 300, 100);
+        ParticleUpdater parallelUpdater;
+        parallelUpdater.SetRegion(gpParticleRegionPolygon);
+        parallelUpdater.AddEmitter(gpParticleEmitterBar, BENCHMARK_PARALLEL_PARTICLE_COUNT / 500);
+        parallelUpdater.AddEmitter(gpParticleEmitterPoint, BENCHMARK_PARALLEL_PARTICLE_COUNT / 500);
+        BenchmarkParallelUpdate(parallelUpdater, BENCHMARK_PARALLEL_PARTICLE_COUNT, 300, 100);
+        BenchmarkParticleKernels(BENCHMARK_PARTICLE_COUNT, 100);
+        BenchmarkPolygonEarlyOut(BENCHMARK_IN_CACHE_PARTICLE_COUNT, 2000);
+        BenchmarkPolygonGrid(BENCHMARK_IN_CACHE_PARTICLE_COUNT, 20);
+
+        // the benchmark took a while, so don't count it against the frame rate
+        gTimer.Lap();
+        if (simulationRunning)
+        {
+            gParticleSimulationThread.Start();
+        }
+        break;
+    }
     default:
         break;
     }
@@ -396,7 +1020,12 @@ void CleanupAll()
     glDeleteBuffers(1, &gPolygonGeometry._elementBufferId);
     glDeleteVertexArrays(1, &gPolygonGeometry._vaoId);
 
+    // the threads must be gone before the regions and emitters that they use
+    gParticleTaskScheduler.Shutdown();
+    gParticleSimulationThread.Stop();
+
     delete(gpParticleRegionCircle);
+    delete(gpParticleRegionPolygonFixed);
     //delete(gpParticleRegionPolygon);
     delete(gpParticleEmitterBar);
     delete(gpParticleEmitterPoint);
@@ -456,6 +1085,7 @@ int main(int argc, char *argv[])
     }
 
     Init();
+    InitFrameTaskGraph();
 
     glutDisplayFunc(Display);
     glutReshapeFunc(Reshape);
@@ -1,19 +1,28 @@
 #version 440
 
 // position in window space (both X and Y on the range [-1,+1])
-layout (location = 0) in vec2 pos;  
+// Note: X and Y are separate attributes so that the "structure of arrays" particle storage, 
+// which keeps all the Xs and all the Ys in separate arrays, can use this shader too.
+layout (location = 0) in float posX;  
+layout (location = 1) in float posY;  
 
 // velocity also in window space (ex: an X speed of 1.0 would cross the window horizontally in 2 
 // seconds)
-layout (location = 1) in vec2 vel;  
+// Note: Only the "array of structures" particle storage sends this.
+layout (location = 2) in vec2 vel;  
+
+// optional attributes (see ParticleSchema.h); storages that don't send them get the "generic" 
+// values set in main.cpp, which are white and 1 pixel
+layout (location = 3) in vec4 color;
+layout (location = 4) in float size;
 
 // must have the same name as its corresponding "in" item in the frag shader
 smooth out vec3 particleColor;
 
 void main()
 {
-    // hard code a white particle color
-    particleColor = vec3(1.0f, 1.0f, 1.0f);
-	gl_Position = vec4(pos, -1.0f, 1.0f);
+    particleColor = color.rgb;
+    gl_PointSize = size;
+	gl_Position = vec4(posX, posY, -1.0f, 1.0f);
 }
 
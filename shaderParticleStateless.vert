@@ -0,0 +1,39 @@
+#version 440
+
+// the stateless counterpart of shaderParticle.vert (see ParticleStorageStateless.h); the CPU
+// only sends each particle once, when it is spawned, and this works out where it is now
+
+// window space (both X and Y on the range [-1,+1]), and window space per second
+layout (location = 0) in vec2 spawnPos;
+layout (location = 1) in vec2 vel;
+
+// in frames; the particle is hidden from its expiry frame on, and an expiry equal to the spawn
+// means that it never expires
+layout (location = 2) in uint spawnTick;
+layout (location = 3) in uint expiryTick;
+
+// the current frame and the length of a frame
+uniform uint currentTick;
+uniform float tickSec;
+
+// must have the same name as its corresponding "in" item in the frag shader
+smooth out vec3 particleColor;
+
+void main()
+{
+    particleColor = vec3(1.0f, 1.0f, 1.0f);
+    gl_PointSize = 1.0f;
+
+    // the differences are done in integers so that they stay right when the ticks wrap around
+    bool expired = (expiryTick != spawnTick) && (int(currentTick - expiryTick) >= 0);
+    if (expired)
+    {
+        // well outside of window space so that it is clipped
+        gl_Position = vec4(-10.0f, -10.0f, -1.0f, 1.0f);
+        return;
+    }
+
+    float ageSec = float(currentTick - spawnTick) * tickSec;
+    vec2 pos = spawnPos + (vel * ageSec);
+	gl_Position = vec4(pos, -1.0f, 1.0f);
+}